@@ -0,0 +1,114 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "bitvec.h"
+#include "vec_scan.h"
+
+#define N_BITS    ((size_t)1 << 28)
+#define N_QUERIES 10000000
+
+static volatile size_t sink; /**< keeps the results from being optimized away */
+
+static void random_bits(BitVec *bv)
+{
+   size_t i;
+
+   bitvec_new(bv);
+   bitvec_resize(bv, N_BITS);
+   for (i = 0; i < N_BITS / 64; i++)
+      bitvec_words(bv)[i] = rng();
+}
+
+/**
+ * @brief count and AND, with a Vec of bytes (one flag each) and the BitVec per instruction set
+ */
+static void bench_bulk(void)
+{
+   static const char *names[] = {"scalar", "sse2", "avx2"};
+   Vec                bytes_a, bytes_b;
+   BitVec             a, b;
+   size_t             i, cnt;
+   clock_t            start;
+   int                isa;
+
+   random_bits(&a);
+   random_bits(&b);
+   vec_new_with(&bytes_a, 1, N_BITS, NULL);
+   vec_new_with(&bytes_b, 1, N_BITS, NULL);
+   for (i = 0; i < N_BITS; i++) {
+      char x = bitvec_test(&a, i), y = bitvec_test(&b, i);
+      vec_push(&bytes_a, &x);
+      vec_push(&bytes_b, &y);
+   }
+
+   printf("%zu flags (%zu MB as bytes, %zu MB as bits)\n", N_BITS, N_BITS >> 20, N_BITS >> 23);
+
+   start = clock();
+   for (i = 0, cnt = 0; i < N_BITS; i++)
+      cnt += ((char *)bytes_a.ptr)[i];
+   sink = cnt;
+   printf("   count bytes:          %f secs\n", secs_since(start));
+
+   start = clock();
+   for (i = 0; i < N_BITS; i++)
+      ((char *)bytes_a.ptr)[i] &= ((char *)bytes_b.ptr)[i];
+   printf("   and bytes:            %f secs\n", secs_since(start));
+
+   for (isa = VEC_SCAN_SCALAR; isa <= VEC_SCAN_AVX2; isa += 2) {
+      if (vec_scan_set_isa((VecScanIsa)isa) != (VecScanIsa)isa)
+         continue;
+
+      start = clock();
+      sink = bitvec_count(&a);
+      printf("   count bits, %-6s    %f secs\n", names[isa], secs_since(start));
+
+      start = clock();
+      bitvec_and(&a, &b);
+      printf("   and bits, %-6s      %f secs\n", names[isa], secs_since(start));
+   }
+   vec_scan_set_isa(VEC_SCAN_AVX2);
+
+   vec_free(&bytes_a);
+   vec_free(&bytes_b);
+   bitvec_free(&a);
+   bitvec_free(&b);
+}
+
+static void bench_rank_select(void)
+{
+   BitVec  bv;
+   size_t  i, sum, ones;
+   clock_t start;
+
+   random_bits(&bv);
+
+   start = clock();
+   bitvec_build_index(&bv);
+   printf("   build index:          %f secs\n", secs_since(start));
+   ones = bitvec_rank(&bv, N_BITS);
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_QUERIES; i++)
+      sum += bitvec_rank(&bv, rng() % N_BITS);
+   sink = sum;
+   printf("   %d ranks:       %f secs\n", N_QUERIES, secs_since(start));
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_QUERIES; i++)
+      sum += bitvec_select(&bv, rng() % ones);
+   sink = sum;
+   printf("   %d selects:     %f secs\n", N_QUERIES, secs_since(start));
+
+   bitvec_free(&bv);
+}
+
+int main()
+{
+   bench_bulk();
+   bench_rank_select();
+
+   return 0;
+}
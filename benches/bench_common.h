@@ -0,0 +1,52 @@
+/**
+ * @file bench_common.h
+ *
+ * timing and random numbers shared by the benches
+ */
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief cpu time since @p start , in seconds
+ */
+INLINE static double secs_since(clock_t start)
+{
+   return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief wall clock time, clock() adds up the time of all threads
+ */
+INLINE static double wall_secs(void)
+{
+   struct timespec ts;
+
+   timespec_get(&ts, TIME_UTC);
+   return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint64_t rng_state = 88172645463325252ull; /**< xorshift state, fixed so runs compare */
+
+/**
+ * @brief xorshift64, fast enough not to show up in the timings
+ */
+INLINE static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+#endif /* __BENCH_COMMON_H__ */
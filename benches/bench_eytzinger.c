@@ -0,0 +1,111 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "eytzinger.h"
+
+#define N_QUERIES 2000000
+
+static uint64_t rand_u64(void)
+{
+   return ((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ (uint64_t)rand();
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+   uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+   return (x > y) - (x < y);
+}
+
+/**
+ * @brief the baseline: a plain binary search on the sorted array
+ */
+static size_t lower_bound_u32(const uint32_t *arr, size_t len, uint32_t key)
+{
+   size_t lo = 0, hi = len;
+
+   while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if (arr[mid] < key)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+
+   return lo;
+}
+
+static volatile size_t sink; /**< keeps the results from being optimized away */
+
+/**
+ * @brief the same random queries against sorted arrays of increasing size,
+ * with bsearch, a binary search, the Eytzinger index and its batched search
+ */
+static void bench_size(size_t len)
+{
+   Vec       sorted;
+   Eytzinger ez;
+   uint32_t *queries = malloc(N_QUERIES * sizeof(uint32_t));
+   size_t   *out = malloc(N_QUERIES * sizeof(size_t));
+   size_t    i, sum;
+   clock_t   start;
+
+   /* even keys, so half the queries miss */
+   vec_new_with(&sorted, sizeof(uint32_t), len, NULL);
+   for (i = 0; i < len; i++) {
+      uint32_t key = (uint32_t)(i * 2);
+      vec_push(&sorted, &key);
+   }
+   for (i = 0; i < N_QUERIES; i++)
+      queries[i] = (uint32_t)(rand_u64() % (len * 2));
+
+   printf("%zu keys (%zu KB)\n", len, len * sizeof(uint32_t) / 1024);
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_QUERIES; i++)
+      sum += bsearch(&queries[i], sorted.ptr, len, sizeof(uint32_t), cmp_u32) != NULL;
+   sink = sum;
+   printf("   bsearch:          %f secs\n", secs_since(start));
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_QUERIES; i++)
+      sum += lower_bound_u32(sorted.ptr, len, queries[i]);
+   sink = sum;
+   printf("   binary search:    %f secs\n", secs_since(start));
+
+   start = clock();
+   eytzinger_new(&ez, &sorted, VEC_U32);
+   printf("   eytzinger build:  %f secs\n", secs_since(start));
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_QUERIES; i++)
+      sum += eytzinger_lower_bound(&ez, &queries[i]);
+   sink = sum;
+   printf("   eytzinger:        %f secs\n", secs_since(start));
+
+   start = clock();
+   eytzinger_lower_bound_n(&ez, queries, N_QUERIES, out);
+   for (i = 0, sum = 0; i < N_QUERIES; i++)
+      sum += out[i];
+   sink = sum;
+   printf("   eytzinger batch:  %f secs\n\n", secs_since(start));
+
+   eytzinger_free(&ez);
+   vec_free(&sorted);
+   free(queries);
+   free(out);
+}
+
+int main()
+{
+   size_t len;
+
+   /* from L1 to well past L3 */
+   for (len = (size_t)1 << 10; len <= (size_t)1 << 26; len <<= 4)
+      bench_size(len);
+
+   return 0;
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "hamt.h"
+#include "hashmap.h"
+
+#define N_ITEMS  1000000
+#define N_WRITES 100000
+
+/**
+ * @brief what a consistent view of a HashMap costs without snapshots: a full copy
+ */
+static void hashmap_copy(HashMap *dst, const HashMap *src)
+{
+   HashIter iter;
+
+   hashmap_new(dst, sizeof(int), sizeof(int), NULL, NULL, NULL);
+   hashiter_init(&iter, src);
+   while (hashiter_next(&iter))
+      hashmap_set(dst, hashiter_key(&iter), hashiter_val(&iter, NULL), NULL, NULL);
+}
+
+static void bench_build(HashMap *map, Hamt *h)
+{
+   clock_t start;
+
+   hashmap_new(map, sizeof(int), sizeof(int), NULL, NULL, NULL);
+   start = clock();
+   for (int i = 0; i < N_ITEMS; i++)
+      hashmap_set(map, &i, &i, NULL, NULL);
+   printf("HashMap insert %d:  %f secs\n", N_ITEMS, secs_since(start));
+
+   hamt_new(h, sizeof(int), sizeof(int), NULL, NULL, NULL);
+   start = clock();
+   for (int i = 0; i < N_ITEMS; i++)
+      hamt_set(h, &i, &i);
+   printf("Hamt insert %d:     %f secs\n", N_ITEMS, secs_since(start));
+
+   printf("Hamt memory:        %.1f bytes/item\n", (double)hamt_mem_usage(h) / N_ITEMS);
+   printf("\n");
+}
+
+static void bench_snapshot(const HashMap *map, const Hamt *h)
+{
+   HashMap copy;
+   Hamt    snap;
+   clock_t start;
+
+   start = clock();
+   hashmap_copy(&copy, map);
+   printf("HashMap full copy:  %f secs\n", secs_since(start));
+   hashmap_free(&copy);
+
+   start = clock();
+   hamt_snapshot(&snap, h);
+   printf("Hamt snapshot:      %f secs\n", secs_since(start));
+   hamt_free(&snap);
+   printf("\n");
+}
+
+/**
+ * @brief cost of writes while a snapshot is alive, compared to the same writes without one
+ */
+static void bench_write_amplification(Hamt *h)
+{
+   Hamt    snap;
+   clock_t start;
+   int    *keys = malloc(N_WRITES * sizeof(int));
+
+   srand(42);
+   for (int i = 0; i < N_WRITES; i++)
+      keys[i] = rand() % N_ITEMS;
+
+   start = clock();
+   for (int i = 0; i < N_WRITES; i++)
+      hamt_set(h, &keys[i], &i);
+   printf("Hamt %d writes, no snapshot:   %f secs, %zu nodes cloned\n",
+          N_WRITES, secs_since(start), h->n_cloned);
+
+   hamt_snapshot(&snap, h);
+   h->n_cloned = 0;
+   start = clock();
+   for (int i = 0; i < N_WRITES; i++)
+      hamt_set(h, &keys[i], &i);
+   printf("Hamt %d writes, with snapshot: %f secs, %zu nodes cloned\n",
+          N_WRITES, secs_since(start), h->n_cloned);
+   printf("Write amplification:  %.2f nodes cloned/write\n", (double)h->n_cloned / N_WRITES);
+
+   hamt_free(&snap);
+   free(keys);
+   printf("\n");
+}
+
+int main()
+{
+   HashMap map;
+   Hamt    h;
+
+   bench_build(&map, &h);
+   bench_snapshot(&map, &h);
+   bench_write_amplification(&h);
+
+   hashmap_free(&map);
+   hamt_free(&h);
+
+   return 0;
+}
@@ -0,0 +1,94 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "hashjoin.h"
+#include "hashmap.h"
+
+#define N_BUILD 1000000
+#define N_PROBE 10000000
+
+static uint64_t rand_u64(void)
+{
+   return ((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ (uint64_t)rand();
+}
+
+/**
+ * @brief the baseline: a HashMap from key to build row, and a lookup per probe row
+ */
+static size_t join_hashmap(const Vec *build, const Vec *probe, Vec *build_rows, Vec *probe_rows)
+{
+   HashMap map;
+   clock_t start = clock();
+
+   hashmap_new(&map, sizeof(uint64_t), sizeof(size_t), NULL, NULL, NULL);
+   for (size_t i = 0; i < build->len; i++)
+      hashmap_set(&map, vec_at(build, i), &i, NULL, NULL);
+   printf("HashMap build:  %f secs\n", secs_since(start));
+
+   start = clock();
+   for (size_t i = 0; i < probe->len; i++) {
+      const size_t *row = hashmap_get(&map, vec_at(probe, i), NULL);
+      if (row) {
+         vec_push(build_rows, row);
+         vec_push(probe_rows, &i);
+      }
+   }
+   printf("HashMap probe:  %f secs\n", secs_since(start));
+
+   hashmap_free(&map);
+   return build_rows->len;
+}
+
+static size_t join_hashjoin(const Vec *build, const Vec *probe, Vec *build_rows, Vec *probe_rows)
+{
+   HashJoin hj;
+   size_t   n_matches;
+   clock_t  start = clock();
+
+   hashjoin_build(&hj, build);
+   printf("HashJoin build: %f secs (%zu partitions)\n", secs_since(start), hashjoin_n_parts(&hj));
+
+   start = clock();
+   n_matches = hashjoin_probe(&hj, probe, build_rows, probe_rows);
+   printf("HashJoin probe: %f secs\n", secs_since(start));
+
+   hashjoin_free(&hj);
+   return n_matches;
+}
+
+int main()
+{
+   Vec build, probe, build_rows, probe_rows;
+
+   vec_new_with(&build, sizeof(uint64_t), N_BUILD, NULL);
+   vec_new_with(&probe, sizeof(uint64_t), N_PROBE, NULL);
+   vec_new(&build_rows, sizeof(size_t), NULL);
+   vec_new(&probe_rows, sizeof(size_t), NULL);
+
+   /* unique build keys, probe keys hit about half of the times */
+   srand(42);
+   for (size_t i = 0; i < N_BUILD; i++) {
+      uint64_t key = rand_u64() << 1;
+      vec_push(&build, &key);
+   }
+   for (size_t i = 0; i < N_PROBE; i++) {
+      uint64_t key = rand() % 2 ? *(uint64_t *)vec_at(&build, (size_t)rand() % N_BUILD) : rand_u64();
+      vec_push(&probe, &key);
+   }
+
+   printf("HashMap matches:  %zu\n\n", join_hashmap(&build, &probe, &build_rows, &probe_rows));
+
+   vec_truncate(&build_rows, 0);
+   vec_truncate(&probe_rows, 0);
+   printf("HashJoin matches: %zu\n", join_hashjoin(&build, &probe, &build_rows, &probe_rows));
+
+   vec_free(&build);
+   vec_free(&probe);
+   vec_free(&build_rows);
+   vec_free(&probe_rows);
+
+   return 0;
+}
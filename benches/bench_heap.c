@@ -0,0 +1,141 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "heap.h"
+
+#define N_OPS 1000000
+
+static int cmp_u64(const void *a, const void *b)
+{
+   uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+   return (x > y) - (x < y);
+}
+
+static volatile uint64_t sink; /**< keeps the results from being optimized away */
+
+/**
+ * @brief the baseline: a Vec kept sorted in descending order, so the earliest is popped
+ * from the end, and new deadlines are inserted after a binary search
+ */
+static void bench_sorted_vec(size_t n_timers)
+{
+   Vec      v;
+   uint64_t now = 0, deadline;
+   size_t   i;
+   clock_t  start;
+
+   vec_new(&v, sizeof(uint64_t), NULL);
+   for (i = 0; i < n_timers; i++) {
+      deadline = rng() % (n_timers * 16);
+      vec_push(&v, &deadline);
+   }
+   qsort(v.ptr, v.len, sizeof(uint64_t), cmp_u64);
+   for (i = 0; i < v.len / 2; i++)
+      vec_swap(&v, i, v.len - 1 - i, 1);
+
+   start = clock();
+   for (i = 0; i < N_OPS; i++) {
+      size_t lo = 0, hi;
+
+      vec_pop(&v, &now);
+      deadline = now + rng() % (n_timers * 16);
+      for (hi = v.len; lo < hi;) {
+         size_t mid = lo + (hi - lo) / 2;
+
+         if (*(uint64_t *)vec_at(&v, mid) > deadline)
+            lo = mid + 1;
+         else
+            hi = mid;
+      }
+      vec_insert(&v, lo, &deadline);
+   }
+   sink = now;
+   printf("   sorted Vec:        %f secs\n", secs_since(start));
+
+   vec_free(&v);
+}
+
+/**
+ * @brief fire the earliest timer, and schedule it again later
+ */
+static void bench_heap(size_t n_timers, size_t arity)
+{
+   Heap     h;
+   uint64_t now = 0, deadline;
+   size_t   i;
+   clock_t  start;
+
+   heap_new(&h, sizeof(uint64_t), cmp_u64, arity);
+   for (i = 0; i < n_timers; i++) {
+      deadline = rng() % (n_timers * 16);
+      heap_push(&h, &deadline);
+   }
+
+   start = clock();
+   for (i = 0; i < N_OPS; i++) {
+      heap_pop(&h, &now);
+      deadline = now + rng() % (n_timers * 16);
+      heap_push(&h, &deadline);
+   }
+   sink = now;
+   printf("   %zu-ary heap:        %f secs\n", arity, secs_since(start));
+
+   heap_free(&h);
+}
+
+/**
+ * @brief timers by id: most are postponed before they fire (like idle timeouts),
+ * some fire, and fire again later
+ */
+static void bench_indexed(size_t n_timers, size_t arity)
+{
+   Heap     h;
+   uint64_t now = 0, deadline;
+   size_t   i, id;
+   clock_t  start;
+
+   heap_new_indexed(&h, sizeof(uint64_t), cmp_u64, arity);
+   for (i = 0; i < n_timers; i++) {
+      deadline = rng() % (n_timers * 16);
+      heap_push_id(&h, i, &deadline);
+   }
+
+   start = clock();
+   for (i = 0; i < N_OPS; i++) {
+      if (i % 4 == 0) {
+         heap_pop_id(&h, &id, &now);
+         deadline = now + rng() % (n_timers * 16);
+         heap_push_id(&h, id, &deadline);
+      }
+      else {
+         id = rng() % n_timers;
+         deadline = now + rng() % (n_timers * 16);
+         heap_update_id(&h, id, &deadline);
+      }
+   }
+   sink = now;
+   printf("   %zu-ary indexed:     %f secs\n", arity, secs_since(start));
+
+   heap_free(&h);
+}
+
+int main()
+{
+   size_t n_timers;
+
+   for (n_timers = 1000; n_timers <= 1000000; n_timers *= 10) {
+      printf("%zu timers, %d operations\n", n_timers, N_OPS);
+      if (n_timers <= 10000) /* quadratic */
+         bench_sorted_vec(n_timers);
+      bench_heap(n_timers, 2);
+      bench_heap(n_timers, 4);
+      bench_indexed(n_timers, 2);
+      bench_indexed(n_timers, 4);
+      printf("\n");
+   }
+
+   return 0;
+}
@@ -0,0 +1,77 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "packvec.h"
+
+#define N_VALS    ((size_t)1 << 25)
+#define N_QUERIES 10000000
+#define CHUNK     PACKVEC_BLOCK
+
+static volatile uint64_t sink; /**< keeps the results from being optimized away */
+
+/**
+ * @brief scan and random access on timestamps (gaps < 4096), raw Vec vs each PackVec mode
+ */
+static void bench_timestamps(void)
+{
+   static const char *names[] = {"for", "delta"};
+   static uint64_t    buf[CHUNK];
+   Vec                raw;
+   PackVec            pv;
+   uint64_t           ts = 1700000000000ull, sum;
+   size_t             i, j, n;
+   clock_t            start;
+   int                mode;
+
+   vec_new_with(&raw, sizeof(uint64_t), N_VALS, NULL);
+   for (i = 0; i < N_VALS; i++) {
+      ts += rng() % 4096;
+      vec_push(&raw, &ts);
+   }
+
+   printf("%zu timestamps (%zu MB raw)\n", N_VALS, N_VALS * sizeof(uint64_t) >> 20);
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_VALS; i++)
+      sum += ((uint64_t *)raw.ptr)[i];
+   sink = sum;
+   printf("   scan raw:             %f secs\n", secs_since(start));
+
+   for (mode = PACKVEC_FOR; mode <= PACKVEC_DELTA; mode++) {
+      packvec_new(&pv, (PackVecMode)mode);
+
+      start = clock();
+      packvec_push_n(&pv, raw.ptr, raw.len);
+      printf("   %-5s build:          %f secs, %zu MB (%.1fx smaller)\n", names[mode],
+             secs_since(start), packvec_bytes(&pv) >> 20,
+             (double)(N_VALS * sizeof(uint64_t)) / (double)packvec_bytes(&pv));
+
+      start = clock();
+      for (i = 0, sum = 0; (n = packvec_decode(&pv, i, buf, CHUNK)); i += n) {
+         for (j = 0; j < n; j++)
+            sum += buf[j];
+      }
+      sink = sum;
+      printf("   %-5s scan:           %f secs\n", names[mode], secs_since(start));
+
+      start = clock();
+      for (i = 0, sum = 0; i < N_QUERIES; i++)
+         sum += packvec_get(&pv, rng() % N_VALS);
+      sink = sum;
+      printf("   %-5s %d gets:  %f secs\n", names[mode], N_QUERIES, secs_since(start));
+
+      packvec_free(&pv);
+   }
+
+   vec_free(&raw);
+}
+
+int main()
+{
+   bench_timestamps();
+
+   return 0;
+}
@@ -0,0 +1,93 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "vec_scan.h"
+
+#define N_ELEMS 20000000
+#define N_REPS  10
+
+static volatile size_t sink; /**< keeps the results from being optimized away */
+
+/**
+ * @brief the baseline: compare every element with memcmp
+ */
+static size_t count_memcmp(const Vec *v, const void *key)
+{
+   size_t count = 0;
+
+   for (size_t i = 0; i < v->len; i++)
+      count += !memcmp(vec_at(v, i), key, v->size);
+
+   return count;
+}
+
+/*
+ * count, find (of an element that isn't there) and filter (selecting ~1/4 of the elements)
+ * with each instruction set
+ */
+#define BENCH_TYPE(label, T, type, lo_val, hi_val)                                                 \
+   do {                                                                                            \
+      const char *isa_names[] = {"scalar", "sse2", "avx2"};                                        \
+      Vec         v, idx;                                                                          \
+      T           key = 1, missing = 3, lo = lo_val, hi = hi_val;                                  \
+      clock_t     start;                                                                           \
+      size_t      i, sum;                                                                          \
+      int         isa, rep;                                                                        \
+                                                                                                   \
+      vec_new_with(&v, sizeof(T), N_ELEMS, NULL);                                                  \
+      vec_new(&idx, sizeof(size_t), NULL);                                                         \
+      for (i = 0; i < N_ELEMS; i++) {                                                              \
+         T x = (T)(rand() % 2);                                                                    \
+         vec_push(&v, &x);                                                                         \
+      }                                                                                            \
+                                                                                                   \
+      start = clock();                                                                             \
+      for (rep = 0, sum = 0; rep < N_REPS; rep++)                                                  \
+         sum += count_memcmp(&v, &key);                                                            \
+      sink = sum;                                                                                  \
+      printf("%-4s memcmp count:  %f secs\n", label, secs_since(start));                           \
+                                                                                                   \
+      for (isa = VEC_SCAN_SCALAR; isa <= VEC_SCAN_AVX2; isa++) {                                   \
+         if (vec_scan_set_isa((VecScanIsa)isa) != (VecScanIsa)isa)                                 \
+            break;                                                                                 \
+                                                                                                   \
+         start = clock();                                                                          \
+         for (rep = 0, sum = 0; rep < N_REPS; rep++)                                               \
+            sum += vec_count(&v, &key);                                                            \
+         sink = sum;                                                                               \
+         printf("%-4s %-6s count:  %f secs\n", label, isa_names[isa], secs_since(start));          \
+                                                                                                   \
+         start = clock();                                                                          \
+         for (rep = 0, sum = 0; rep < N_REPS; rep++)                                               \
+            sum += vec_find(&v, &missing);                                                         \
+         sink = sum;                                                                               \
+         printf("%-4s %-6s find:   %f secs\n", label, isa_names[isa], secs_since(start));          \
+                                                                                                   \
+         start = clock();                                                                          \
+         for (rep = 0, sum = 0; rep < N_REPS; rep++) {                                             \
+            vec_truncate(&idx, 0);                                                                 \
+            sum += vec_filter_range(&v, type, &lo, &hi, &idx, NULL);                               \
+         }                                                                                         \
+         sink = sum;                                                                               \
+         printf("%-4s %-6s filter: %f secs\n", label, isa_names[isa], secs_since(start));          \
+      }                                                                                            \
+      printf("\n");                                                                                \
+                                                                                                   \
+      vec_free(&v);                                                                                \
+      vec_free(&idx);                                                                              \
+   } while (0)
+
+int main()
+{
+   /* the filters select only the ones in half of the elements */
+   BENCH_TYPE("u8", uint8_t, VEC_U8, 1, 1);
+   BENCH_TYPE("i32", int32_t, VEC_I32, 1, 1);
+   BENCH_TYPE("u64", uint64_t, VEC_U64, 1, 1);
+   BENCH_TYPE("f64", double, VEC_F64, 0.5, 1.5);
+
+   return 0;
+}
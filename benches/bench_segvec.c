@@ -0,0 +1,73 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "segvec.h"
+#include "vec.h"
+
+#define N_ELEMS (1 << 24)
+
+/**
+ * @brief a record big enough for the copies on growth to matter
+ */
+typedef struct {
+   uint64_t key;
+   uint64_t fields[7];
+} Node;
+
+static volatile uint64_t sink; /**< keeps the results from being optimized away */
+
+int main()
+{
+   Vec      v;
+   SegVec   sv;
+   Node     node = {0, {0}};
+   Node    *seg;
+   size_t   i, s, len;
+   uint64_t sum;
+   clock_t  start;
+
+   printf("%d elements of %zu bytes\n", N_ELEMS, sizeof(Node));
+
+   start = clock();
+   vec_new(&v, sizeof(Node), NULL);
+   for (i = 0; i < N_ELEMS; i++) {
+      node.key = i;
+      vec_push(&v, &node);
+   }
+   printf("   Vec push:           %f secs\n", secs_since(start));
+
+   start = clock();
+   segvec_new(&sv, sizeof(Node), NULL);
+   for (i = 0; i < N_ELEMS; i++) {
+      node.key = i;
+      segvec_push(&sv, &node);
+   }
+   printf("   SegVec push:        %f secs\n", secs_since(start));
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_ELEMS; i++)
+      sum += ((Node *)vec_at(&v, i))->key;
+   sink = sum;
+   printf("   Vec at:             %f secs\n", secs_since(start));
+
+   start = clock();
+   for (i = 0, sum = 0; i < N_ELEMS; i++)
+      sum += ((Node *)segvec_at(&sv, i))->key;
+   sink = sum;
+   printf("   SegVec at:          %f secs\n", secs_since(start));
+
+   start = clock();
+   for (s = 0, sum = 0; (seg = segvec_seg(&sv, s, &len)); s++) {
+      for (i = 0; i < len; i++)
+         sum += seg[i].key;
+   }
+   sink = sum;
+   printf("   SegVec by segment:  %f secs\n", secs_since(start));
+
+   vec_free(&v);
+   segvec_free(&sv);
+
+   return 0;
+}
@@ -0,0 +1,75 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "soa.h"
+#include "vec.h"
+
+#define N_ROWS   (1 << 22)
+#define N_PASSES 20
+
+/**
+ * @brief a 64-byte record, of which the scan only reads one field
+ */
+typedef struct {
+   int64_t id;
+   double  price;
+   int64_t qty;
+   int64_t ts;
+   char    pad[32];
+} Rec;
+
+static volatile double sink; /**< keeps the results from being optimized away */
+
+int main()
+{
+   static const size_t sizes[] = {
+      SOA_FIELD_SIZE(Rec, id),
+      SOA_FIELD_SIZE(Rec, price),
+      SOA_FIELD_SIZE(Rec, qty),
+      SOA_FIELD_SIZE(Rec, ts),
+      SOA_FIELD_SIZE(Rec, pad),
+   };
+   Vec     aos;
+   Soa     soa;
+   size_t  i, pass;
+   double  sum;
+   clock_t start;
+
+   vec_new_with(&aos, sizeof(Rec), N_ROWS, NULL);
+   soa_new(&soa, sizes, 5);
+   soa_reserve(&soa, N_ROWS);
+   for (i = 0; i < N_ROWS; i++) {
+      Rec r = {(int64_t)i, (double)(i % 1000), 1, 0, {0}};
+
+      vec_push(&aos, &r);
+      soa_push(&soa, (const void *[]){&r.id, &r.price, &r.qty, &r.ts, r.pad});
+   }
+
+   printf("sum of one field of %d records of %zu bytes, %d times\n", N_ROWS, sizeof(Rec),
+          N_PASSES);
+
+   start = clock();
+   for (pass = 0, sum = 0; pass < N_PASSES; pass++) {
+      const Rec *recs = aos.ptr;
+      for (i = 0; i < aos.len; i++)
+         sum += recs[i].price;
+   }
+   sink = sum;
+   printf("   Vec of structs: %f secs\n", secs_since(start));
+
+   start = clock();
+   for (pass = 0, sum = 0; pass < N_PASSES; pass++) {
+      const double *prices = soa_col(&soa, 1);
+      for (i = 0; i < soa_len(&soa); i++)
+         sum += prices[i];
+   }
+   sink = sum;
+   printf("   Soa column:     %f secs\n", secs_since(start));
+
+   vec_free(&aos);
+   soa_free(&soa);
+
+   return 0;
+}
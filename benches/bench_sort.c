@@ -0,0 +1,157 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "vec_sort.h"
+
+#define N_ELEMS     10000000
+#define MAX_THREADS 64
+
+typedef struct {
+   uint32_t key;
+   uint32_t id;
+   double   payload[3];
+} Rec; /**< 32 bytes */
+
+static uint64_t rand_u64(void)
+{
+   return ((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ (uint64_t)rand();
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+   uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+   return (x > y) - (x < y);
+}
+
+static int cmp_i64(const void *a, const void *b)
+{
+   int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+   return (x > y) - (x < y);
+}
+
+static int cmp_f64(const void *a, const void *b)
+{
+   double x = *(const double *)a, y = *(const double *)b;
+   return (x > y) - (x < y);
+}
+
+/*
+ * sort the same random data with qsort, vec_sort and the radix sort.
+ * the data is regenerated from the same seed before each run
+ */
+#define BENCH_TYPE(label, T, make, cmp_fn, radix_call)                                             \
+   do {                                                                                            \
+      Vec     v;                                                                                   \
+      clock_t start;                                                                               \
+      size_t  i;                                                                                   \
+      int     run;                                                                                 \
+                                                                                                   \
+      vec_new_with(&v, sizeof(T), N_ELEMS, NULL);                                                  \
+      for (run = 0; run < 3; run++) {                                                              \
+         srand(42);                                                                                \
+         vec_truncate(&v, 0);                                                                      \
+         for (i = 0; i < N_ELEMS; i++) {                                                           \
+            T elem = make(i);                                                                      \
+            vec_push(&v, &elem);                                                                   \
+         }                                                                                         \
+                                                                                                   \
+         start = clock();                                                                          \
+         if (run == 0)                                                                             \
+            qsort(v.ptr, v.len, v.size, cmp_fn);                                                   \
+         else if (run == 1)                                                                        \
+            vec_sort(&v, cmp_fn);                                                                  \
+         else                                                                                      \
+            radix_call;                                                                            \
+         printf("%-6s %-8s %f secs\n", label,                                                     \
+                run == 0 ? "qsort" : run == 1 ? "vec_sort" : "radix",                              \
+                secs_since(start));                                                                \
+         if (!vec_is_sorted(&v, cmp_fn))                                                           \
+            printf("%s not sorted!\n", label);                                                     \
+      }                                                                                            \
+      printf("\n");                                                                                \
+      vec_free(&v);                                                                                \
+   } while (0)
+
+static uint32_t make_u32(size_t i)
+{
+   (void)i;
+   return (uint32_t)rand_u64();
+}
+
+static int64_t make_i64(size_t i)
+{
+   (void)i;
+   return (int64_t)rand_u64();
+}
+
+static double make_f64(size_t i)
+{
+   (void)i;
+   return (double)(int64_t)rand_u64() / 1e9;
+}
+
+static Rec make_rec(size_t i)
+{
+   Rec rec = {(uint32_t)rand_u64(), (uint32_t)i, {0, 0, 0}};
+   return rec;
+}
+
+/**
+ * @brief parallel sorts of the same data, with 1 to MAX_THREADS threads
+ */
+static void bench_scaling(void)
+{
+   Vec    v;
+   double start;
+   size_t n_threads, i;
+
+   vec_new_with(&v, sizeof(Rec), N_ELEMS, NULL);
+
+   for (n_threads = 1; n_threads <= MAX_THREADS; n_threads *= 2) {
+      ThreadPool pool;
+      int        stable;
+
+      if (!threadpool_new(&pool, n_threads))
+         break;
+
+      for (stable = 0; stable < 2; stable++) {
+         srand(42);
+         vec_truncate(&v, 0);
+         for (i = 0; i < N_ELEMS; i++) {
+            Rec elem = make_rec(i);
+            vec_push(&v, &elem);
+         }
+
+         start = wall_secs();
+         if (stable)
+            vec_sort_stable(&v, cmp_u32, &pool, SIZE_MAX);
+         else
+            vec_sort_parallel(&v, cmp_u32, &pool, SIZE_MAX);
+         printf("Rec    %-6s %2zu threads %f secs\n", stable ? "stable" : "sort", n_threads,
+                wall_secs() - start);
+         if (!vec_is_sorted(&v, cmp_u32))
+            printf("Rec not sorted!\n");
+      }
+
+      threadpool_free(&pool);
+   }
+
+   vec_free(&v);
+}
+
+int main()
+{
+   BENCH_TYPE("u32", uint32_t, make_u32, cmp_u32, vec_sort_radix(&v, VEC_U32));
+   BENCH_TYPE("i64", int64_t, make_i64, cmp_i64, vec_sort_radix(&v, VEC_I64));
+   BENCH_TYPE("f64", double, make_f64, cmp_f64, vec_sort_radix(&v, VEC_F64));
+   BENCH_TYPE("Rec", Rec, make_rec, cmp_u32,
+              vec_sort_radix_by_key(&v, offsetof(Rec, key), VEC_U32));
+
+   bench_scaling();
+
+   return 0;
+}
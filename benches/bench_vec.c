@@ -0,0 +1,272 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "vec.h"
+#include "vec_typed.h"
+
+#define N_ELEMS 10000000
+#define N_GROW  ((size_t)64 << 20) /**< 512 MB of u64 */
+
+typedef struct {
+   int64_t a, b, c, d;
+} Big; /**< 32 bytes */
+
+VEC_DEFINE(IntVec, int)
+VEC_DEFINE(DoubleVec, double)
+VEC_DEFINE(BigVec, Big)
+
+static volatile double sink; /**< keeps the sums from being optimized away */
+
+/*
+ * for each element type: push N elements one by one, sum them through at/get,
+ * and extend a second vector with them in chunks.
+ * once with the generic Vec, once with the typed one
+ */
+#define BENCH_TYPE(label, T, TVec, make, field)                                                    \
+   do {                                                                                            \
+      Vec     v, ext;                                                                              \
+      TVec    tv, text;                                                                            \
+      double  sum;                                                                                 \
+      clock_t start;                                                                               \
+      size_t  i;                                                                                   \
+                                                                                                   \
+      vec_new(&v, sizeof(T), NULL);                                                                \
+      start = clock();                                                                             \
+      for (i = 0; i < N_ELEMS; i++) {                                                              \
+         T elem = make(i);                                                                         \
+         vec_push(&v, &elem);                                                                      \
+      }                                                                                            \
+      printf("%-8s Vec        push:   %f secs\n", label, secs_since(start));                       \
+                                                                                                   \
+      TVec##_new(&tv, NULL);                                                                       \
+      start = clock();                                                                             \
+      for (i = 0; i < N_ELEMS; i++)                                                                \
+         TVec##_push(&tv, make(i));                                                                \
+      printf("%-8s VEC_DEFINE push:   %f secs\n", label, secs_since(start));                       \
+                                                                                                   \
+      start = clock();                                                                             \
+      for (i = 0, sum = 0; i < N_ELEMS; i++)                                                       \
+         sum += (double)(*(T *)vec_at(&v, i))field;                                                \
+      sink = sum;                                                                                  \
+      printf("%-8s Vec        at:     %f secs\n", label, secs_since(start));                       \
+                                                                                                   \
+      start = clock();                                                                             \
+      for (i = 0, sum = 0; i < N_ELEMS; i++)                                                       \
+         sum += (double)TVec##_data(&tv)[i] field;                                                 \
+      sink = sum;                                                                                  \
+      printf("%-8s VEC_DEFINE data:   %f secs\n", label, secs_since(start));                       \
+                                                                                                   \
+      vec_new(&ext, sizeof(T), NULL);                                                              \
+      start = clock();                                                                             \
+      for (i = 0; i < N_ELEMS; i += 7)                                                             \
+         vec_insert_n(&ext, ext.len, vec_at(&v, i), N_ELEMS - i < 7 ? N_ELEMS - i : 7);            \
+      printf("%-8s Vec        extend: %f secs\n", label, secs_since(start));                       \
+                                                                                                   \
+      TVec##_new(&text, NULL);                                                                     \
+      start = clock();                                                                             \
+      for (i = 0; i < N_ELEMS; i += 7)                                                             \
+         TVec##_extend(&text, TVec##_data(&tv) + i, N_ELEMS - i < 7 ? N_ELEMS - i : 7);            \
+      printf("%-8s VEC_DEFINE extend: %f secs\n\n", label, secs_since(start));                     \
+                                                                                                   \
+      vec_free(&v);                                                                                \
+      vec_free(&ext);                                                                              \
+      TVec##_free(&tv);                                                                            \
+      TVec##_free(&text);                                                                          \
+   } while (0)
+
+static int make_int(size_t i)
+{
+   return (int)i;
+}
+
+static double make_double(size_t i)
+{
+   return (double)i * 0.5;
+}
+
+static Big make_big(size_t i)
+{
+   Big big = {(int64_t)i, 1, 2, 3};
+   return big;
+}
+
+/**
+ * @brief grow a Vec of N_GROW u64 one push at a time, on the heap or on a mapping
+ */
+static void bench_grow(size_t mmap_threshold)
+{
+   Vec     v;
+   clock_t start;
+   size_t  i;
+
+   vec_set_mmap_threshold(mmap_threshold);
+   vec_new(&v, sizeof(uint64_t), NULL);
+
+   start = clock();
+   for (i = 0; i < N_GROW; i++) {
+      uint64_t x = i;
+      vec_push(&v, &x);
+   }
+   printf("grow %zu MB (%s): %f secs\n", N_GROW * sizeof(uint64_t) >> 20,
+          mmap_threshold ? "mmap" : "heap", secs_since(start));
+
+   vec_free(&v);
+   vec_set_mmap_threshold(0);
+}
+
+static bool not_multiple_of_10(const void *elem, void *ctx)
+{
+   (void)ctx;
+   return *(const int *)elem % 10 != 0;
+}
+
+/**
+ * @brief remove every 10th element of N_ELEMS ints: with vec_retain, vec_remove_indices and
+ * vec_swap_remove. repeated vec_remove is quadratic, so it only gets a 100x smaller Vec
+ */
+static void bench_bulk_remove(void)
+{
+   Vec     v;
+   size_t *idx = malloc(N_ELEMS / 10 * sizeof(size_t));
+   size_t  i, n = N_ELEMS / 100;
+   clock_t start;
+
+   printf("remove every 10th of %d ints:\n", N_ELEMS);
+
+   vec_new(&v, sizeof(int), NULL);
+   for (i = 0; i < n; i++) {
+      int x = (int)i;
+      vec_push(&v, &x);
+   }
+   start = clock();
+   for (i = n - (n - 1) % 10 - 1;; i -= 10) {
+      vec_remove(&v, i, NULL);
+      if (i < 10)
+         break;
+   }
+   printf("   vec_remove (%zu ints): %f secs\n", n, secs_since(start));
+   vec_free(&v);
+
+   vec_new_with(&v, sizeof(int), N_ELEMS, NULL);
+   for (i = 0; i < N_ELEMS; i++) {
+      int x = (int)i;
+      vec_push(&v, &x);
+   }
+   start = clock();
+   vec_retain(&v, not_multiple_of_10, NULL);
+   printf("   vec_retain:           %f secs\n", secs_since(start));
+   vec_free(&v);
+
+   vec_new_with(&v, sizeof(int), N_ELEMS, NULL);
+   for (i = 0; i < N_ELEMS; i++) {
+      int x = (int)i;
+      vec_push(&v, &x);
+   }
+   for (i = 0; i < N_ELEMS / 10; i++)
+      idx[i] = i * 10;
+   start = clock();
+   vec_remove_indices(&v, idx, N_ELEMS / 10);
+   printf("   vec_remove_indices:   %f secs\n", secs_since(start));
+   vec_free(&v);
+
+   /* backwards, so the positions still hold the same elements (order isn't kept) */
+   vec_new_with(&v, sizeof(int), N_ELEMS, NULL);
+   for (i = 0; i < N_ELEMS; i++) {
+      int x = (int)i;
+      vec_push(&v, &x);
+   }
+   start = clock();
+   for (i = N_ELEMS / 10; i-- > 0;)
+      vec_swap_remove(&v, i * 10, NULL);
+   printf("   vec_swap_remove:      %f secs\n", secs_since(start));
+   vec_free(&v);
+
+   free(idx);
+}
+
+/**
+ * @brief sum of the floats in [ @p beg , @p end ), 64 bytes at a time. @p end - @p beg must be
+ * a multiple of 16, the caller relies on the padding
+ */
+static float sum_blocks(const float *beg, const float *end)
+{
+   float acc[16] = {0}, sum = 0;
+   int   j;
+
+   for (; beg < end; beg += 16) {
+      for (j = 0; j < 16; j++)
+         acc[j] += beg[j];
+   }
+   for (j = 0; j < 16; j++)
+      sum += acc[j];
+
+   return sum;
+}
+
+/**
+ * @brief sum a column of floats in 64-byte blocks: aligned Vec with the padding covering the tail,
+ * or a Vec shifted by 4 bytes (every other block crosses a cache line) with a scalar tail
+ */
+static void bench_aligned(void)
+{
+   Vec     aligned, plain;
+   clock_t start;
+   size_t  i, n = N_ELEMS + 5, full;
+   float   sum;
+   int     rep;
+
+   vec_new_aligned(&aligned, sizeof(float), n, 64, NULL);
+   vec_new_with(&plain, sizeof(float), n + 16, NULL);
+   for (i = 0; i < n; i++) {
+      float x = (float)(i % 100);
+      vec_push(&aligned, &x);
+      vec_push(&plain, &x);
+   }
+   /* zero the padding, the blocks read it */
+   memset((float *)aligned.ptr + n, 0, (aligned.cap - n) * sizeof(float));
+
+   start = clock();
+   for (rep = 0, sum = 0; rep < 20; rep++) {
+      /* a write between the passes, so they aren't merged */
+      ((float *)aligned.ptr)[rep] += 1;
+      sum += sum_blocks(aligned.ptr, (float *)aligned.ptr + (n + 15) / 16 * 16);
+   }
+   sink = sum;
+   printf("sum floats, aligned + padding:   %f secs\n", secs_since(start));
+
+   start = clock();
+   full = (n - 1) / 16 * 16;
+   for (rep = 0, sum = 0; rep < 20; rep++) {
+      float *ptr = (float *)plain.ptr + 1;
+
+      ptr[rep] += 1;
+      sum += sum_blocks(ptr, ptr + full);
+      for (i = full; i < n - 1; i++)
+         sum += ptr[i];
+   }
+   sink = sum;
+   printf("sum floats, misaligned + tail:   %f secs\n", secs_since(start));
+
+   vec_free(&aligned);
+   vec_free(&plain);
+}
+
+int main()
+{
+   BENCH_TYPE("int", int, IntVec, make_int, );
+   BENCH_TYPE("double", double, DoubleVec, make_double, );
+   BENCH_TYPE("Big", Big, BigVec, make_big, .a);
+
+   bench_grow(0);
+   bench_grow((size_t)1 << 24);
+
+   bench_bulk_remove();
+
+   bench_aligned();
+
+   return 0;
+}
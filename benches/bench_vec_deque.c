@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "vec.h"
+#include "vec_deque.h"
+
+#define N_OPS 200000
+
+static volatile size_t sink; /**< keeps the results from being optimized away */
+
+/**
+ * @brief a FIFO work queue holding @p depth items: pop one from the front, push one at the back
+ */
+static void bench_queue(size_t depth)
+{
+   Vec      v;
+   VecDeque dq;
+   size_t   i, x, sum;
+   clock_t  start;
+
+   printf("queue of %zu items, %d pops and pushes\n", depth, N_OPS);
+
+   vec_new(&v, sizeof(size_t), NULL);
+   for (i = 0; i < depth; i++)
+      vec_push(&v, &i);
+   start = clock();
+   for (i = 0, sum = 0; i < N_OPS; i++) {
+      vec_remove(&v, 0, &x);
+      sum += x;
+      vec_push(&v, &i);
+   }
+   sink = sum;
+   printf("   Vec:      %f secs\n", secs_since(start));
+   vec_free(&v);
+
+   vec_deque_new(&dq, sizeof(size_t), NULL);
+   for (i = 0; i < depth; i++)
+      vec_deque_push_back(&dq, &i);
+   start = clock();
+   for (i = 0, sum = 0; i < N_OPS; i++) {
+      vec_deque_pop_front(&dq, &x);
+      sum += x;
+      vec_deque_push_back(&dq, &i);
+   }
+   sink = sum;
+   printf("   VecDeque: %f secs\n\n", secs_since(start));
+   vec_deque_free(&dq);
+}
+
+int main()
+{
+   size_t depth;
+
+   for (depth = 16; depth <= 65536; depth *= 16)
+      bench_queue(depth);
+
+   return 0;
+}
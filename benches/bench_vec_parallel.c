@@ -0,0 +1,103 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "vec_parallel.h"
+
+#define N_ELEMS     ((size_t)1 << 25)
+#define MAX_THREADS 64
+
+static volatile double sink; /**< keeps the results from being optimized away */
+
+/**
+ * @brief a transform heavy enough to be compute bound
+ */
+static void transform_chunk(void *elems, size_t pos, size_t n, void *ctx)
+{
+   double *vals = elems;
+   size_t  i;
+
+   (void)pos;
+   (void)ctx;
+   for (i = 0; i < n; i++)
+      vals[i] = sqrt(vals[i] * vals[i] + 1.0);
+}
+
+static void sum_fold(void *acc, const void *elems, size_t n, void *ctx)
+{
+   const double *vals = elems;
+   double        sum = 0;
+   size_t        i;
+
+   (void)ctx;
+   for (i = 0; i < n; i++)
+      sum += vals[i];
+   *(double *)acc += sum;
+}
+
+static void sum_combine(void *acc, const void *other, void *ctx)
+{
+   (void)ctx;
+   *(double *)acc += *(const double *)other;
+}
+
+/**
+ * @brief transform and sum the same data, on the calling thread and with 1 to MAX_THREADS threads
+ */
+static void bench_scaling(void)
+{
+   Vec    v;
+   double start, sum;
+   size_t n_threads, i;
+
+   vec_new_with(&v, sizeof(double), N_ELEMS, NULL);
+   for (i = 0; i < N_ELEMS; i++) {
+      double x = (double)i;
+      vec_push(&v, &x);
+   }
+
+   printf("%zu doubles\n", N_ELEMS);
+
+   start = wall_secs();
+   transform_chunk(v.ptr, 0, v.len, NULL);
+   printf("   transform, plain loop  %f secs\n", wall_secs() - start);
+
+   start = wall_secs();
+   sum = 0;
+   sum_fold(&sum, v.ptr, v.len, NULL);
+   sink = sum;
+   printf("   sum, plain loop        %f secs\n", wall_secs() - start);
+
+   for (n_threads = 1; n_threads <= MAX_THREADS; n_threads *= 2) {
+      ThreadPool pool;
+
+      if (!threadpool_new(&pool, n_threads))
+         break;
+
+      start = wall_secs();
+      vec_parallel_for(&v, transform_chunk, NULL, 0, &pool);
+      printf("   transform, %2zu threads %f secs\n", n_threads, wall_secs() - start);
+
+      start = wall_secs();
+      sum = 0;
+      vec_parallel_reduce(&v, &sum, sizeof(sum), sum_fold, sum_combine, NULL, 0, &pool);
+      sink = sum;
+      printf("   sum, %2zu threads       %f secs\n", n_threads, wall_secs() - start);
+
+      threadpool_free(&pool);
+
+      if (n_threads >= threadpool_n_cpus())
+         break;
+   }
+
+   vec_free(&v);
+}
+
+int main()
+{
+   bench_scaling();
+
+   return 0;
+}
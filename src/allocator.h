@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file allocator.h
+ */
+#ifndef __ALLOCATOR_H__
+#define __ALLOCATOR_H__
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief allocate, resize or move a chunk. like realloc, but sizes are always known
+ *
+ * @param[in,out] ctx allocator state
+ * @param[in] ptr chunk to resize, or NULL to allocate a new one
+ * @param[in] old_size size of @p ptr , 0 if NULL
+ * @param[in] new_size size requested
+ *
+ * @return the chunk, with the first min( @p old_size , @p new_size ) bytes preserved, or NULL
+ *         (and @p ptr still valid)
+ */
+typedef void *(*ReallocFn)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief release a chunk of @p size bytes. allocators that free in bulk can ignore it
+ */
+typedef void (*DeallocFn)(void *ctx, void *ptr, size_t size);
+
+/**
+ * @brief memory source for containers (see @p vec_new_in and @p vstr_new_in )
+ *
+ * containers keep a pointer to it, so it must outlive them.
+ * NULL means malloc/realloc/free
+ */
+typedef struct Allocator {
+   ReallocFn realloc_fn;
+   DeallocFn free_fn;
+   void     *ctx; /**< passed to the functions */
+} Allocator;
+
+/**
+ * @brief resize through @p alloc , or realloc if it's NULL
+ */
+INLINE static void *
+allocator_realloc(const Allocator *alloc, void *ptr, size_t old_size, size_t new_size)
+{
+   if (!alloc)
+      return realloc(ptr, new_size);
+   return alloc->realloc_fn(alloc->ctx, ptr, old_size, new_size);
+}
+
+/**
+ * @brief free through @p alloc , or free if it's NULL
+ */
+INLINE static void allocator_free(const Allocator *alloc, void *ptr, size_t size)
+{
+   if (!alloc)
+      free(ptr);
+   else
+      alloc->free_fn(alloc->ctx, ptr, size);
+}
+
+#endif /* __ALLOCATOR_H__ */
@@ -169,17 +169,43 @@ bool arena_free(Arena *arena, void *ptr, size_t size)
 
 void *arena_realloc(Arena *arena, size_t new_size, void *old_ptr, size_t old_size)
 {
+   Block    *old_blk = arena->curr;
+   uintptr_t old_head = old_blk ? old_blk->head : 0;
+
    bool is_same_ptr = arena_free(arena, old_ptr, old_size);
    if (new_size <= old_size && !is_same_ptr)
       return old_ptr;
 
    void *new_ptr = arena_alloc(arena, new_size);
-   if (new_ptr && !is_same_ptr)
-      memcpy(new_ptr, old_ptr, old_size);
+   /* even when freed in place, the chunk moves if the block is full */
+   if (new_ptr && old_ptr && new_ptr != old_ptr)
+      memcpy(new_ptr, old_ptr, old_size < new_size ? old_size : new_size);
+   /* out of memory, take back the chunk that was freed */
+   else if (!new_ptr && is_same_ptr) {
+      arena->curr = old_blk;
+      old_blk->head = old_head;
+   }
 
    return new_ptr;
 }
 
+static void *arena_allocator_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+   return arena_realloc((Arena *)ctx, new_size, ptr, old_size);
+}
+
+static void arena_allocator_free(void *ctx, void *ptr, size_t size)
+{
+   arena_free((Arena *)ctx, ptr, size);
+}
+
+void arena_allocator(Arena *arena, Allocator *alloc)
+{
+   alloc->realloc_fn = arena_allocator_realloc;
+   alloc->free_fn = arena_allocator_free;
+   alloc->ctx = arena;
+}
+
 void arena_reset(Arena *arena)
 {
    Block *blk;
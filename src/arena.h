@@ -14,6 +14,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "allocator.h"
+
 #ifdef _MSC_VER
    #define INLINE __inline
 #elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
@@ -84,6 +86,17 @@ bool arena_free(Arena *arena, void *ptr, size_t size);
  */
 void *arena_realloc(Arena *arena, size_t new_size, void *old_ptr, size_t old_size);
 
+/**
+ * @brief view @p arena as an @p Allocator , for containers
+ *
+ * frees only give back the last allocation, so a container that is the last to grow
+ * reallocates in place. everything is released at once with @p arena_reset
+ *
+ * @param[in] arena allocator, it must outlive @p alloc
+ * @param[out] alloc adapter
+ */
+void arena_allocator(Arena *arena, Allocator *alloc);
+
 /**
  * @brief free all memory in the arena
  *
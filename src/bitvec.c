@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bitvec.h"
+#include "vec_scan.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+   #define BITVEC_X86
+   #include <immintrin.h>
+
+   #define TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#define BLOCK_WORDS  8 /**< words per rank block, 512 bits */
+#define SELECT_EVERY 4096 /**< ones between select samples */
+#define REL_BITS     9 /**< bits of each word count relative to its block */
+
+#define ONES_STEP_8 0x0101010101010101ull
+#define MSBS_STEP_8 0x8080808080808080ull
+
+// MARK: Popcount
+
+/**
+ * @brief bits set in @p x , without the POPCNT instruction
+ */
+INLINE static unsigned popcount64(uint64_t x)
+{
+   x = x - ((x >> 1) & 0x5555555555555555ull);
+   x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+   x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+   return (unsigned)((x * ONES_STEP_8) >> 56);
+}
+
+static size_t count_scalar(const uint64_t *w, size_t n)
+{
+   size_t i, cnt = 0;
+
+   for (i = 0; i < n; i++)
+      cnt += popcount64(w[i]);
+
+   return cnt;
+}
+
+#ifdef BITVEC_X86
+
+TARGET("popcnt") static size_t count_popcnt(const uint64_t *w, size_t n)
+{
+   size_t i, cnt = 0;
+
+   for (i = 0; i < n; i++)
+      cnt += (size_t)__builtin_popcountll(w[i]);
+
+   return cnt;
+}
+
+/**
+ * @brief nibble lookup with a shuffle, 32 bytes at a time, summed with sad into 64-bit lanes
+ */
+TARGET("avx2") static size_t count_avx2(const uint64_t *w, size_t n)
+{
+   const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                                           1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+   const __m256i low = _mm256_set1_epi8(0x0f);
+   __m256i       acc = _mm256_setzero_si256();
+   uint64_t      lanes[4];
+   size_t        i = 0;
+
+   for (; i + 4 <= n; i += 4) {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(w + i));
+      __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+      __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+      __m256i cnt = _mm256_add_epi8(lo, hi);
+
+      acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+   }
+   _mm256_storeu_si256((__m256i *)lanes, acc);
+
+   return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + count_popcnt(w + i, n - i);
+}
+
+#endif
+
+/**
+ * @brief bits set in the @p n words at @p w
+ */
+static size_t count_words(const uint64_t *w, size_t n)
+{
+#ifdef BITVEC_X86
+   if (vec_scan_isa() == VEC_SCAN_AVX2)
+      return count_avx2(w, n);
+   if (__builtin_cpu_supports("popcnt"))
+      return count_popcnt(w, n);
+#endif
+   return count_scalar(w, n);
+}
+
+// MARK: Bulk operations
+
+/*
+ * dst[i] = dst[i] op src[i], 4 words at a time with AVX2
+ */
+#ifdef BITVEC_X86
+   #define BULK_AVX2(name, simd_op)                                                                \
+      TARGET("avx2") static void name##_avx2(uint64_t *dst, const uint64_t *src, size_t n)         \
+      {                                                                                            \
+         size_t i = 0;                                                                             \
+                                                                                                   \
+         for (; i + 4 <= n; i += 4) {                                                              \
+            __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));                            \
+            __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));                            \
+            _mm256_storeu_si256((__m256i *)(dst + i), simd_op);                                    \
+         }                                                                                         \
+         name##_scalar(dst + i, src + i, n - i);                                                   \
+      }
+   #define BULK_DISPATCH(name)                                                                     \
+      if (vec_scan_isa() == VEC_SCAN_AVX2) {                                                       \
+         name##_avx2(bitvec_words(dst), bitvec_words(src), dst->words.len);                        \
+         return true;                                                                              \
+      }
+#else
+   #define BULK_AVX2(name, simd_op)
+   #define BULK_DISPATCH(name)
+#endif
+
+#define BULK_OP(name, scalar_op, simd_op)                                                          \
+   static void name##_scalar(uint64_t *dst, const uint64_t *src, size_t n)                         \
+   {                                                                                               \
+      size_t i;                                                                                    \
+                                                                                                   \
+      for (i = 0; i < n; i++)                                                                      \
+         dst[i] = scalar_op;                                                                       \
+   }                                                                                               \
+                                                                                                   \
+   BULK_AVX2(name, simd_op)                                                                        \
+                                                                                                   \
+   bool bitvec_##name(BitVec *dst, const BitVec *src)                                              \
+   {                                                                                               \
+      if (dst->len != src->len)                                                                    \
+         return false;                                                                             \
+                                                                                                   \
+      dst->indexed = false;                                                                        \
+      BULK_DISPATCH(name)                                                                          \
+      name##_scalar(bitvec_words(dst), bitvec_words(src), dst->words.len);                         \
+      return true;                                                                                 \
+   }
+
+BULK_OP(and, dst[i] & src[i], _mm256_and_si256(d, s))
+BULK_OP(or, dst[i] | src[i], _mm256_or_si256(d, s))
+BULK_OP(xor, dst[i] ^ src[i], _mm256_xor_si256(d, s))
+BULK_OP(andnot, dst[i] & ~src[i], _mm256_andnot_si256(s, d))
+
+// MARK: Bits
+
+void bitvec_new(BitVec *bv)
+{
+   vec_new(&bv->words, sizeof(uint64_t), NULL);
+   bv->len = 0;
+   bv->indexed = false;
+   vec_new(&bv->ranks, sizeof(uint64_t), NULL);
+   vec_new(&bv->samples, sizeof(uint64_t), NULL);
+}
+
+void bitvec_free(BitVec *bv)
+{
+   vec_free(&bv->words);
+   vec_free(&bv->ranks);
+   vec_free(&bv->samples);
+   bv->len = 0;
+   bv->indexed = false;
+}
+
+bool bitvec_resize(BitVec *bv, size_t nbits)
+{
+   size_t n_words = nbits / 64 + (nbits % 64 != 0);
+
+   if (n_words > bv->words.len) {
+      if (!vec_insert_n(&bv->words, bv->words.len, NULL, n_words - bv->words.len))
+         return false;
+   }
+   else
+      vec_truncate(&bv->words, n_words);
+
+   /* the bits past the end stay 0 */
+   if (nbits % 64)
+      bitvec_words(bv)[n_words - 1] &= ((uint64_t)1 << (nbits % 64)) - 1;
+
+   bv->len = nbits;
+   bv->indexed = false;
+
+   return true;
+}
+
+bool bitvec_push(BitVec *bv, bool bit)
+{
+   if (bv->len % 64 == 0 && !vec_insert_n(&bv->words, bv->words.len, NULL, 1))
+      return false;
+
+   if (bit)
+      bitvec_words(bv)[bv->len / 64] |= (uint64_t)1 << (bv->len % 64);
+   bv->len++;
+   bv->indexed = false;
+
+   return true;
+}
+
+size_t bitvec_count(const BitVec *bv)
+{
+   return count_words(bitvec_words(bv), bv->words.len);
+}
+
+// MARK: Rank/select
+
+/*
+ * the rank index has two words per block of 512 bits: the ones before the block, and the ones
+ * before each of its words 1-7 relative to the block, packed in 9 bits each.
+ * there's always one more block than the words need, so rank(len) doesn't go past the end
+ */
+
+INLINE static const uint64_t *ranks(const BitVec *bv)
+{
+   return bv->ranks.ptr;
+}
+
+/**
+ * @brief ones in block @p b before its word @p j
+ */
+INLINE static size_t rel_rank(const BitVec *bv, size_t b, size_t j)
+{
+   if (!j)
+      return 0;
+   return (size_t)(ranks(bv)[2 * b + 1] >> (REL_BITS * (j - 1))) & ((1u << REL_BITS) - 1);
+}
+
+bool bitvec_build_index(BitVec *bv)
+{
+   const uint64_t *w = bitvec_words(bv);
+   size_t          n_words = bv->words.len, n_blocks = n_words / BLOCK_WORDS + 1;
+   size_t          b, j, total = 0, next_sample = 0;
+
+   vec_truncate(&bv->ranks, 0);
+   vec_truncate(&bv->samples, 0);
+   if (!vec_reserve(&bv->ranks, 2 * n_blocks))
+      return false;
+
+   for (b = 0; b < n_blocks; b++) {
+      uint64_t packed = 0, abs = total, rel = 0;
+
+      for (j = 0; j < BLOCK_WORDS; j++) {
+         size_t   w_idx = b * BLOCK_WORDS + j;
+         unsigned cnt = w_idx < n_words ? popcount64(w[w_idx]) : 0;
+
+         if (j)
+            packed |= rel << (REL_BITS * (j - 1));
+         rel += cnt;
+
+         /* the block of every SELECT_EVERY-th one */
+         while (next_sample < total + cnt) {
+            uint64_t sample = b;
+
+            if (!vec_push(&bv->samples, &sample))
+               return false;
+            next_sample += SELECT_EVERY;
+         }
+         total += cnt;
+      }
+
+      vec_push(&bv->ranks, &abs);
+      vec_push(&bv->ranks, &packed);
+   }
+
+   bv->indexed = true;
+
+   return true;
+}
+
+size_t bitvec_rank(const BitVec *bv, size_t pos)
+{
+   size_t w = pos / 64, b = w / BLOCK_WORDS;
+   size_t rank;
+
+   assert(bv->indexed);
+
+   rank = (size_t)ranks(bv)[2 * b] + rel_rank(bv, b, w % BLOCK_WORDS);
+   if (pos % 64)
+      rank += popcount64(bitvec_words(bv)[w] & (((uint64_t)1 << (pos % 64)) - 1));
+
+   return rank;
+}
+
+/**
+ * @brief position of the set bit of @p x with @p r set bits before it
+ *
+ * broadword: the byte is found comparing @p r with all the prefix sums at once
+ */
+INLINE static unsigned select64(uint64_t x, unsigned r)
+{
+   uint64_t sums, le;
+   unsigned byte, bits, pos;
+
+   /* ones in each byte, then the prefix sums: byte i holds the ones in bytes 0..i */
+   sums = x - ((x >> 1) & 0x5555555555555555ull);
+   sums = (sums & 0x3333333333333333ull) + ((sums >> 2) & 0x3333333333333333ull);
+   sums = ((sums + (sums >> 4)) & 0x0f0f0f0f0f0f0f0full) * ONES_STEP_8;
+
+   /* the high bit of each byte is set where sum <= r, the sums are < 128 so nothing borrows */
+   le = ((r * ONES_STEP_8 | MSBS_STEP_8) - sums) & MSBS_STEP_8;
+   byte = (unsigned)((le >> 7) * ONES_STEP_8 >> 56);
+
+   /* drop the lower ones of the byte, then find the lowest one left */
+   bits = (unsigned)(x >> (8 * byte)) & 0xff;
+   for (r -= byte ? (unsigned)(sums >> (8 * (byte - 1))) & 0xff : 0; r; r--)
+      bits &= bits - 1;
+   for (pos = 0; !((bits >> pos) & 1); pos++)
+      ;
+
+   return 8 * byte + pos;
+}
+
+size_t bitvec_select(const BitVec *bv, size_t k)
+{
+   size_t n_blocks = bv->ranks.len / 2, s = k / SELECT_EVERY;
+   size_t lo, len, j, w, rel;
+
+   assert(bv->indexed);
+
+   if (s >= bv->samples.len || k >= bitvec_rank(bv, bv->len))
+      return bv->len;
+
+   /* the last block with at most k ones before it, between two samples, without branches */
+   lo = ((const uint64_t *)bv->samples.ptr)[s];
+   len = (s + 1 < bv->samples.len ? ((const uint64_t *)bv->samples.ptr)[s + 1] + 1 : n_blocks) - lo;
+   while (len > 1) {
+      size_t half = len / 2;
+
+      lo = ranks(bv)[2 * (lo + half)] <= k ? lo + half : lo;
+      len -= half;
+   }
+
+   /* the word: how many of the words 1-7 have at most k ones before them */
+   k -= (size_t)ranks(bv)[2 * lo];
+   for (j = 1, w = 0; j < BLOCK_WORDS; j++)
+      w += rel_rank(bv, lo, j) <= k;
+   rel = rel_rank(bv, lo, w);
+
+   w += lo * BLOCK_WORDS;
+   return w * 64 + select64(bitvec_words(bv)[w], (unsigned)(k - rel));
+}
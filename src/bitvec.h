@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file bitvec.h
+ */
+#ifndef __BITVEC_H__
+#define __BITVEC_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief dynamic array of bits, packed 64 per word
+ *
+ * bulk operations and counting use AVX2 when available (see @p vec_scan_isa ).
+ * @p bitvec_build_index adds a rank/select index (about 15% of the bits): rank is O(1),
+ * select is a search in a small sampled range. any change to the bits invalidates it
+ */
+typedef struct BitVec {
+   Vec    words; /**< Vec of uint64_t, bit i is bit (i % 64) of word (i / 64) */
+   size_t len; /**< number of bits, the ones past it in the last word are always 0 */
+   bool   indexed; /**< if @p ranks and @p samples are up to date */
+   Vec    ranks; /**< per 512 bits: ones before them, and the counts of each word in them */
+   Vec    samples; /**< block of every 4096th one, to start the select searches */
+} BitVec;
+
+/**
+ * @brief initialize empty struct
+ *
+ * @param[out] bv BitVec
+ */
+void bitvec_new(BitVec *bv);
+
+/**
+ * @brief free the bits and the index
+ *
+ * @param[in,out] bv BitVec
+ */
+void bitvec_free(BitVec *bv);
+
+/**
+ * @brief set the number of bits, the new ones are 0
+ *
+ * @param[in,out] bv BitVec
+ * @param[in] nbits number of bits
+ *
+ * @return false in case of failure
+ */
+bool bitvec_resize(BitVec *bv, size_t nbits);
+
+/**
+ * @brief append a bit
+ *
+ * @param[in,out] bv BitVec
+ * @param[in] bit value of the bit
+ *
+ * @return false in case of failure
+ */
+bool bitvec_push(BitVec *bv, bool bit);
+
+/**
+ * @brief number of bits
+ */
+INLINE static size_t bitvec_len(const BitVec *bv)
+{
+   return bv->len;
+}
+
+/**
+ * @brief the words holding the bits, ( @p bitvec_len + 63) / 64 of them
+ */
+INLINE static uint64_t *bitvec_words(const BitVec *bv)
+{
+   return bv->words.ptr;
+}
+
+/**
+ * @brief value of bit @p pos , which must be < @p bitvec_len
+ */
+INLINE static bool bitvec_test(const BitVec *bv, size_t pos)
+{
+   return (bitvec_words(bv)[pos / 64] >> (pos % 64)) & 1;
+}
+
+/**
+ * @brief set bit @p pos to 1, @p pos must be < @p bitvec_len
+ */
+INLINE static void bitvec_set(BitVec *bv, size_t pos)
+{
+   bitvec_words(bv)[pos / 64] |= (uint64_t)1 << (pos % 64);
+   bv->indexed = false;
+}
+
+/**
+ * @brief set bit @p pos to 0, @p pos must be < @p bitvec_len
+ */
+INLINE static void bitvec_clear(BitVec *bv, size_t pos)
+{
+   bitvec_words(bv)[pos / 64] &= ~((uint64_t)1 << (pos % 64));
+   bv->indexed = false;
+}
+
+/**
+ * @brief @p dst &= @p src
+ *
+ * @return false if the lengths differ
+ */
+bool bitvec_and(BitVec *dst, const BitVec *src);
+
+/**
+ * @brief @p dst |= @p src
+ *
+ * @return false if the lengths differ
+ */
+bool bitvec_or(BitVec *dst, const BitVec *src);
+
+/**
+ * @brief @p dst ^= @p src
+ *
+ * @return false if the lengths differ
+ */
+bool bitvec_xor(BitVec *dst, const BitVec *src);
+
+/**
+ * @brief @p dst &= ~ @p src
+ *
+ * @return false if the lengths differ
+ */
+bool bitvec_andnot(BitVec *dst, const BitVec *src);
+
+/**
+ * @brief number of bits set
+ */
+size_t bitvec_count(const BitVec *bv);
+
+/**
+ * @brief build the index used by @p bitvec_rank and @p bitvec_select
+ *
+ * @param[in,out] bv BitVec
+ *
+ * @return false in case of failure
+ */
+bool bitvec_build_index(BitVec *bv);
+
+/**
+ * @brief number of bits set before @p pos , in O(1)
+ *
+ * needs the index, see @p bitvec_build_index
+ *
+ * @param[in] bv BitVec
+ * @param[in] pos position, <= @p bitvec_len
+ *
+ * @return number of bits set in [0, @p pos )
+ */
+size_t bitvec_rank(const BitVec *bv, size_t pos);
+
+/**
+ * @brief position of the bit set with rank @p k (the first one is 0)
+ *
+ * needs the index, see @p bitvec_build_index
+ *
+ * @param[in] bv BitVec
+ * @param[in] k number of bits set before the one to find
+ *
+ * @return position of the bit, or @p bitvec_len if there are not enough bits set
+ */
+size_t bitvec_select(const BitVec *bv, size_t k);
+
+#endif /* __BITVEC_H__ */
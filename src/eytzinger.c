@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "eytzinger.h"
+#include "vec_internal.h"
+
+#define CACHE_LINE 64
+#define BATCH      16 /**< searches that go down the tree together in eytzinger_lower_bound_n */
+
+/**
+ * @brief number of consecutive 1 bits, starting from the lowest
+ */
+INLINE static unsigned trailing_ones(size_t k)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return (unsigned)__builtin_ctzll(~(unsigned long long)k);
+#else
+   unsigned n = 0;
+
+   for (; k & 1; k >>= 1)
+      n++;
+
+   return n;
+#endif
+}
+
+/**
+ * @brief node reached by a search, after falling off the tree at @p k
+ *
+ * every step to the right appends a 1 to k, and the answer is the last node where
+ * the search went left: drop the trailing 1s, and the 0 before them
+ */
+INLINE static size_t last_left(size_t k)
+{
+   return k >> (trailing_ones(k) + 1);
+}
+
+/**
+ * @brief search functions for keys stored as @p T
+ *
+ * the descendants of k, @p STRIDE_LOG2 levels below, are the contiguous range that starts
+ * at k << STRIDE_LOG2, exactly one cache line of keys
+ */
+#define SEARCH_DEFINE(suffix, T, STRIDE_LOG2)                                                      \
+   INLINE static size_t search_##suffix(const T *keys, size_t len, T x, bool upper)                \
+   {                                                                                               \
+      size_t k = 1;                                                                                \
+                                                                                                   \
+      while (k <= len) {                                                                           \
+         PREFETCH(keys + (k << STRIDE_LOG2));                                                      \
+         k = 2 * k + (upper ? keys[k] <= x : keys[k] < x);                                         \
+      }                                                                                            \
+                                                                                                   \
+      return last_left(k);                                                                         \
+   }                                                                                               \
+                                                                                                   \
+   static void search_n_##suffix(const Eytzinger *ez, const void *xs, size_t n, size_t *out)       \
+   {                                                                                               \
+      const T *keys = ez->keys;                                                                    \
+      size_t   depth = 0, ks[BATCH], i, j, m, level;                                               \
+      T        vals[BATCH];                                                                        \
+                                                                                                   \
+      for (i = ez->len; i; i >>= 1)                                                                \
+         depth++;                                                                                  \
+                                                                                                   \
+      for (i = 0; i < n; i += BATCH) {                                                             \
+         m = n - i < BATCH ? n - i : BATCH;                                                        \
+         for (j = 0; j < m; j++) {                                                                 \
+            vals[j] = (T)ordered_key((const char *)xs + (i + j) * vec_type_size(ez->type),         \
+                                     ez->type);                                                    \
+            ks[j] = 1;                                                                             \
+         }                                                                                         \
+                                                                                                   \
+         /* all levels but the last are full */                                                    \
+         for (level = 1; level < depth; level++) {                                                 \
+            for (j = 0; j < m; j++) {                                                              \
+               ks[j] = 2 * ks[j] + (keys[ks[j]] < vals[j]);                                        \
+               PREFETCH(keys + (ks[j] << STRIDE_LOG2));                                            \
+            }                                                                                      \
+         }                                                                                         \
+         for (j = 0; j < m; j++) {                                                                 \
+            if (ks[j] <= ez->len)                                                                  \
+               ks[j] = 2 * ks[j] + (keys[ks[j]] < vals[j]);                                        \
+            ks[j] = last_left(ks[j]);                                                              \
+            out[i + j] = ks[j] ? ez->ranks[ks[j]] : ez->len;                                       \
+         }                                                                                         \
+      }                                                                                            \
+   }
+
+SEARCH_DEFINE(u32, uint32_t, 4)
+SEARCH_DEFINE(u64, uint64_t, 3)
+
+/**
+ * @brief node of the first key not less (or greater, if @p upper ) than @p key , 0 if none
+ */
+static size_t search_node(const Eytzinger *ez, const void *key, bool upper)
+{
+   uint64_t x = ordered_key(key, ez->type);
+
+   if (ez->key_size == 4)
+      return search_u32(ez->keys, ez->len, (uint32_t)x, upper);
+   return search_u64(ez->keys, ez->len, x, upper);
+}
+
+/**
+ * @brief fill the subtree of @p k in order, with the sorted keys from position @p i
+ *
+ * @return position of the next key
+ */
+static size_t fill(Eytzinger *ez, const Vec *sorted, size_t i, size_t k)
+{
+   uint64_t key;
+
+   if (k > ez->len)
+      return i;
+
+   i = fill(ez, sorted, i, 2 * k);
+
+   key = ordered_key(vec_at(sorted, i), ez->type);
+   assert(i == 0 || ordered_key(vec_at(sorted, i - 1), ez->type) <= key);
+   if (ez->key_size == 4)
+      ((uint32_t *)ez->keys)[k] = (uint32_t)key;
+   else
+      ((uint64_t *)ez->keys)[k] = key;
+   ez->ranks[k] = i++;
+
+   return fill(ez, sorted, i, 2 * k + 1);
+}
+
+void eytzinger_new(Eytzinger *ez, const Vec *sorted, VecType type)
+{
+   size_t size = vec_type_size(type);
+
+   assert(sorted->size == size);
+
+   ez->len = sorted->len;
+   ez->type = type;
+   ez->key_size = size <= 4 ? 4 : 8;
+   ez->keys_mem = malloc((ez->len + 1) * ez->key_size + CACHE_LINE);
+   ez->keys = (char *)ez->keys_mem + (CACHE_LINE - (uintptr_t)ez->keys_mem % CACHE_LINE);
+   ez->ranks = malloc((ez->len + 1) * sizeof(size_t));
+
+   fill(ez, sorted, 0, 1);
+}
+
+size_t eytzinger_lower_bound(const Eytzinger *ez, const void *key)
+{
+   size_t k = search_node(ez, key, false);
+
+   return k ? ez->ranks[k] : ez->len;
+}
+
+size_t eytzinger_upper_bound(const Eytzinger *ez, const void *key)
+{
+   size_t k = search_node(ez, key, true);
+
+   return k ? ez->ranks[k] : ez->len;
+}
+
+bool eytzinger_find(const Eytzinger *ez, const void *key, size_t *pos)
+{
+   size_t   k = search_node(ez, key, false);
+   uint64_t x = ordered_key(key, ez->type);
+   uint64_t found;
+
+   if (!k)
+      return false;
+
+   found = ez->key_size == 4 ? ((uint32_t *)ez->keys)[k] : ((uint64_t *)ez->keys)[k];
+   if (found != x)
+      return false;
+
+   if (pos)
+      *pos = ez->ranks[k];
+   return true;
+}
+
+void eytzinger_lower_bound_n(const Eytzinger *ez, const void *keys, size_t n, size_t *out)
+{
+   if (ez->key_size == 4)
+      search_n_u32(ez, keys, n, out);
+   else
+      search_n_u64(ez, keys, n, out);
+}
+
+void eytzinger_free(Eytzinger *ez)
+{
+   free(ez->keys_mem);
+   free(ez->ranks);
+   ez->keys_mem = NULL;
+   ez->keys = NULL;
+   ez->ranks = NULL;
+   ez->len = 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file eytzinger.h
+ */
+#ifndef __EYTZINGER_H__
+#define __EYTZINGER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief read-only search index over a sorted @p Vec of numeric keys
+ *
+ * the keys are copied in Eytzinger (breadth-first) order: the root at 1 and the children
+ * of k at 2k and 2k+1. a search goes down the tree with no branches other than the loop,
+ * and since the 16 (or 8, for 8 byte keys) descendants of k four (or three) levels down are
+ * contiguous, they are prefetched a few steps before they're needed.
+ * the first levels, the ones touched by every search, stay in cache.
+ *
+ * keys are stored as unsigned integers with the same order (see @p vec_sort_radix ),
+ * 4 bytes wide for types up to 4 bytes, 8 otherwise.
+ * results are positions in the sorted Vec it was built from, which isn't needed afterwards
+ *
+ * @note the implementation assumes malloc never fails
+ */
+typedef struct Eytzinger {
+   void    *keys; /**< keys in Eytzinger order, from index 1. aligned to a cache line */
+   void    *keys_mem; /**< allocation that contains keys */
+   size_t  *ranks; /**< position in the sorted Vec of each key, from index 1 */
+   size_t   len; /**< number of keys */
+   VecType  type; /**< type of the keys */
+   size_t   key_size; /**< 4 or 8, size of the stored keys */
+} Eytzinger;
+
+/**
+ * @brief build the index of a sorted Vec
+ *
+ * @param[out] ez index
+ * @param[in] sorted elements of @p type , in ascending order (as @p vec_sort_radix sorts them)
+ * @param[in] type type of the elements, its size must match
+ */
+void eytzinger_new(Eytzinger *ez, const Vec *sorted, VecType type);
+
+/**
+ * @brief position of the first key not less than @p key
+ *
+ * @param[in] ez index
+ * @param[in] key pointer to a key of the index's type
+ *
+ * @return position in the sorted Vec, or the number of keys if they are all less
+ */
+size_t eytzinger_lower_bound(const Eytzinger *ez, const void *key);
+
+/**
+ * @brief position of the first key greater than @p key
+ *
+ * @param[in] ez index
+ * @param[in] key pointer to a key of the index's type
+ *
+ * @return position in the sorted Vec, or the number of keys if none is greater
+ */
+size_t eytzinger_upper_bound(const Eytzinger *ez, const void *key);
+
+/**
+ * @brief check if @p key is in the index
+ *
+ * @param[in] ez index
+ * @param[in] key pointer to a key of the index's type
+ * @param[out] pos optional, position of its first occurrence in the sorted Vec
+ */
+bool eytzinger_find(const Eytzinger *ez, const void *key, size_t *pos);
+
+/**
+ * @brief @p eytzinger_lower_bound of many keys
+ *
+ * keys are searched in groups, one level at a time for the whole group, so that the cache misses
+ * of different searches overlap instead of waiting for each other
+ *
+ * @param[in] ez index
+ * @param[in] keys @p n keys of the index's type
+ * @param[in] n number of keys
+ * @param[out] out @p n positions
+ */
+void eytzinger_lower_bound_n(const Eytzinger *ez, const void *keys, size_t n, size_t *out);
+
+/**
+ * @brief number of keys
+ */
+INLINE static size_t eytzinger_len(const Eytzinger *ez)
+{
+   return ez->len;
+}
+
+/**
+ * @brief free the index
+ *
+ * @param[in,out] ez index
+ */
+void eytzinger_free(Eytzinger *ez);
+
+#endif /* __EYTZINGER_H__ */
@@ -65,12 +65,32 @@ void *fixed_buffer_realloc(FixedBuffer *fb, size_t new_size, void *old_ptr, size
       return old_ptr;
 
    void *new_ptr = fixed_buffer_alloc(fb, new_size);
-   if (new_ptr && !is_same_ptr)
+   if (new_ptr && !is_same_ptr && old_ptr)
       memcpy(new_ptr, old_ptr, old_size);
+   /* out of space, take back the chunk that was freed */
+   else if (!new_ptr && is_same_ptr)
+      fixed_buffer_alloc(fb, old_size);
 
    return new_ptr;
 }
 
+static void *fixed_buffer_allocator_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+   return fixed_buffer_realloc((FixedBuffer *)ctx, new_size, ptr, old_size);
+}
+
+static void fixed_buffer_allocator_free(void *ctx, void *ptr, size_t size)
+{
+   fixed_buffer_free((FixedBuffer *)ctx, ptr, size);
+}
+
+void fixed_buffer_allocator(FixedBuffer *fb, Allocator *alloc)
+{
+   alloc->realloc_fn = fixed_buffer_allocator_realloc;
+   alloc->free_fn = fixed_buffer_allocator_free;
+   alloc->ctx = fb;
+}
+
 void fixed_buffer_reset(FixedBuffer *fb)
 {
    fb->head = (uintptr_t)fb->beg;
@@ -15,6 +15,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "allocator.h"
+
 /**
  * @brief fixed buffer allocator
  * 
@@ -80,6 +82,17 @@ bool fixed_buffer_free(FixedBuffer *fb, void *ptr, size_t size);
  */
 void *fixed_buffer_realloc(FixedBuffer *fb, size_t new_size, void *old_ptr, size_t old_size);
 
+/**
+ * @brief view @p fb as an @p Allocator , for containers
+ *
+ * see @p arena_allocator , but the total is bounded by the buffer:
+ * when it's full, containers fail to grow
+ *
+ * @param[in] fb allocator, it must outlive @p alloc
+ * @param[out] alloc adapter
+ */
+void fixed_buffer_allocator(FixedBuffer *fb, Allocator *alloc);
+
 /**
  * @brief reset the allocator
  * 
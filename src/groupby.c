@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "groupby.h"
+#include "hash_internal.h"
+
+#define BATCH     256 /**< rows loaded, hashed and prefetched at a time */
+#define MIN_SLOTS 64
+
+/**
+ * @brief accumulators of a group without rows, for @p type
+ */
+INLINE static GroupAgg groupagg_empty(GroupByType type)
+{
+   GroupAgg agg;
+
+   agg.count = 0;
+   if (type == GROUPBY_F64) {
+      agg.sum.f = 0;
+      agg.min.f = DBL_MAX;
+      agg.max.f = -DBL_MAX;
+   }
+   else {
+      agg.sum.i = 0;
+      agg.min.i = INT64_MAX;
+      agg.max.i = INT64_MIN;
+   }
+
+   return agg;
+}
+
+INLINE static void groupagg_add_i64(GroupAgg *agg, int64_t val)
+{
+   agg->count++;
+   agg->sum.i += val;
+   if (val < agg->min.i)
+      agg->min.i = val;
+   if (val > agg->max.i)
+      agg->max.i = val;
+}
+
+INLINE static void groupagg_add_f64(GroupAgg *agg, double val)
+{
+   agg->count++;
+   agg->sum.f += val;
+   if (val < agg->min.f)
+      agg->min.f = val;
+   if (val > agg->max.f)
+      agg->max.f = val;
+}
+
+INLINE static void groupagg_combine(GroupAgg *dst, const GroupAgg *src, GroupByType type)
+{
+   dst->count += src->count;
+   if (type == GROUPBY_F64) {
+      dst->sum.f += src->sum.f;
+      if (src->min.f < dst->min.f)
+         dst->min.f = src->min.f;
+      if (src->max.f > dst->max.f)
+         dst->max.f = src->max.f;
+   }
+   else {
+      dst->sum.i += src->sum.i;
+      if (src->min.i < dst->min.i)
+         dst->min.i = src->min.i;
+      if (src->max.i > dst->max.i)
+         dst->max.i = src->max.i;
+   }
+}
+
+/**
+ * @brief read a key of @p key_size bytes, widened to 64bit
+ */
+INLINE static uint64_t read_key(const void *key, size_t key_size)
+{
+   switch (key_size) {
+   case 1:
+      return *(const uint8_t *)key;
+   case 2:
+      return *(const uint16_t *)key;
+   case 4:
+      return *(const uint32_t *)key;
+   default:
+      return *(const uint64_t *)key;
+   }
+}
+
+/**
+ * @brief append @p key to @p keys, narrowed to their size
+ */
+INLINE static void push_key(Vec *keys, uint64_t key)
+{
+   uint8_t  k8 = (uint8_t)key;
+   uint16_t k16 = (uint16_t)key;
+   uint32_t k32 = (uint32_t)key;
+
+   switch (keys->size) {
+   case 1:
+      vec_push(keys, &k8);
+      break;
+   case 2:
+      vec_push(keys, &k16);
+      break;
+   case 4:
+      vec_push(keys, &k32);
+      break;
+   default:
+      vec_push(keys, &key);
+      break;
+   }
+}
+
+/**
+ * @brief find the slot of @p key, claiming an empty one if it's missing
+ *
+ * @param[in,out] gb aggregation
+ * @param[in] key key
+ * @param[in] idx slot where to start probing
+ * @param[in] empty accumulators for a new group
+ *
+ * @return the slot
+ */
+INLINE static GroupSlot *groupby_slot(GroupBy *gb, uint64_t key, size_t idx, const GroupAgg *empty)
+{
+   size_t mask = gb->cap - 1;
+
+   for (;;) {
+      GroupSlot *slot = &gb->slots[idx];
+
+      if (!slot->agg.count) {
+         slot->key = key;
+         slot->agg = *empty;
+         gb->len++;
+         return slot;
+      }
+      if (slot->key == key)
+         return slot;
+      idx = (idx + 1) & mask;
+   }
+}
+
+/**
+ * @brief make room for @p n more groups, keeping the load under 1/2
+ */
+static void groupby_reserve(GroupBy *gb, size_t n)
+{
+   GroupSlot *old = gb->slots;
+   size_t     old_cap = gb->cap;
+   size_t     cap = gb->cap ? gb->cap : MIN_SLOTS;
+   size_t     i;
+
+   while ((gb->len + n) * 2 > cap)
+      cap *= 2;
+   if (cap == gb->cap)
+      return;
+
+   gb->slots = calloc(cap, sizeof(GroupSlot));
+   gb->cap = cap;
+   gb->len = 0;
+
+   /* the accumulators are moved as the "empty" ones of the new slots */
+   for (i = 0; i < old_cap; i++) {
+      if (old[i].agg.count)
+         groupby_slot(gb, old[i].key, (size_t)hash_u64(old[i].key) & (cap - 1), &old[i].agg);
+   }
+   free(old);
+}
+
+void groupby_new(GroupBy *gb, size_t key_size, GroupByType type)
+{
+   assert(key_size == 1 || key_size == 2 || key_size == 4 || key_size == 8);
+
+   gb->slots = NULL;
+   gb->cap = gb->len = 0;
+   gb->key_size = key_size;
+   gb->type = type;
+}
+
+void groupby_update_range(GroupBy *gb, const Vec *keys, const Vec *vals, size_t beg, size_t end)
+{
+   uint64_t key_buf[BATCH];
+   size_t   idx_buf[BATCH];
+   GroupAgg empty = groupagg_empty(gb->type);
+   size_t   row, i, n;
+
+   assert(keys->size == gb->key_size);
+   assert(!vals || (vals->size == 8 && vals->len >= end));
+   assert(end <= keys->len);
+
+   for (row = beg; row < end; row += n) {
+      n = end - row < BATCH ? end - row : BATCH;
+
+      groupby_reserve(gb, n);
+      load_keys(keys, row, n, key_buf);
+      for (i = 0; i < n; i++) {
+         idx_buf[i] = (size_t)hash_u64(key_buf[i]) & (gb->cap - 1);
+         PREFETCH(&gb->slots[idx_buf[i]]);
+      }
+
+      if (!vals) {
+         for (i = 0; i < n; i++)
+            groupby_slot(gb, key_buf[i], idx_buf[i], &empty)->agg.count++;
+      }
+      else if (gb->type == GROUPBY_F64) {
+         const double *src = (const double *)vals->ptr + row;
+         for (i = 0; i < n; i++)
+            groupagg_add_f64(&groupby_slot(gb, key_buf[i], idx_buf[i], &empty)->agg, src[i]);
+      }
+      else {
+         const int64_t *src = (const int64_t *)vals->ptr + row;
+         for (i = 0; i < n; i++)
+            groupagg_add_i64(&groupby_slot(gb, key_buf[i], idx_buf[i], &empty)->agg, src[i]);
+      }
+   }
+}
+
+void groupby_merge(GroupBy *dst, const GroupBy *src)
+{
+   GroupAgg empty = groupagg_empty(dst->type);
+   size_t   i;
+
+   assert(dst->key_size == src->key_size && dst->type == src->type);
+
+   groupby_reserve(dst, src->len);
+   for (i = 0; i < src->cap; i++) {
+      const GroupSlot *from = &src->slots[i];
+
+      if (from->agg.count) {
+         size_t     idx = (size_t)hash_u64(from->key) & (dst->cap - 1);
+         GroupSlot *slot = groupby_slot(dst, from->key, idx, &empty);
+
+         groupagg_combine(&slot->agg, &from->agg, dst->type);
+      }
+   }
+}
+
+const GroupAgg *groupby_get(const GroupBy *gb, const void *key)
+{
+   uint64_t k = read_key(key, gb->key_size);
+   size_t   mask = gb->cap - 1;
+   size_t   idx;
+
+   if (!gb->cap)
+      return NULL;
+
+   for (idx = (size_t)hash_u64(k) & mask; gb->slots[idx].agg.count; idx = (idx + 1) & mask) {
+      if (gb->slots[idx].key == k)
+         return &gb->slots[idx].agg;
+   }
+
+   return NULL;
+}
+
+void groupby_collect(const GroupBy *gb, Vec *keys, Vec *aggs)
+{
+   size_t i;
+
+   assert(keys->size == gb->key_size && aggs->size == sizeof(GroupAgg));
+
+   vec_reserve(keys, keys->len + gb->len);
+   vec_reserve(aggs, aggs->len + gb->len);
+   for (i = 0; i < gb->cap; i++) {
+      if (gb->slots[i].agg.count) {
+         push_key(keys, gb->slots[i].key);
+         vec_push(aggs, &gb->slots[i].agg);
+      }
+   }
+}
+
+void groupby_free(GroupBy *gb)
+{
+   free(gb->slots);
+   gb->slots = NULL;
+   gb->cap = gb->len = 0;
+}
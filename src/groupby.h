@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file groupby.h
+ */
+#ifndef __GROUPBY_H__
+#define __GROUPBY_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief type of the values being aggregated
+ */
+typedef enum GroupByType {
+   GROUPBY_I64, /**< int64_t */
+   GROUPBY_F64, /**< double */
+} GroupByType;
+
+typedef union GroupVal {
+   int64_t i;
+   double  f;
+} GroupVal;
+
+/**
+ * @brief accumulators of a group
+ *
+ * all of them are always computed, it's cheaper than checking which ones are wanted
+ */
+typedef struct GroupAgg {
+   uint64_t count; /**< number of rows of the group */
+   GroupVal sum;
+   GroupVal min;
+   GroupVal max;
+} GroupAgg;
+
+typedef struct GroupSlot {
+   uint64_t key;
+   GroupAgg agg; /**< empty slot if count is 0 */
+} GroupSlot;
+
+/**
+ * @brief hash aggregation (group by key, then count/sum/min/max)
+ *
+ * specialised for integer keys of 1, 2, 4 or 8 bytes and int64_t/double values, coming from @p Vec columns.
+ * the table is open-addressed, with the accumulators stored inline in the slots,
+ * and rows are processed in batches: keys are loaded and hashed first, the slots prefetched,
+ * and only then probed, so that the cache misses of a batch overlap each other.
+ *
+ * to run in parallel, split the rows in ranges and give each thread its own GroupBy
+ * (see @p groupby_update_range ), then combine them with @p groupby_merge
+ *
+ * @note the implementation assumes malloc never fails
+ */
+typedef struct GroupBy {
+   GroupSlot  *slots;
+   size_t      cap; /**< number of slots, power of two */
+   size_t      len; /**< number of groups */
+   size_t      key_size; /**< 1, 2, 4 or 8 */
+   GroupByType type; /**< type of the values */
+} GroupBy;
+
+/**
+ * @brief initialize the aggregation
+ *
+ * @param[out] gb aggregation
+ * @param[in] key_size size of the keys, 1, 2, 4 or 8 bytes. they are treated as unsigned integers
+ * @param[in] type type of the values
+ */
+void groupby_new(GroupBy *gb, size_t key_size, GroupByType type);
+
+/**
+ * @brief aggregate the rows in [ @p beg, @p end )
+ *
+ * GroupBys are independent, so different threads can work on different ranges of the same columns
+ *
+ * @param[in,out] gb aggregation
+ * @param[in] keys column of keys, elements of @p key_size bytes
+ * @param[in] vals column of values (of the type of @p gb ), or NULL to only count.
+ *                 don't mix the two on the same GroupBy, without values sum/min/max are meaningless
+ * @param[in] beg first row
+ * @param[in] end one past the last row
+ */
+void groupby_update_range(GroupBy *gb, const Vec *keys, const Vec *vals, size_t beg, size_t end);
+
+/**
+ * @brief aggregate every row of the columns
+ *
+ * see @p groupby_update_range
+ */
+INLINE static void groupby_update(GroupBy *gb, const Vec *keys, const Vec *vals)
+{
+   groupby_update_range(gb, keys, vals, 0, keys->len);
+}
+
+/**
+ * @brief combine the groups of @p src into @p dst
+ *
+ * @param[in,out] dst aggregation
+ * @param[in] src aggregation, with the same key size and type
+ */
+void groupby_merge(GroupBy *dst, const GroupBy *src);
+
+/**
+ * @brief accumulators of the group of @p key
+ *
+ * @param[in] gb aggregation
+ * @param[in] key pointer to a key of @p key_size bytes
+ *
+ * @return accumulators, or NULL
+ */
+const GroupAgg *groupby_get(const GroupBy *gb, const void *key);
+
+/**
+ * @brief append every group to output columns
+ *
+ * order is unspecified but the same for both columns
+ *
+ * @param[in] gb aggregation
+ * @param[in,out] keys column of elements of @p key_size bytes
+ * @param[in,out] aggs column of @p GroupAgg
+ */
+void groupby_collect(const GroupBy *gb, Vec *keys, Vec *aggs);
+
+/**
+ * @brief number of groups
+ */
+INLINE static size_t groupby_len(const GroupBy *gb)
+{
+   return gb->len;
+}
+
+/**
+ * @brief release memory
+ *
+ * @param[in,out] gb aggregation
+ */
+void groupby_free(GroupBy *gb);
+
+#endif /* __GROUPBY_H__ */
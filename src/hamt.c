@@ -0,0 +1,580 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hamt.h"
+
+#define HASH_BITS  32
+#define LEVEL_MASK ((1u << HAMT_BITS) - 1)
+
+/*
+ * children are either HamtNode or HamtLeaf, leaves are tagged in the low bit of the pointer.
+ * both start with the reference count, so they can be retained/released the same way.
+ *
+ * a node at shift >= HASH_BITS has run out of hash, it's a collision node:
+ * the bitmap is unused, and the slots are leaves with the same hash, searched linearly
+ */
+struct HamtNode {
+   atomic_uint refs;
+   uint32_t    bitmap; /**< which of the 32 children exist */
+   uint32_t    count; /**< number of slots */
+   void       *slots[];
+};
+
+/* followed by the key, and the value (aligned) */
+struct HamtLeaf {
+   atomic_uint refs;
+   Hash        hash;
+   uint32_t    key_size;
+   uint32_t    val_size;
+};
+
+#define LEAF_TAG ((uintptr_t)1)
+
+INLINE static bool is_leaf(const void *slot)
+{
+   return ((uintptr_t)slot & LEAF_TAG) != 0;
+}
+
+INLINE static HamtLeaf *as_leaf(const void *slot)
+{
+   return (HamtLeaf *)((uintptr_t)slot & ~LEAF_TAG);
+}
+
+INLINE static void *tag_leaf(HamtLeaf *leaf)
+{
+   return (void *)((uintptr_t)leaf | LEAF_TAG);
+}
+
+INLINE static atomic_uint *slot_refs(void *slot)
+{
+   return is_leaf(slot) ? &as_leaf(slot)->refs : &((HamtNode *)slot)->refs;
+}
+
+INLINE static uint32_t popcount32(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return (uint32_t)__builtin_popcount(x);
+#else
+   x = x - ((x >> 1) & 0x55555555u);
+   x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+   return (((x + (x >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24;
+#endif
+}
+
+INLINE static uint32_t level_bit(Hash hash, unsigned shift)
+{
+   return 1u << ((hash >> shift) & LEVEL_MASK);
+}
+
+/**
+ * @brief index in the slots of the child with @p bit
+ */
+INLINE static uint32_t slot_pos(const HamtNode *node, uint32_t bit)
+{
+   return popcount32(node->bitmap & (bit - 1));
+}
+
+INLINE static size_t hamt_key_size(const Hamt *h, const void *key)
+{
+   return h->base_key_size == HASHMAP_LEN_STR ? strlen((char *)key) + 1 : h->base_key_size;
+}
+
+INLINE static size_t hamt_val_size(const Hamt *h, const void *val)
+{
+   return h->base_val_size == HASHMAP_LEN_STR ? strlen((char *)val) + 1 : h->base_val_size;
+}
+
+// MARK: Leaves
+
+INLINE static void *leaf_key(const HamtLeaf *leaf)
+{
+   return (void *)(leaf + 1);
+}
+
+INLINE static void *leaf_val(const HamtLeaf *leaf)
+{
+   return (void *)ALIGN_UP((uintptr_t)leaf_key(leaf) + leaf->key_size);
+}
+
+INLINE static size_t leaf_size(size_t key_size, size_t val_size)
+{
+   return (size_t)ALIGN_UP(sizeof(HamtLeaf) + key_size) + val_size;
+}
+
+static HamtLeaf *
+leaf_new(const void *key, size_t key_size, const void *val, size_t val_size, Hash hash)
+{
+   HamtLeaf *leaf = malloc(leaf_size(key_size, val_size));
+
+   atomic_init(&leaf->refs, 1);
+   leaf->hash = hash;
+   leaf->key_size = (uint32_t)key_size;
+   leaf->val_size = (uint32_t)val_size;
+   memcpy(leaf_key(leaf), key, key_size);
+   memcpy(leaf_val(leaf), val, val_size);
+
+   return leaf;
+}
+
+INLINE static bool
+leaf_match(const Hamt *h, const HamtLeaf *leaf, const void *key, size_t key_size, Hash hash)
+{
+   return leaf->hash == hash && leaf->key_size == key_size &&
+          !h->cmp_fn(leaf_key(leaf), key, key_size);
+}
+
+// MARK: Nodes
+
+INLINE static size_t node_size(uint32_t count)
+{
+   return sizeof(HamtNode) + count * sizeof(void *);
+}
+
+static HamtNode *node_new(uint32_t bitmap, uint32_t count)
+{
+   HamtNode *node = malloc(node_size(count));
+
+   atomic_init(&node->refs, 1);
+   node->bitmap = bitmap;
+   node->count = count;
+
+   return node;
+}
+
+INLINE static void slot_retain(void *slot)
+{
+   atomic_fetch_add_explicit(slot_refs(slot), 1, memory_order_relaxed);
+}
+
+static void slot_release(const Hamt *h, void *slot)
+{
+   uint32_t i;
+
+   if (atomic_fetch_sub_explicit(slot_refs(slot), 1, memory_order_release) != 1)
+      return;
+   atomic_thread_fence(memory_order_acquire);
+
+   if (is_leaf(slot)) {
+      HamtLeaf *leaf = as_leaf(slot);
+
+      if (h->free_fn)
+         h->free_fn(leaf_val(leaf));
+      free(leaf);
+   }
+   else {
+      HamtNode *node = slot;
+
+      for (i = 0; i < node->count; i++)
+         slot_release(h, node->slots[i]);
+      free(node);
+   }
+}
+
+/**
+ * @brief whether this version is the only owner of @p slot
+ *
+ * the count can't grow under our feet: the only other references come from shared nodes,
+ * and if there are any it's already > 1
+ */
+INLINE static bool slot_unique(void *slot)
+{
+   return atomic_load_explicit(slot_refs(slot), memory_order_acquire) == 1;
+}
+
+/**
+ * @brief make sure the node in @p pnode is owned only by @p h, copying it if it's shared
+ *
+ * @p pnode must itself be owned only by @p h
+ */
+static HamtNode *node_own(Hamt *h, HamtNode **pnode)
+{
+   HamtNode *node = *pnode;
+   HamtNode *copy;
+   uint32_t  i;
+
+   if (slot_unique(node))
+      return node;
+
+   copy = node_new(node->bitmap, node->count);
+   for (i = 0; i < node->count; i++) {
+      copy->slots[i] = node->slots[i];
+      slot_retain(copy->slots[i]);
+   }
+   h->n_cloned++;
+
+   slot_release(h, node);
+   *pnode = copy;
+
+   return copy;
+}
+
+/**
+ * @brief replace owned @p *pnode with a copy that has @p slot inserted at @p pos
+ */
+static void node_insert_slot(HamtNode **pnode, uint32_t bit, uint32_t pos, void *slot)
+{
+   HamtNode *node = *pnode;
+   HamtNode *grown = node_new(node->bitmap | bit, node->count + 1);
+
+   memcpy(grown->slots, node->slots, pos * sizeof(void *));
+   grown->slots[pos] = slot;
+   memcpy(grown->slots + pos + 1, node->slots + pos, (node->count - pos) * sizeof(void *));
+
+   /* the children moved, they are not released */
+   free(node);
+   *pnode = grown;
+}
+
+/**
+ * @brief replace owned @p *pnode with a copy that lacks the slot at @p pos
+ *
+ * the slot must have already been released
+ */
+static void node_remove_slot(HamtNode **pnode, uint32_t bit, uint32_t pos)
+{
+   HamtNode *node = *pnode;
+   HamtNode *shrunk = node_new(node->bitmap & ~bit, node->count - 1);
+
+   memcpy(shrunk->slots, node->slots, pos * sizeof(void *));
+   memcpy(shrunk->slots + pos, node->slots + pos + 1, (node->count - pos - 1) * sizeof(void *));
+
+   free(node);
+   *pnode = shrunk;
+}
+
+/**
+ * @brief build the subtree holding two leaves, that share the hash bits up to @p shift
+ */
+static HamtNode *node_join(HamtLeaf *a, HamtLeaf *b, unsigned shift)
+{
+   HamtNode *node;
+   uint32_t  bit_a, bit_b;
+
+   if (shift >= HASH_BITS) {
+      node = node_new(0, 2);
+      node->slots[0] = tag_leaf(a);
+      node->slots[1] = tag_leaf(b);
+      return node;
+   }
+
+   bit_a = level_bit(a->hash, shift);
+   bit_b = level_bit(b->hash, shift);
+   if (bit_a == bit_b) {
+      node = node_new(bit_a, 1);
+      node->slots[0] = node_join(a, b, shift + HAMT_BITS);
+   }
+   else {
+      node = node_new(bit_a | bit_b, 2);
+      node->slots[bit_a < bit_b ? 0 : 1] = tag_leaf(a);
+      node->slots[bit_a < bit_b ? 1 : 0] = tag_leaf(b);
+   }
+
+   return node;
+}
+
+// MARK: Recursive ops
+
+typedef struct HamtEntry {
+   const void *key;
+   size_t      key_size;
+   const void *val;
+   size_t      val_size;
+   Hash        hash;
+} HamtEntry;
+
+/**
+ * @brief store @p e in the leaf at @p *pslot, which matches its key
+ */
+static void leaf_update(Hamt *h, void **pslot, const HamtEntry *e)
+{
+   HamtLeaf *leaf = as_leaf(*pslot);
+
+   /* owned and same size: overwrite the value in place */
+   if (slot_unique(*pslot) && leaf->val_size == e->val_size) {
+      if (h->free_fn)
+         h->free_fn(leaf_val(leaf));
+      memcpy(leaf_val(leaf), e->val, e->val_size);
+      return;
+   }
+
+   slot_release(h, *pslot);
+   *pslot = tag_leaf(leaf_new(e->key, e->key_size, e->val, e->val_size, e->hash));
+}
+
+static bool hamt_set_rec(Hamt *h, HamtNode **pnode, unsigned shift, const HamtEntry *e)
+{
+   HamtNode *node = node_own(h, pnode);
+   HamtLeaf *leaf;
+   uint32_t  bit, pos;
+   void    **pslot;
+
+   if (shift >= HASH_BITS) {
+      for (pos = 0; pos < node->count; pos++) {
+         if (leaf_match(h, as_leaf(node->slots[pos]), e->key, e->key_size, e->hash)) {
+            leaf_update(h, &node->slots[pos], e);
+            return true;
+         }
+      }
+      leaf = leaf_new(e->key, e->key_size, e->val, e->val_size, e->hash);
+      node_insert_slot(pnode, 0, node->count, tag_leaf(leaf));
+      return false;
+   }
+
+   bit = level_bit(e->hash, shift);
+   pos = slot_pos(node, bit);
+   if (!(node->bitmap & bit)) {
+      leaf = leaf_new(e->key, e->key_size, e->val, e->val_size, e->hash);
+      node_insert_slot(pnode, bit, pos, tag_leaf(leaf));
+      return false;
+   }
+
+   pslot = &node->slots[pos];
+   if (!is_leaf(*pslot))
+      return hamt_set_rec(h, (HamtNode **)pslot, shift + HAMT_BITS, e);
+
+   leaf = as_leaf(*pslot);
+   if (leaf_match(h, leaf, e->key, e->key_size, e->hash)) {
+      leaf_update(h, pslot, e);
+      return true;
+   }
+
+   /* the reference of the existing leaf moves into the new subtree */
+   *pslot = node_join(
+      leaf, leaf_new(e->key, e->key_size, e->val, e->val_size, e->hash), shift + HAMT_BITS
+   );
+   return false;
+}
+
+/**
+ * @brief remove the key of @p e, which must exist
+ */
+static void hamt_remove_rec(Hamt *h, HamtNode **pnode, unsigned shift, const HamtEntry *e)
+{
+   HamtNode *node = node_own(h, pnode);
+   HamtNode *child;
+   uint32_t  bit, pos;
+
+   if (shift >= HASH_BITS) {
+      for (pos = 0; !leaf_match(h, as_leaf(node->slots[pos]), e->key, e->key_size, e->hash); pos++)
+         ;
+      slot_release(h, node->slots[pos]);
+      node_remove_slot(pnode, 0, pos);
+      return;
+   }
+
+   bit = level_bit(e->hash, shift);
+   pos = slot_pos(node, bit);
+   if (is_leaf(node->slots[pos])) {
+      slot_release(h, node->slots[pos]);
+      node_remove_slot(pnode, bit, pos);
+      return;
+   }
+
+   hamt_remove_rec(h, (HamtNode **)&node->slots[pos], shift + HAMT_BITS, e);
+
+   /* collapse subtrees left with a single leaf, so the trie stays as shallow as possible */
+   child = node->slots[pos];
+   if (child->count == 1 && is_leaf(child->slots[0])) {
+      node->slots[pos] = child->slots[0];
+      slot_retain(node->slots[pos]);
+      slot_release(h, child);
+   }
+}
+
+static size_t slot_mem_usage(const void *slot)
+{
+   const HamtNode *node;
+   size_t          size;
+   uint32_t        i;
+
+   if (is_leaf(slot)) {
+      const HamtLeaf *leaf = as_leaf(slot);
+      return leaf_size(leaf->key_size, leaf->val_size);
+   }
+
+   node = slot;
+   size = node_size(node->count);
+   for (i = 0; i < node->count; i++)
+      size += slot_mem_usage(node->slots[i]);
+
+   return size;
+}
+
+// MARK: Public
+
+void hamt_new(
+   Hamt  *h,
+   size_t base_key_size,
+   size_t base_val_size,
+   HashFn hash_fn,
+   CmpFn  cmp_fn,
+   FreeFn free_fn
+)
+{
+   h->root = NULL;
+   h->n_items = 0;
+   h->base_key_size = base_key_size;
+   h->base_val_size = base_val_size;
+   h->hash_fn = hash_fn ? hash_fn : hashmap_default_hash_fn;
+   h->cmp_fn = cmp_fn ? cmp_fn : memcmp;
+   h->free_fn = free_fn;
+   h->n_cloned = 0;
+}
+
+static const HamtLeaf *hamt_find(const Hamt *h, const void *key, size_t key_size, Hash hash)
+{
+   const HamtNode *node = h->root;
+   unsigned        shift;
+   uint32_t        bit, i;
+
+   for (shift = 0; node; shift += HAMT_BITS) {
+      const void *slot;
+
+      if (shift >= HASH_BITS) {
+         for (i = 0; i < node->count; i++) {
+            if (leaf_match(h, as_leaf(node->slots[i]), key, key_size, hash))
+               return as_leaf(node->slots[i]);
+         }
+         return NULL;
+      }
+
+      bit = level_bit(hash, shift);
+      if (!(node->bitmap & bit))
+         return NULL;
+
+      slot = node->slots[slot_pos(node, bit)];
+      if (is_leaf(slot))
+         return leaf_match(h, as_leaf(slot), key, key_size, hash) ? as_leaf(slot) : NULL;
+      node = slot;
+   }
+
+   return NULL;
+}
+
+const void *hamt_get(const Hamt *h, const void *key, size_t *pval_size)
+{
+   size_t          key_size = hamt_key_size(h, key);
+   const HamtLeaf *leaf = hamt_find(h, key, key_size, h->hash_fn(key, key_size));
+
+   if (!leaf)
+      return NULL;
+   if (pval_size)
+      *pval_size = leaf->val_size;
+
+   return leaf_val(leaf);
+}
+
+bool hamt_set(Hamt *h, const void *key, const void *val)
+{
+   HamtEntry e;
+
+   e.key = key;
+   e.key_size = hamt_key_size(h, key);
+   e.val = val;
+   e.val_size = hamt_val_size(h, val);
+   e.hash = h->hash_fn(key, e.key_size);
+
+   if (!h->root)
+      h->root = node_new(0, 0);
+
+   if (hamt_set_rec(h, &h->root, 0, &e))
+      return true;
+
+   h->n_items++;
+   return false;
+}
+
+bool hamt_remove(Hamt *h, const void *key)
+{
+   HamtEntry e;
+
+   e.key = key;
+   e.key_size = hamt_key_size(h, key);
+   e.hash = h->hash_fn(key, e.key_size);
+
+   /* look first, so that removing a missing key doesn't copy the path */
+   if (!hamt_find(h, key, e.key_size, e.hash))
+      return false;
+
+   hamt_remove_rec(h, &h->root, 0, &e);
+   h->n_items--;
+
+   return true;
+}
+
+void hamt_snapshot(Hamt *dst, const Hamt *src)
+{
+   *dst = *src;
+   dst->n_cloned = 0;
+   if (dst->root)
+      slot_retain(dst->root);
+}
+
+void hamt_free(Hamt *h)
+{
+   if (h->root)
+      slot_release(h, h->root);
+   h->root = NULL;
+   h->n_items = 0;
+}
+
+size_t hamt_mem_usage(const Hamt *h)
+{
+   return h->root ? slot_mem_usage(h->root) : 0;
+}
+
+void hamtiter_init(HamtIter *iter, const Hamt *h)
+{
+   iter->depth = h->root ? 0 : -1;
+   iter->stack[0] = h->root;
+   iter->pos[0] = 0;
+   iter->leaf = NULL;
+}
+
+bool hamtiter_next(HamtIter *iter)
+{
+   while (iter->depth >= 0) {
+      const HamtNode *node = iter->stack[iter->depth];
+      const void     *slot;
+
+      if (iter->pos[iter->depth] == node->count) {
+         iter->depth--;
+         continue;
+      }
+
+      slot = node->slots[iter->pos[iter->depth]++];
+      if (is_leaf(slot)) {
+         iter->leaf = as_leaf(slot);
+         return true;
+      }
+
+      assert(iter->depth + 1 < HAMT_MAX_DEPTH);
+      iter->depth++;
+      iter->stack[iter->depth] = slot;
+      iter->pos[iter->depth] = 0;
+   }
+
+   iter->leaf = NULL;
+   return false;
+}
+
+const void *hamtiter_key(const HamtIter *iter)
+{
+   return leaf_key(iter->leaf);
+}
+
+const void *hamtiter_val(const HamtIter *iter, size_t *pval_size)
+{
+   if (pval_size)
+      *pval_size = iter->leaf->val_size;
+   return leaf_val(iter->leaf);
+}
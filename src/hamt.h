@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file hamt.h
+ */
+#ifndef __HAMT_H__
+#define __HAMT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hashmap.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+#define HAMT_BITS      5 /**< hash bits consumed per level */
+#define HAMT_MAX_DEPTH 8 /**< 7 levels for a 32bit hash, plus one for full collisions */
+
+typedef struct HamtNode HamtNode;
+typedef struct HamtLeaf HamtLeaf;
+
+/**
+ * @brief persistent hashmap (hash array mapped trie) with O(1) snapshots
+ *
+ * every level of the trie consumes HAMT_BITS of the hash, and stores only the children
+ * that exist, indexed by a bitmap. nodes are reference counted and shared between versions:
+ * taking a snapshot just references the root, and a write copies only the nodes
+ * on the path to the key that are shared with some other version (path copying).
+ * nodes owned by a single version are modified in place, so without snapshots around writes don't copy at all.
+ *
+ * a snapshot is a Hamt like any other, it can be read, modified and freed independently.
+ * each Hamt must be written by one thread at a time, and @p hamt_snapshot counts as a read of the source,
+ * but different versions can be used by different threads without any locking, readers never block.
+ *
+ * keys and values follow the same rules of @p HashMap (see @p hashmap_new)
+ *
+ * @note requires C11 atomics, like @p Queue
+ * @note the implementation assumes malloc never fails
+ */
+typedef struct Hamt {
+   HamtNode *root;
+   size_t    n_items; /**< item count */
+   size_t    base_key_size; /**< size of the keys if its constant, or HASHMAP_LEN_STR */
+   size_t    base_val_size; /**< size of the values if its constant, or HASHMAP_LEN_STR */
+   HashFn    hash_fn; /**< hash function in use */
+   CmpFn     cmp_fn; /**< compare function in use */
+   FreeFn    free_fn; /**< optional free function for data owned by values (not the values themselves) */
+   size_t    n_cloned; /**< nodes copied by writes because they were shared, a.k.a. write amplification */
+} Hamt;
+
+/**
+ * @brief sequential iterator over every key+value pair
+ *
+ * @note modifications to the Hamt can invalidate this, modifications to other versions can't
+ */
+typedef struct HamtIter {
+   const HamtNode *stack[HAMT_MAX_DEPTH]; /**< nodes being visited */
+   uint32_t        pos[HAMT_MAX_DEPTH]; /**< next slot to visit of each node */
+   int             depth; /**< top of the stack */
+   const HamtLeaf *leaf; /**< current key+value pair */
+} HamtIter;
+
+/**
+ * @brief initialize empty Hamt
+ *
+ * see @p hashmap_new for the parameters
+ */
+void hamt_new(
+   Hamt  *h,
+   size_t base_key_size,
+   size_t base_val_size,
+   HashFn hash_fn,
+   CmpFn  cmp_fn,
+   FreeFn free_fn
+);
+
+/**
+ * @brief get value corresponding to key
+ *
+ * @param[in] h Hamt
+ * @param[in] key key to find
+ * @param[out] pval_size if != NULL, it's set to the length of value. useful if HASHMAP_LEN_STR is used
+ *
+ * @return pointer to the value, or NULL
+ */
+const void *hamt_get(const Hamt *h, const void *key, size_t *pval_size);
+
+/**
+ * @brief update value if the key exists, insert otherwise
+ *
+ * @param[in,out] h Hamt
+ * @param[in] key key to find/set
+ * @param[in] val value to set
+ *
+ * @return if @p key existed
+ */
+bool hamt_set(Hamt *h, const void *key, const void *val);
+
+/**
+ * @brief remove key+value pair
+ *
+ * @param[in,out] h Hamt
+ * @param[in] key key to remove
+ *
+ * @return if @p key was found
+ */
+bool hamt_remove(Hamt *h, const void *key);
+
+/**
+ * @brief check if @p key exists
+ */
+INLINE static bool hamt_contains(const Hamt *h, const void *key)
+{
+   return hamt_get(h, key, NULL) != NULL;
+}
+
+/**
+ * @brief number of key+value pairs
+ */
+INLINE static size_t hamt_len(const Hamt *h)
+{
+   return h->n_items;
+}
+
+/**
+ * @brief take a snapshot of @p src, in O(1)
+ *
+ * from now on, writes to either of them don't affect the other
+ *
+ * @param[out] dst snapshot
+ * @param[in] src Hamt
+ */
+void hamt_snapshot(Hamt *dst, const Hamt *src);
+
+/**
+ * @brief release this version
+ *
+ * memory shared with other versions is freed only when the last one is released
+ *
+ * @param[in,out] h Hamt
+ */
+void hamt_free(Hamt *h);
+
+/**
+ * @brief bytes of memory reachable from this version, including the parts shared with others
+ */
+size_t hamt_mem_usage(const Hamt *h);
+
+/**
+ * @brief initialize iterator
+ *
+ * @param[out] iter
+ * @param[in] h
+ */
+void hamtiter_init(HamtIter *iter, const Hamt *h);
+
+/**
+ * @brief step on next element
+ *
+ * @param[in,out] iter iterator
+ *
+ * @return if the iterator is not exhausted
+ */
+bool hamtiter_next(HamtIter *iter);
+
+/**
+ * @brief pointer to the current key
+ * @note valid only after a successful hamtiter_next
+ */
+const void *hamtiter_key(const HamtIter *iter);
+
+/**
+ * @brief pointer to the current value
+ * @note valid only after a successful hamtiter_next
+ */
+const void *hamtiter_val(const HamtIter *iter, size_t *pval_size);
+
+#endif /* __HAMT_H__ */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file hash_internal.h
+ *
+ * hashing helpers shared by the hash tables (HashMap, IHashMap) and the hash kernels over
+ * Vec columns (GroupBy, HashJoin), so their hash function and sizing policy stay the same.
+ * only for the library's .c files, it's not part of the API
+ */
+#ifndef __HASH_INTERNAL_H__
+#define __HASH_INTERNAL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hashmap.h"
+#include "vec.h"
+#include "vec_internal.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+// MARK: bucket tables
+
+#define MIN_LOAD      0.25 /**< below this load factor the table shrinks */
+#define MAX_LOAD      0.75 /**< above this load factor the table grows */
+#define START_BUCKETS 64 /**< initial number of buckets */
+
+/**
+ * @brief round up to nearest power of two
+ */
+INLINE static Hash roundup_pow2(Hash num)
+{
+   size_t shift;
+
+   if (!num)
+      return 1;
+
+   num--;
+   for (shift = 1; shift < sizeof(num) * 8; shift <<= 1) {
+      num |= num >> shift;
+   }
+   num++;
+
+   return num;
+}
+
+INLINE static Hash bucket_idx(Hash hash, Hash n_buckets)
+{
+   return hash & (n_buckets - 1);
+}
+
+// MARK: integer keys
+
+/**
+ * @brief murmur3's finalizer, enough to spread integer keys
+ */
+INLINE static uint64_t hash_u64(uint64_t key)
+{
+   key ^= key >> 33;
+   key *= 0xff51afd7ed558ccdULL;
+   key ^= key >> 33;
+   key *= 0xc4ceb9fe1a85ec53ULL;
+   key ^= key >> 33;
+   return key;
+}
+
+/**
+ * @brief load @p n keys starting at @p row, widened to 64bit
+ */
+INLINE static void load_keys(const Vec *keys, size_t row, size_t n, uint64_t *out)
+{
+   size_t i;
+
+   switch (keys->size) {
+   case 1: {
+      const uint8_t *src = (const uint8_t *)keys->ptr + row;
+      for (i = 0; i < n; i++)
+         out[i] = src[i];
+      break;
+   }
+   case 2: {
+      const uint16_t *src = (const uint16_t *)keys->ptr + row;
+      for (i = 0; i < n; i++)
+         out[i] = src[i];
+      break;
+   }
+   case 4: {
+      const uint32_t *src = (const uint32_t *)keys->ptr + row;
+      for (i = 0; i < n; i++)
+         out[i] = src[i];
+      break;
+   }
+   default: {
+      memcpy(out, (const uint64_t *)keys->ptr + row, n * sizeof(uint64_t));
+      break;
+   }
+   }
+}
+
+#endif /* __HASH_INTERNAL_H__ */
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hashjoin.h"
+#include "hash_internal.h"
+
+#define BATCH          256 /**< probe rows loaded, hashed and prefetched at a time */
+#define PART_ROWS      8192 /**< target rows per partition, ~100KB of keys+rows+offsets */
+#define MAX_PART_BITS  14
+#define OUT_BATCH      1024 /**< matches buffered before being appended to the output */
+
+/**
+ * @brief bucket of @p hash, across all partitions
+ *
+ * the partition is taken from the high bits, the bucket inside it from the low ones,
+ * so the buckets of a partition are contiguous
+ */
+INLINE static size_t hashjoin_bucket(const HashJoin *hj, uint64_t hash)
+{
+   size_t part = hj->part_bits ? (size_t)(hash >> (64 - hj->part_bits)) : 0;
+   size_t mask = ((size_t)1 << hj->bucket_bits) - 1;
+
+   return (part << hj->bucket_bits) | ((size_t)hash & mask);
+}
+
+INLINE static unsigned log2_ceil(size_t num)
+{
+   unsigned bits = 0;
+
+   while (((size_t)1 << bits) < num)
+      bits++;
+   return bits;
+}
+
+void hashjoin_new(HashJoin *hj, const Vec *keys)
+{
+   uint64_t buf[BATCH];
+   size_t   n_parts, row, i, n;
+   size_t  *cursor;
+
+   assert(keys->size == 1 || keys->size == 2 || keys->size == 4 || keys->size == 8);
+   assert(keys->len <= UINT32_MAX);
+
+   hj->len = keys->len;
+   hj->part_bits = log2_ceil((keys->len + PART_ROWS - 1) / PART_ROWS);
+   if (hj->part_bits > MAX_PART_BITS)
+      hj->part_bits = MAX_PART_BITS;
+   n_parts = hashjoin_n_parts(hj);
+   /* about one row per bucket */
+   hj->bucket_bits = log2_ceil((keys->len + n_parts - 1) / n_parts);
+
+   hj->keys = malloc((keys->len ? keys->len : 1) * sizeof(uint64_t));
+   hj->rows = malloc((keys->len ? keys->len : 1) * sizeof(uint32_t));
+   hj->offs = malloc(((n_parts << hj->bucket_bits) + 1) * sizeof(uint32_t));
+   hj->part_offs = calloc(n_parts + 1, sizeof(size_t));
+   hj->offs[n_parts << hj->bucket_bits] = (uint32_t)keys->len;
+
+   /* histogram of the partitions, then scatter the rows in their partition */
+   for (row = 0; row < keys->len; row += n) {
+      n = keys->len - row < BATCH ? keys->len - row : BATCH;
+      load_keys(keys, row, n, buf);
+      for (i = 0; i < n; i++)
+         hj->part_offs[hashjoin_bucket(hj, hash_u64(buf[i])) >> hj->bucket_bits]++;
+   }
+
+   cursor = malloc(n_parts * sizeof(size_t));
+   for (i = 0, n = 0; i < n_parts; i++) {
+      size_t count = hj->part_offs[i];
+
+      hj->part_offs[i] = cursor[i] = n;
+      n += count;
+   }
+   hj->part_offs[n_parts] = n;
+
+   for (row = 0; row < keys->len; row += n) {
+      n = keys->len - row < BATCH ? keys->len - row : BATCH;
+      load_keys(keys, row, n, buf);
+      for (i = 0; i < n; i++) {
+         size_t dst = cursor[hashjoin_bucket(hj, hash_u64(buf[i])) >> hj->bucket_bits]++;
+
+         hj->keys[dst] = buf[i];
+         hj->rows[dst] = (uint32_t)(row + i);
+      }
+   }
+
+   free(cursor);
+}
+
+void hashjoin_build_parts(HashJoin *hj, size_t beg, size_t end)
+{
+   size_t    n_buckets = (size_t)1 << hj->bucket_bits;
+   size_t    max_rows = 0;
+   size_t    part, i;
+   uint64_t *keys;
+   uint32_t *rows, *cursor;
+
+   assert(end <= hashjoin_n_parts(hj));
+
+   for (part = beg; part < end; part++) {
+      if (hj->part_offs[part + 1] - hj->part_offs[part] > max_rows)
+         max_rows = hj->part_offs[part + 1] - hj->part_offs[part];
+   }
+
+   /* a partition is small, it's copied aside and scattered back in bucket order */
+   keys = malloc((max_rows ? max_rows : 1) * sizeof(uint64_t));
+   rows = malloc((max_rows ? max_rows : 1) * sizeof(uint32_t));
+   cursor = malloc(n_buckets * sizeof(uint32_t));
+
+   for (part = beg; part < end; part++) {
+      size_t    first = hj->part_offs[part];
+      size_t    len = hj->part_offs[part + 1] - first;
+      uint32_t *offs = hj->offs + (part << hj->bucket_bits);
+      uint32_t  off = (uint32_t)first;
+
+      memcpy(keys, hj->keys + first, len * sizeof(uint64_t));
+      memcpy(rows, hj->rows + first, len * sizeof(uint32_t));
+
+      memset(cursor, 0, n_buckets * sizeof(uint32_t));
+      for (i = 0; i < len; i++)
+         cursor[(size_t)hash_u64(keys[i]) & (n_buckets - 1)]++;
+      for (i = 0; i < n_buckets; i++) {
+         uint32_t count = cursor[i];
+
+         offs[i] = cursor[i] = off;
+         off += count;
+      }
+
+      for (i = 0; i < len; i++) {
+         uint32_t dst = cursor[(size_t)hash_u64(keys[i]) & (n_buckets - 1)]++;
+
+         hj->keys[dst] = keys[i];
+         hj->rows[dst] = rows[i];
+      }
+   }
+
+   free(keys);
+   free(rows);
+   free(cursor);
+}
+
+size_t hashjoin_probe_range(
+   const HashJoin *hj,
+   const Vec      *keys,
+   size_t          beg,
+   size_t          end,
+   Vec            *build_rows,
+   Vec            *probe_rows
+)
+{
+   uint64_t key_buf[BATCH];
+   size_t   bucket_buf[BATCH];
+   uint32_t first_buf[BATCH], last_buf[BATCH];
+   size_t   out_build[OUT_BATCH], out_probe[OUT_BATCH];
+   size_t   n_out = 0, n_matches = 0;
+   size_t   row, i, n;
+
+   assert(keys->size == 1 || keys->size == 2 || keys->size == 4 || keys->size == 8);
+   assert(build_rows->size == sizeof(size_t) && probe_rows->size == sizeof(size_t));
+   assert(end <= keys->len);
+
+   for (row = beg; row < end; row += n) {
+      n = end - row < BATCH ? end - row : BATCH;
+
+      /* three passes, each one prefetching what the next one reads */
+      load_keys(keys, row, n, key_buf);
+      for (i = 0; i < n; i++) {
+         bucket_buf[i] = hashjoin_bucket(hj, hash_u64(key_buf[i]));
+         PREFETCH(&hj->offs[bucket_buf[i]]);
+      }
+
+      for (i = 0; i < n; i++) {
+         first_buf[i] = hj->offs[bucket_buf[i]];
+         last_buf[i] = hj->offs[bucket_buf[i] + 1];
+         PREFETCH(&hj->keys[first_buf[i]]);
+      }
+
+      for (i = 0; i < n; i++) {
+         uint32_t j;
+
+         for (j = first_buf[i]; j < last_buf[i]; j++) {
+            if (hj->keys[j] != key_buf[i])
+               continue;
+
+            out_build[n_out] = hj->rows[j];
+            out_probe[n_out] = row + i;
+            if (++n_out == OUT_BATCH) {
+               vec_insert_n(build_rows, build_rows->len, out_build, n_out);
+               vec_insert_n(probe_rows, probe_rows->len, out_probe, n_out);
+               n_matches += n_out;
+               n_out = 0;
+            }
+         }
+      }
+   }
+
+   if (n_out) {
+      vec_insert_n(build_rows, build_rows->len, out_build, n_out);
+      vec_insert_n(probe_rows, probe_rows->len, out_probe, n_out);
+   }
+
+   return n_matches + n_out;
+}
+
+void hashjoin_free(HashJoin *hj)
+{
+   free(hj->keys);
+   free(hj->rows);
+   free(hj->offs);
+   free(hj->part_offs);
+   memset(hj, 0, sizeof(*hj));
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file hashjoin.h
+ */
+#ifndef __HASHJOIN_H__
+#define __HASHJOIN_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief equi-join of two @p Vec columns of integer keys
+ *
+ * the build side is radix-partitioned on the high bits of the hash, so that every partition fits in cache,
+ * and each partition is laid out as a compact bucket-chained table: the rows of a bucket are
+ * contiguous, and a single array of offsets (one per bucket) replaces the pointers of a regular hashmap.
+ * duplicate build keys are allowed, every match is emitted.
+ *
+ * the probe side is processed in batches: keys are hashed and the bucket offsets prefetched first,
+ * then the first rows of every bucket, and only then the buckets are scanned.
+ *
+ * to run in parallel, split the partitions with @p hashjoin_build_parts ,
+ * and the probe rows with @p hashjoin_probe_range , giving each thread its own output Vecs
+ *
+ * @note the build side is limited to UINT32_MAX rows
+ * @note the implementation assumes malloc never fails
+ */
+typedef struct HashJoin {
+   uint64_t *keys; /**< build keys, grouped by partition and then by bucket */
+   uint32_t *rows; /**< build row of each key */
+   uint32_t *offs; /**< start of each bucket in keys/rows, plus the end of the last one */
+   size_t   *part_offs; /**< start of each partition in keys/rows, plus the end of the last one */
+   size_t    len; /**< build rows */
+   unsigned  part_bits; /**< log2 of the number of partitions */
+   unsigned  bucket_bits; /**< log2 of the number of buckets of each partition */
+} HashJoin;
+
+/**
+ * @brief partition the build side, without building the tables yet
+ *
+ * @param[out] hj join
+ * @param[in] keys build column, elements of 1, 2, 4 or 8 bytes treated as unsigned integers
+ */
+void hashjoin_new(HashJoin *hj, const Vec *keys);
+
+/**
+ * @brief build the tables of the partitions in [ @p beg, @p end )
+ *
+ * partitions are independent, so different threads can build different ranges
+ *
+ * @param[in,out] hj join
+ * @param[in] beg first partition
+ * @param[in] end one past the last partition
+ */
+void hashjoin_build_parts(HashJoin *hj, size_t beg, size_t end);
+
+/**
+ * @brief number of partitions
+ */
+INLINE static size_t hashjoin_n_parts(const HashJoin *hj)
+{
+   return (size_t)1 << hj->part_bits;
+}
+
+/**
+ * @brief partition the build side and build every table
+ *
+ * see @p hashjoin_new
+ */
+INLINE static void hashjoin_build(HashJoin *hj, const Vec *keys)
+{
+   hashjoin_new(hj, keys);
+   hashjoin_build_parts(hj, 0, hashjoin_n_parts(hj));
+}
+
+/**
+ * @brief find the build rows matching the probe rows in [ @p beg, @p end )
+ *
+ * for every match, the build row and the probe row are appended to the output Vecs, as size_t.
+ * the join is only read, so different threads can probe different ranges
+ *
+ * @param[in] hj join, completely built
+ * @param[in] keys probe column, elements of 1, 2, 4 or 8 bytes
+ * @param[in] beg first probe row
+ * @param[in] end one past the last probe row
+ * @param[in,out] build_rows Vec of size_t
+ * @param[in,out] probe_rows Vec of size_t
+ *
+ * @return number of matches
+ */
+size_t hashjoin_probe_range(
+   const HashJoin *hj,
+   const Vec      *keys,
+   size_t          beg,
+   size_t          end,
+   Vec            *build_rows,
+   Vec            *probe_rows
+);
+
+/**
+ * @brief find the build rows matching every probe row
+ *
+ * see @p hashjoin_probe_range
+ */
+INLINE static size_t
+hashjoin_probe(const HashJoin *hj, const Vec *keys, Vec *build_rows, Vec *probe_rows)
+{
+   return hashjoin_probe_range(hj, keys, 0, keys->len, build_rows, probe_rows);
+}
+
+/**
+ * @brief release memory
+ *
+ * @param[in,out] hj join
+ */
+void hashjoin_free(HashJoin *hj);
+
+#endif /* __HASHJOIN_H__ */
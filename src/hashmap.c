@@ -10,15 +10,18 @@
 #include <math.h>
 
 #include "hashmap.h"
+#include "hash_internal.h"
 
-#define MIN_LOAD      0.25
-#define MAX_LOAD      0.75
-#define START_BUCKETS 64 /**< initial number of buckets */
+/**< with TTLs enabled, a Timer is allocated right before every HashNode */
+#define TIMER_PREFIX ALIGN_UP(sizeof(Timer))
+
+#define POOL_GRANULARITY 16 /**< size classes of the pool are multiples of this */
+#define POOL_CLASSES     32 /**< allocations above POOL_GRANULARITY * POOL_CLASSES bytes are not recycled */
 
 /**
  * @brief Perl's hash function
  */
-static Hash default_hash_fn(const void *key, size_t size)
+Hash hashmap_default_hash_fn(const void *key, size_t size)
 {
    register const uint8_t *data = (const uint8_t *)key;
    register size_t         i = size;
@@ -37,41 +40,154 @@ static Hash default_hash_fn(const void *key, size_t size)
    return hash;
 }
 
+INLINE static size_t hashmap_key_size(const HashMap *map, const void *key)
+{
+   return map->base_key_size == HASHMAP_LEN_STR ? strlen((char *)key) + 1 : map->base_key_size;
+}
+
+INLINE static size_t hashmap_val_size(const HashMap *map, const void *val)
+{
+   return map->base_val_size == HASHMAP_LEN_STR ? strlen((char *)val) + 1 : map->base_val_size;
+}
+
+//
+// MARK: Pool
+//
+
 /**
- * @brief round up to nearest power of two
+ * @brief size class of a @p size bytes allocation
+ * 
+ * @return class index, or POOL_CLASSES if it's too big to be recycled
  */
-INLINE static Hash roundup_pow2(Hash num)
+INLINE static size_t pool_class(size_t size)
 {
-   size_t shift;
+   size_t cls = size ? (size - 1) / POOL_GRANULARITY : 0;
+   return cls < POOL_CLASSES ? cls : POOL_CLASSES;
+}
 
-   if (!num)
-      return 1;
+/**
+ * @brief number of bytes actually allocated for a request of @p size bytes
+ * 
+ * rounding up to the class size is what allows any block of the class to be reused for any request of the class
+ */
+INLINE static size_t pool_block_size(size_t size)
+{
+   size_t cls = pool_class(size);
+   return cls < POOL_CLASSES ? (cls + 1) * POOL_GRANULARITY : size;
+}
+
+/**
+ * @brief allocate @p size bytes, reusing a recycled block when possible
+ */
+static void *pool_alloc(HashMap *map, size_t size)
+{
+   size_t cls = pool_class(size);
 
-   num--;
-   for (shift = 1; shift < sizeof(num) * 8; shift <<= 1) {
-      num |= num >> shift;
+   if (cls < POOL_CLASSES && map->pool && map->pool[cls]) {
+      void *block = map->pool[cls];
+      map->pool[cls] = *(void **)block;
+      return block;
    }
-   num++;
 
-   return num;
+   return malloc(pool_block_size(size));
 }
 
-INLINE static Hash bucket_idx(Hash hash, Hash n_buckets)
+/**
+ * @brief resize a block obtained through @p pool_alloc
+ */
+INLINE static void *pool_realloc(void *ptr, size_t size)
 {
-   return hash & (n_buckets - 1);
+   return realloc(ptr, pool_block_size(size));
+}
+
+/**
+ * @brief give back a block of (at least) @p size bytes for later reuse
+ */
+static void pool_recycle(HashMap *map, void *ptr, size_t size)
+{
+   size_t cls = pool_class(size);
+
+   if (cls == POOL_CLASSES) {
+      free(ptr);
+      return;
+   }
+
+   if (!map->pool)
+      map->pool = calloc(POOL_CLASSES, sizeof(void *));
+   *(void **)ptr = map->pool[cls];
+   map->pool[cls] = ptr;
+}
+
+/**
+ * @brief release every recycled block
+ */
+static void pool_free(HashMap *map)
+{
+   size_t cls;
+
+   if (!map->pool)
+      return;
+
+   for (cls = 0; cls < POOL_CLASSES; cls++) {
+      void *block = map->pool[cls];
+
+      while (block) {
+         void *next = *(void **)block;
+         free(block);
+         block = next;
+      }
+   }
+   free(map->pool);
+   map->pool = NULL;
 }
 
 //
 // MARK: HashNode
 //
 
-static HashNode *
-hashnode_new(const void *key, size_t key_size, Hash hash, const void *val, size_t val_size)
+INLINE static Timer *hashnode_timer(HashNode *node)
 {
-   HashNode *node = malloc((size_t)ALIGN_UP(sizeof(HashNode)) + key_size);
+   return (Timer *)((char *)node - TIMER_PREFIX);
+}
+
+INLINE static HashNode *timer_hashnode(Timer *timer)
+{
+   return (HashNode *)((char *)timer + TIMER_PREFIX);
+}
+
+/**
+ * @brief beginning of the allocation of @p node
+ */
+INLINE static void *hashnode_base(HashNode *node, const HashMap *map)
+{
+   return map->wheel ? (void *)hashnode_timer(node) : (void *)node;
+}
+
+/**
+ * @brief size of the allocation of a node holding a key of @p key_size bytes
+ */
+INLINE static size_t hashnode_size(const HashMap *map, size_t key_size)
+{
+   return (map->wheel ? (size_t)TIMER_PREFIX : 0) + (size_t)ALIGN_UP(sizeof(HashNode)) + key_size;
+}
+
+static HashNode *hashnode_new(
+   HashMap    *map,
+   const void *key,
+   size_t      key_size,
+   Hash        hash,
+   const void *val,
+   size_t      val_size
+)
+{
+   char     *base = pool_alloc(map, hashnode_size(map, key_size));
+   HashNode *node = (HashNode *)(base + (map->wheel ? (size_t)TIMER_PREFIX : 0));
+
+   if (map->wheel)
+      timer_init(hashnode_timer(node));
 
    node->next = NULL;
-   node->val = malloc(val_size);
+   node->val = pool_alloc(map, val_size);
    memcpy(node->val, val, val_size);
    node->val_size = (uint32_t)val_size;
    node->hash = hash;
@@ -80,12 +196,40 @@ hashnode_new(const void *key, size_t key_size, Hash hash, const void *val, size_
    return node;
 }
 
-INLINE static void hashnode_free(HashNode *node, FreeFn free_fn)
+/**
+ * @brief recycle the node, but not its value
+ */
+INLINE static void hashnode_release(HashNode *node, HashMap *map)
+{
+   size_t key_size = hashmap_key_size(map, HASHNODE_KEY(node));
+
+   if (map->wheel)
+      timewheel_remove(map->wheel, hashnode_timer(node));
+   pool_recycle(map, hashnode_base(node, map), hashnode_size(map, key_size));
+}
+
+/**
+ * @brief recycle the node and its value
+ */
+INLINE static void hashnode_free(HashNode *node, HashMap *map)
 {
-   if (free_fn)
-      free_fn(node->val);
-   free(node->val);
-   free(node);
+   if (map->free_fn)
+      map->free_fn(node->val);
+   pool_recycle(map, node->val, node->val_size);
+   hashnode_release(node, map);
+}
+
+/**
+ * @brief if @p node has a TTL that has elapsed
+ */
+INLINE static bool hashnode_expired(const HashNode *node, const HashMap *map)
+{
+   const Timer *timer;
+
+   if (!map->wheel)
+      return false;
+   timer = hashnode_timer((HashNode *)node);
+   return timer_pending(timer) && timer->expire <= map->wheel->now;
 }
 
 static bool hashnode_eq(HashNode *node, const void *key, size_t key_size, Hash hash, CmpFn cmp_fn)
@@ -98,18 +242,8 @@ static bool hashnode_eq(HashNode *node, const void *key, size_t key_size, Hash h
 // MARK: HashMap
 //
 
-INLINE static size_t hashmap_key_size(HashMap *map, const void *key)
-{
-   return map->base_key_size == HASHMAP_LEN_STR ? strlen((char *)key) + 1 : map->base_key_size;
-}
-
-INLINE static size_t hashmap_val_size(HashMap *map, const void *val)
-{
-   return map->base_val_size == HASHMAP_LEN_STR ? strlen((char *)val) + 1 : map->base_val_size;
-}
-
 static HashNode *
-hashmap_find(HashMap *map, const void *key, size_t key_size, Hash hash, HashNode **pprev)
+hashmap_find(const HashMap *map, const void *key, size_t key_size, Hash hash, HashNode **pprev)
 {
    HashNode *node, *prev = NULL;
    Hash      idx = bucket_idx(hash, map->n_buckets);
@@ -119,14 +253,30 @@ hashmap_find(HashMap *map, const void *key, size_t key_size, Hash hash, HashNode
 
    for (node = map->buckets[idx]; node; node = node->next) {
       if (hashnode_eq(node, key, key_size, hash, map->cmp_fn))
-         return node;
+         break;
       prev = node;
    }
 
    if (pprev)
       *pprev = prev;
 
-   return NULL;
+   return node;
+}
+
+/**
+ * @brief unlink @p node from its bucket
+ * 
+ * @param[in,out] map hashmap
+ * @param[in,out] node node to unlink
+ * @param[in] prev node before @p node in the bucket, or NULL if it's the first
+ */
+INLINE static void hashmap_unlink(HashMap *map, HashNode *node, HashNode *prev)
+{
+   if (prev)
+      prev->next = node->next;
+   else
+      map->buckets[bucket_idx(node->hash, map->n_buckets)] = node->next;
+   map->n_items--;
 }
 
 static HashNode *hashmap_insert(
@@ -139,7 +289,7 @@ static HashNode *hashmap_insert(
    HashNode  **pprev
 )
 {
-   HashNode *node = hashnode_new(key, key_size, hash, val, val_size);
+   HashNode *node = hashnode_new(map, key, key_size, hash, val, val_size);
    HashNode *prev = NULL;
    Hash      idx;
 
@@ -178,16 +328,50 @@ void hashmap_new(
    memset(map, 0, sizeof(*map));
    map->base_key_size = base_key_size;
    map->base_val_size = base_val_size;
-   map->hash_fn = hash_fn ? hash_fn : default_hash_fn;
+   map->hash_fn = hash_fn ? hash_fn : hashmap_default_hash_fn;
    map->cmp_fn = cmp_fn ? cmp_fn : memcmp;
    map->free_fn = free_fn;
 }
 
+/**
+ * @brief move every node to a new array of @p n_buckets buckets
+ * 
+ * @param[in,out] map hashmap
+ * @param[in] n_buckets new number of buckets, power of two
+ */
+static void hashmap_resize(HashMap *map, Hash n_buckets)
+{
+   HashNode **buckets = (HashNode **)calloc((size_t)n_buckets, sizeof(HashNode *));
+
+   while (map->n_buckets--) {
+      HashNode *node = map->buckets[map->n_buckets];
+
+      while (node) {
+         HashNode *next = node->next;
+         Hash      idx = bucket_idx(node->hash, n_buckets);
+
+         node->next = buckets[idx];
+         buckets[idx] = node;
+         node = next;
+      }
+   }
+
+   free(map->buckets);
+   map->buckets = buckets;
+   map->n_buckets = n_buckets;
+}
+
+/**
+ * @brief number of buckets that puts @p n_items halfway between the load thresholds
+ */
+INLINE static Hash hashmap_ideal_buckets(size_t n_items)
+{
+   return roundup_pow2((Hash)((float)(n_items * 2) / (MIN_LOAD + MAX_LOAD)));
+}
+
 bool hashmap_rehash(HashMap *map)
 {
-   HashNode **buckets;
-   Hash       n_buckets;
-   float      load;
+   float load;
 
    if (!map->n_buckets)
       return false;
@@ -196,43 +380,184 @@ bool hashmap_rehash(HashMap *map)
    if (load >= MIN_LOAD && load <= MAX_LOAD)
       return false;
 
-   n_buckets = (Hash)((float)(map->n_items * 2) / (MIN_LOAD + MAX_LOAD));
-   n_buckets = roundup_pow2(n_buckets);
-   buckets = (HashNode **)calloc((size_t)n_buckets, sizeof(HashNode *));
+   hashmap_resize(map, hashmap_ideal_buckets(map->n_items));
 
-   while (map->n_buckets--) {
-      HashNode *node = map->buckets[map->n_buckets];
+   return true;
+}
+
+void hashmap_stats(const HashMap *map, HashStats *stats)
+{
+   Hash idx;
+
+   memset(stats, 0, sizeof(*stats));
+   stats->n_items = map->n_items;
+   stats->n_buckets = map->n_buckets;
+   if (map->n_buckets)
+      stats->load = (float)map->n_items / (float)map->n_buckets;
+
+   for (idx = 0; idx < map->n_buckets; idx++) {
+      const HashNode *node;
+      size_t          len = 0;
+
+      for (node = map->buckets[idx]; node; node = node->next) {
+         len++;
+      }
+      if (len)
+         stats->n_used++;
+      if (len > stats->max_chain)
+         stats->max_chain = len;
+   }
+}
+
+void hashmap_merge(HashMap *dst, HashMap *src, MergeFn merge_fn)
+{
+   Hash idx, n_buckets;
+
+   assert(dst->base_key_size == src->base_key_size);
+   assert(dst->base_val_size == src->base_val_size);
+   assert(!dst->wheel == !src->wheel);
+   assert(dst->hash_fn == src->hash_fn && dst->cmp_fn == src->cmp_fn && dst->free_fn == src->free_fn);
+
+   if (!src->n_items)
+      return;
+
+   /* worst case no key is shared, so dst is resized at most once */
+   n_buckets = hashmap_ideal_buckets(dst->n_items + src->n_items);
+   if (n_buckets < START_BUCKETS)
+      n_buckets = START_BUCKETS;
+   if (n_buckets > dst->n_buckets)
+      hashmap_resize(dst, n_buckets);
+
+   for (idx = 0; idx < src->n_buckets; idx++) {
+      HashNode *node = src->buckets[idx];
 
       while (node) {
          HashNode *next = node->next;
-         Hash      idx = bucket_idx(node->hash, n_buckets);
+         void     *key = HASHNODE_KEY(node);
+         HashNode *found = hashmap_find(dst, key, hashmap_key_size(dst, key), node->hash, NULL);
+
+         if (found) {
+            if (merge_fn)
+               merge_fn(found->val, node->val);
+            else {
+               void    *val = found->val;
+               uint32_t val_size = found->val_size;
+
+               found->val = node->val;
+               found->val_size = node->val_size;
+               node->val = val;
+               node->val_size = val_size;
+            }
+            hashnode_free(node, src);
+         }
+         else {
+            Hash dst_idx = bucket_idx(node->hash, dst->n_buckets);
+
+            if (src->wheel) {
+               Timer *timer = hashnode_timer(node);
+
+               if (timer_pending(timer)) {
+                  timewheel_remove(src->wheel, timer);
+                  timewheel_add(dst->wheel, timer, timer->expire);
+               }
+            }
+            node->next = dst->buckets[dst_idx];
+            dst->buckets[dst_idx] = node;
+            dst->n_items++;
+         }
 
-         node->next = buckets[idx];
-         buckets[idx] = node;
          node = next;
       }
+      src->buckets[idx] = NULL;
    }
+   src->n_items = 0;
+}
 
-   free(map->buckets);
-   map->buckets = buckets;
-   map->n_buckets = n_buckets;
+bool hashmap_enable_ttl(HashMap *map, Tick now)
+{
+   if (map->n_items)
+      return false;
+
+   if (!map->wheel)
+      map->wheel = malloc(sizeof(TimeWheel));
+   timewheel_init(map->wheel, now);
 
    return true;
 }
 
-void hashmap_free(HashMap *map)
+size_t hashmap_expire(HashMap *map, Tick now, size_t budget)
 {
-   while (map->n_buckets--) {
-      HashNode *node = map->buckets[map->n_buckets];
+   LList  expired;
+   LNode *curr, *next;
+   size_t n_expired;
+
+   assert(map->wheel);
+
+   llist_init(&expired);
+   n_expired = timewheel_advance(map->wheel, now, &expired, budget);
+
+   llist_foreach(&expired, curr, next) {
+      HashNode *node = timer_hashnode(timer_entry(curr, Timer, link));
+      HashNode *prev = NULL;
+      HashNode *tmp = map->buckets[bucket_idx(node->hash, map->n_buckets)];
+
+      while (tmp != node) {
+         prev = tmp;
+         tmp = tmp->next;
+      }
+      llist_remove(curr);
+      hashmap_unlink(map, node, prev);
+      hashnode_free(node, map);
+   }
+
+   return n_expired;
+}
+
+const void *hashmap_get(const HashMap *map, const void *key, size_t *pval_size)
+{
+   size_t    key_size = hashmap_key_size(map, key);
+   HashNode *node = hashmap_find(map, key, key_size, map->hash_fn(key, key_size), NULL);
+
+   /* expired but not collected: absent, and left for hashmap_expire */
+   if (!node || hashnode_expired(node, map))
+      return NULL;
+
+   if (pval_size)
+      *pval_size = (size_t)node->val_size;
+   return node->val;
+}
+
+bool hashmap_contains(const HashMap *map, const void *key)
+{
+   return hashmap_get(map, key, NULL) != NULL;
+}
+
+void hashmap_clear(HashMap *map)
+{
+   Hash idx;
+
+   for (idx = 0; idx < map->n_buckets; idx++) {
+      HashNode *node = map->buckets[idx];
+
       while (node) {
          HashNode *next = node->next;
-         hashnode_free(node, map->free_fn);
+         hashnode_free(node, map);
          node = next;
       }
+      map->buckets[idx] = NULL;
    }
+   map->n_items = 0;
+}
+
+void hashmap_free(HashMap *map)
+{
+   hashmap_clear(map);
+   pool_free(map);
    free(map->buckets);
+   free(map->wheel);
    map->buckets = NULL;
-   map->n_buckets = map->n_items = 0;
+   map->wheel = NULL;
+   map->n_buckets = 0;
 }
 
 //
@@ -246,6 +571,13 @@ bool hashentry_init(HashEntry *entry, HashMap *map, const void *key)
    entry->hash = map->hash_fn(key, entry->key_size);
    entry->node = hashmap_find(map, key, entry->key_size, entry->hash, &entry->prev);
 
+   if (entry->node && hashnode_expired(entry->node, map)) {
+      HashNode *prev = entry->prev;
+
+      hashentry_remove(entry, NULL, NULL);
+      entry->prev = prev;
+   }
+
    return entry->node != NULL;
 }
 
@@ -262,14 +594,14 @@ bool hashentry_set(HashEntry *entry, const void *val, void **pval, size_t *pval_
          *pval_size = node->val_size;
       if (pval) {
          *pval = node->val;
-         node->val = malloc(val_size);
+         node->val = pool_alloc(map, val_size);
          node->val_size = val_size;
       }
       else {
          if (map->free_fn)
             map->free_fn(node->val);
          if (node->val_size < val_size) {
-            node->val = realloc(node->val, val_size);
+            node->val = pool_realloc(node->val, val_size);
             node->val_size = val_size;
          }
       }
@@ -300,25 +632,37 @@ bool hashentry_remove(HashEntry *entry, void **pval, size_t *pval_size)
       return false;
    }
 
-   if (prev)
-      prev->next = node->next;
-   else
-      map->buckets[bucket_idx(entry->hash, map->n_buckets)] = node->next;
-   map->n_items--;
+   hashmap_unlink(map, node, prev);
 
    if (pval_size)
       *pval_size = node->val_size;
    if (pval) {
       *pval = node->val;
-      free(node);
+      hashnode_release(node, map);
    }
    else
-      hashnode_free(node, map->free_fn);
+      hashnode_free(node, map);
    entry->node = entry->prev = NULL;
 
    return true;
 }
 
+bool hashentry_set_ttl(HashEntry *entry, Tick ttl)
+{
+   HashMap *map = entry->map;
+   Timer   *timer;
+
+   if (!entry->node || !map->wheel)
+      return false;
+
+   timer = hashnode_timer(entry->node);
+   timewheel_remove(map->wheel, timer);
+   if (ttl != HASHMAP_TTL_NONE)
+      timewheel_add(map->wheel, timer, map->wheel->now + ttl);
+
+   return true;
+}
+
 //
 // MARK: HashIter
 //
@@ -327,17 +671,21 @@ bool hashiter_next(HashIter *iter)
 {
    const HashMap *map = iter->map;
 
-   if (iter->node && iter->node->next) {
-      iter->node = iter->node->next;
-      return true;
-   }
-
-   while (++iter->idx < map->n_buckets) {
-      if (map->buckets[iter->idx]) {
-         iter->node = map->buckets[iter->idx];
-         return true;
+   do {
+      if (iter->node && iter->node->next)
+         iter->node = iter->node->next;
+      else {
+         iter->node = NULL;
+         while (++iter->idx < map->n_buckets) {
+            if (map->buckets[iter->idx]) {
+               iter->node = map->buckets[iter->idx];
+               break;
+            }
+         }
+         if (!iter->node)
+            return false;
       }
-   }
+   } while (hashnode_expired(iter->node, map));
 
-   return false;
+   return true;
 }
\ No newline at end of file
@@ -15,6 +15,8 @@
 #include <stdint.h>
 #include <assert.h>
 
+#include "timewheel.h"
+
 #ifdef _MSC_VER
    #define INLINE __inline
 #elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
@@ -23,7 +25,8 @@
    #define INLINE
 #endif
 
-#define HASHMAP_LEN_STR ((size_t)-1) /**< marker for keys that are variable length c-strings */
+#define HASHMAP_LEN_STR  ((size_t)-1) /**< marker for keys that are variable length c-strings */
+#define HASHMAP_TTL_NONE ((Tick)-1) /**< TTL of entries that never expire */
 
 #if defined(__STDC__) && __STDC_VERSION__ >= 201112L
    #include "stddef.h"
@@ -46,6 +49,18 @@ typedef uint32_t Hash; /**< type of the hash */
 typedef Hash (*HashFn)(const void *key, size_t size);
 typedef void (*FreeFn)(void *ptr);
 typedef int (*CmpFn)(const void *ptr1, const void *ptr2, size_t num);
+typedef void (*MergeFn)(void *dst_val, const void *src_val); /**< combine @p src_val into @p dst_val */
+
+/**
+ * @brief snapshot of how the items are spread over the buckets
+ */
+typedef struct HashStats {
+   size_t n_items; /**< item count */
+   Hash   n_buckets; /**< number of buckets */
+   Hash   n_used; /**< number of non-empty buckets */
+   size_t max_chain; /**< length of the longest bucket */
+   float  load; /**< n_items / n_buckets */
+} HashStats;
 
 typedef struct HashNode {
    struct HashNode *next;
@@ -63,6 +78,11 @@ typedef struct HashNode {
  * 
  * also check-out @p HashEntry below, as it allows for optimizations and more control
  * 
+ * entries can optionally expire, see @p hashmap_enable_ttl
+ * 
+ * the memory of removed entries is not released but kept in a per-map pool, until @p hashmap_free.
+ * this way a map that is filled and emptied over and over (see @p hashmap_clear) stops allocating
+ * 
  * @note the implementation assumes malloc never fails
  */
 typedef struct HashMap {
@@ -74,6 +94,8 @@ typedef struct HashMap {
    HashFn     hash_fn; /**< hash function in use */
    CmpFn      cmp_fn; /**< ustom compare function */
    FreeFn     free_fn; /**< optional free function for data owned by values (not the values themselves) */
+   TimeWheel *wheel; /**< expiration of the entries, or NULL if TTLs are not enabled */
+   void     **pool; /**< recycled allocations, by size class */
 } HashMap;
 
 /**
@@ -108,6 +130,9 @@ typedef struct HashIter {
 /**
  * @brief lookup @p key and prepare @p entry struct
  * 
+ * if TTLs are enabled and the entry found is expired, it's removed on the spot, so this modifies the map
+ * even when the entry is only read. use @p hashmap_get for read-only lookups
+ * 
  * @param[out] entry entry
  * @param[in] map hashmap
  * @param[in] key key to find
@@ -139,6 +164,19 @@ bool hashentry_set(HashEntry *entry, const void *val, void **pval, size_t *pval_
  */
 bool hashentry_remove(HashEntry *entry, void **pval, size_t *pval_size);
 
+/**
+ * @brief set the time-to-live of the entry
+ * 
+ * the entry expires @p ttl ticks after the current time of the map (see @p hashmap_expire)
+ * updating the value of an entry doesn't change its TTL
+ * 
+ * @param[in,out] entry entry
+ * @param[in] ttl time-to-live, or HASHMAP_TTL_NONE to make the entry persistent
+ * 
+ * @return false if the entry wasn't found, or TTLs are not enabled
+ */
+bool hashentry_set_ttl(HashEntry *entry, Tick ttl);
+
 /**
  * @brief key corresponding to the entry
  * 
@@ -202,18 +240,17 @@ void hashmap_new(
 /**
  * @brief get value corresponding to key
  * 
+ * if TTLs are enabled, an expired entry is treated as absent, but left in the map:
+ * read-only lookups never modify it, so they are safe from multiple threads and don't
+ * invalidate @p HashIter . it's freed by @p hashmap_expire or the next modification of its key
+ * 
  * @param[in] map hashmap
  * @param[in] key key to find
  * @param[out] pval_size if != NULL, it's set to the length of value. useful if HASHMAP_LEN_STR is used
  * 
  * @return pointer to the value, or NULL
  */
-INLINE static const void *hashmap_get(const HashMap *map, const void *key, size_t *pval_size)
-{
-   HashEntry entry;
-   hashentry_init(&entry, (HashMap *)map, key);
-   return hashentry_val(&entry, pval_size);
-}
+const void *hashmap_get(const HashMap *map, const void *key, size_t *pval_size);
 
 /**
  * @brief update value if the key exists, insert otherwise
@@ -252,14 +289,30 @@ INLINE static bool hashmap_remove(HashMap *map, const void *key, void **pval, si
 }
 
 /**
- * @brief check if @p key exists in the hashmap
+ * @brief set the time-to-live of @p key
+ * 
+ * see @p hashentry_set_ttl for details
+ * 
+ * @param[in,out] map hashmap
+ * @param[in] key key to find
+ * @param[in] ttl time-to-live, or HASHMAP_TTL_NONE to make the entry persistent
+ * 
+ * @return false if @p key wasn't found, or TTLs are not enabled
  */
-INLINE static bool hashmap_contains(const HashMap *map, const void *key)
+INLINE static bool hashmap_set_ttl(HashMap *map, const void *key, Tick ttl)
 {
    HashEntry entry;
-   return hashentry_init(&entry, (HashMap *)map, key);
+   hashentry_init(&entry, map, key);
+   return hashentry_set_ttl(&entry, ttl);
 }
 
+/**
+ * @brief check if @p key exists in the hashmap
+ * 
+ * an expired entry doesn't exist, and is left in the map (see @p hashmap_get)
+ */
+bool hashmap_contains(const HashMap *map, const void *key);
+
 /**
  * @brief manually request a rehash
  * 
@@ -272,9 +325,70 @@ INLINE static bool hashmap_contains(const HashMap *map, const void *key)
  */
 bool hashmap_rehash(HashMap *map);
 
+/**
+ * @brief move every key+value pair of @p src into @p dst
+ * 
+ * nodes are relinked into @p dst as they are, using the hash they already store,
+ * so no key is hashed or copied again and nothing is allocated, except for resizing @p dst (at most once)
+ * 
+ * the maps need to have the same key and value sizes, the same hash, compare and free functions
+ * (stored hashes are reused and @p dst 's replaced values are freed with @p src 's free_fn),
+ * and either both or neither have TTLs enabled.
+ * entries moved keep their TTL, while for conflicts the TTL of @p dst is kept
+ * 
+ * @note @p dst is sized for the case where no key is shared, you can use @p hashmap_rehash afterwards if that's a concern
+ * 
+ * @param[in,out] dst destination hashmap
+ * @param[in,out] src source hashmap, it's empty on exit but still usable
+ * @param[in] merge_fn if != NULL, called for keys present in both maps to combine the values into @p dst 's one,
+ *                     then @p src 's value is freed. the values can't change size.
+ *                     if NULL, @p src 's value replaces @p dst 's one
+ */
+void hashmap_merge(HashMap *dst, HashMap *src, MergeFn merge_fn);
+
+/**
+ * @brief enable per-entry expiration
+ * 
+ * entries are tracked by a hierarchical timing wheel, so the map doesn't need to be scanned to find the expired ones.
+ * they are collected by @p hashmap_expire. expired entries that weren't collected yet are invisible:
+ * read-only lookups and @p HashIter skip them, and @p hashentry_init (so set, remove and set_ttl) frees them
+ * 
+ * every node carries an extra @p Timer, so this is opt-in
+ * 
+ * @param[in,out] map hashmap, must be empty
+ * @param[in] now current time, in whatever unit the TTLs are going to be expressed in
+ * 
+ * @return false if the hashmap is not empty
+ */
+bool hashmap_enable_ttl(HashMap *map, Tick now);
+
+/**
+ * @brief move the clock of the map forward and remove the expired entries
+ * 
+ * the work done is proportional to the entries removed (plus a bounded scan per non-empty slot of the wheel), not the size of the map
+ * 
+ * @param[in,out] map hashmap, with TTLs enabled
+ * @param[in] now current time
+ * @param[in] budget maximum number of entries to remove, or TIMEWHEEL_UNBOUNDED. the rest is removed on later calls
+ * 
+ * @return number of entries removed
+ */
+size_t hashmap_expire(HashMap *map, Tick now, size_t budget);
+
+/**
+ * @brief remove every key+value pair
+ * 
+ * the buckets are kept, and the memory of the entries is recycled by the next insertions
+ * 
+ * @param[in,out] map hashmap
+ */
+void hashmap_clear(HashMap *map);
+
 /**
  * @brief free all the memory
  * 
+ * this disables TTLs too
+ * 
  * @param[in,out] map hashmap
  */
 void hashmap_free(HashMap *map);
@@ -287,6 +401,21 @@ INLINE static size_t hashmap_len(const HashMap *hmap)
    return hmap->n_items;
 }
 
+/**
+ * @brief compute statistics about the distribution of the items
+ * 
+ * this walks every bucket, so it's O(n)
+ * 
+ * @param[in] map hashmap
+ * @param[out] stats statistics
+ */
+void hashmap_stats(const HashMap *map, HashStats *stats);
+
+/**
+ * @brief the hash function used when none is provided (Perl's one)
+ */
+Hash hashmap_default_hash_fn(const void *key, size_t size);
+
 /**
  * @brief initialize iterator
  * 
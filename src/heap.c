@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "heap.h"
+
+/*
+ * the elements are moved with a hole: the one being placed waits in the spare slot past the
+ * end of the Vec, and the ones it passes are moved into the hole, a single copy each
+ */
+
+// MARK: helpers
+
+INLINE static char *slot(const Heap *h, size_t pos)
+{
+   return (char *)h->vec.ptr + pos * h->vec.size;
+}
+
+/**
+ * @brief the element being placed, always past the last one
+ */
+INLINE static char *spare(const Heap *h)
+{
+   return slot(h, h->vec.len);
+}
+
+INLINE static size_t *ids(const Heap *h)
+{
+   return h->ids.ptr;
+}
+
+INLINE static size_t *positions(const Heap *h)
+{
+   return h->pos.ptr;
+}
+
+/**
+ * @brief move the element at @p src into the hole at @p dst
+ */
+INLINE static void move_to_hole(Heap *h, size_t dst, size_t src)
+{
+   memcpy(slot(h, dst), slot(h, src), h->vec.size);
+   if (h->indexed) {
+      ids(h)[dst] = ids(h)[src];
+      positions(h)[ids(h)[dst]] = dst;
+   }
+}
+
+/**
+ * @brief put the spare element, with id @p id , in the hole at @p pos
+ */
+INLINE static void fill_hole(Heap *h, size_t pos, size_t id)
+{
+   memcpy(slot(h, pos), spare(h), h->vec.size);
+   if (h->indexed) {
+      ids(h)[pos] = id;
+      positions(h)[id] = pos;
+   }
+}
+
+INLINE static void sift_up_n(Heap *h, size_t pos, size_t id, size_t arity)
+{
+   while (pos > 0) {
+      size_t parent = (pos - 1) / arity;
+
+      if (h->cmp_fn(spare(h), slot(h, parent)) >= 0)
+         break;
+      move_to_hole(h, pos, parent);
+      pos = parent;
+   }
+   fill_hole(h, pos, id);
+}
+
+INLINE static void sift_down_n(Heap *h, size_t pos, size_t id, size_t arity)
+{
+   size_t len = h->vec.len;
+
+   for (;;) {
+      size_t child = pos * arity + 1, best = child, end, i;
+
+      if (child >= len)
+         break;
+
+      end = len - child < arity ? len : child + arity;
+      for (i = child + 1; i < end; i++) {
+         if (h->cmp_fn(slot(h, i), slot(h, best)) < 0)
+            best = i;
+      }
+      if (h->cmp_fn(slot(h, best), spare(h)) >= 0)
+         break;
+      move_to_hole(h, pos, best);
+      pos = best;
+   }
+   fill_hole(h, pos, id);
+}
+
+/**
+ * @brief move the spare element up from the hole at @p pos , to its place
+ *
+ * the arity is a constant in each branch, so the divisions are shifts
+ */
+static void sift_up(Heap *h, size_t pos, size_t id)
+{
+   if (h->arity == 4)
+      sift_up_n(h, pos, id, 4);
+   else
+      sift_up_n(h, pos, id, 2);
+}
+
+/**
+ * @brief move the spare element down from the hole at @p pos , to its place
+ */
+static void sift_down(Heap *h, size_t pos, size_t id)
+{
+   if (h->arity == 4)
+      sift_down_n(h, pos, id, 4);
+   else
+      sift_down_n(h, pos, id, 2);
+}
+
+/**
+ * @brief the spare element replaces the one at @p pos , move it whichever way it has to go
+ */
+static void sift(Heap *h, size_t pos, size_t id)
+{
+   if (pos > 0 && h->cmp_fn(spare(h), slot(h, (pos - 1) / h->arity)) < 0)
+      sift_up(h, pos, id);
+   else
+      sift_down(h, pos, id);
+}
+
+/**
+ * @brief room for one more element, and the spare slot
+ */
+static bool reserve_one(Heap *h)
+{
+   if (!vec_reserve(&h->vec, h->vec.len + 2))
+      return false;
+   return !h->indexed || vec_reserve(&h->ids, h->vec.len + 2);
+}
+
+// MARK: plain
+
+void heap_new(Heap *h, size_t size, HeapCmpFn cmp_fn, size_t arity)
+{
+   assert(arity == 2 || arity == 4);
+
+   vec_new(&h->vec, size, NULL);
+   h->cmp_fn = cmp_fn;
+   h->arity = arity;
+   h->indexed = false;
+   vec_new(&h->ids, sizeof(size_t), NULL);
+   vec_new(&h->pos, sizeof(size_t), NULL);
+}
+
+bool heap_from(Heap *h, Vec *v, HeapCmpFn cmp_fn, size_t arity)
+{
+   size_t i;
+
+   assert(!v->free_fn);
+
+   if (!vec_reserve(v, v->len + 1))
+      return false;
+
+   heap_new(h, v->size, cmp_fn, arity);
+   h->vec = *v;
+   vec_new_in(v, v->size, NULL, v->alloc);
+
+   /* sift down every parent, from the last one */
+   if (h->vec.len > 1) {
+      for (i = (h->vec.len - 2) / arity + 1; i-- > 0;) {
+         memcpy(spare(h), slot(h, i), h->vec.size);
+         sift_down(h, i, 0);
+      }
+   }
+
+   return true;
+}
+
+void heap_free(Heap *h)
+{
+   vec_free(&h->vec);
+   vec_free(&h->ids);
+   vec_free(&h->pos);
+}
+
+bool heap_push(Heap *h, const void *elem)
+{
+   assert(!h->indexed);
+
+   if (!reserve_one(h))
+      return false;
+
+   h->vec.len++;
+   memcpy(spare(h), elem, h->vec.size);
+   sift_up(h, h->vec.len - 1, 0);
+
+   return true;
+}
+
+bool heap_pop(Heap *h, void *elem)
+{
+   return heap_pop_id(h, NULL, elem);
+}
+
+// MARK: indexed
+
+void heap_new_indexed(Heap *h, size_t size, HeapCmpFn cmp_fn, size_t arity)
+{
+   heap_new(h, size, cmp_fn, arity);
+   h->indexed = true;
+}
+
+bool heap_push_id(Heap *h, size_t id, const void *elem)
+{
+   assert(h->indexed);
+
+   if (id == HEAP_NONE)
+      return false;
+
+   if (id >= h->pos.len) {
+      size_t old_len = h->pos.len;
+
+      if (!vec_insert_n(&h->pos, old_len, NULL, id + 1 - old_len))
+         return false;
+      /* all bits set is HEAP_NONE */
+      memset(positions(h) + old_len, 0xff, (id + 1 - old_len) * sizeof(size_t));
+   }
+   if (positions(h)[id] != HEAP_NONE || !reserve_one(h))
+      return false;
+
+   h->vec.len++;
+   h->ids.len++;
+   memcpy(spare(h), elem, h->vec.size);
+   sift_up(h, h->vec.len - 1, id);
+
+   return true;
+}
+
+bool heap_pop_id(Heap *h, size_t *id, void *elem)
+{
+   size_t last;
+
+   if (!h->vec.len)
+      return false;
+
+   if (elem)
+      memcpy(elem, slot(h, 0), h->vec.size);
+   if (h->indexed) {
+      if (id)
+         *id = ids(h)[0];
+      positions(h)[ids(h)[0]] = HEAP_NONE;
+   }
+
+   /* the last element becomes the spare one, and goes down from the top */
+   last = --h->vec.len;
+   if (h->indexed)
+      h->ids.len--;
+   if (last)
+      sift_down(h, 0, h->indexed ? ids(h)[last] : 0);
+
+   return true;
+}
+
+bool heap_update_id(Heap *h, size_t id, const void *elem)
+{
+   if (!heap_contains_id(h, id))
+      return false;
+
+   memcpy(spare(h), elem, h->vec.size);
+   sift(h, positions(h)[id], id);
+
+   return true;
+}
+
+bool heap_remove_id(Heap *h, size_t id, void *elem)
+{
+   size_t pos, last;
+
+   if (!heap_contains_id(h, id))
+      return false;
+
+   pos = positions(h)[id];
+   if (elem)
+      memcpy(elem, slot(h, pos), h->vec.size);
+   positions(h)[id] = HEAP_NONE;
+
+   /* the last element fills the hole, going up or down */
+   last = --h->vec.len;
+   h->ids.len--;
+   if (pos != last)
+      sift(h, pos, ids(h)[last]);
+
+   return true;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file heap.h
+ */
+#ifndef __HEAP_H__
+#define __HEAP_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+#define HEAP_NONE SIZE_MAX /**< position of the ids not in an indexed heap */
+
+typedef int (*HeapCmpFn)(const void *ptr1, const void *ptr2); /**< same as qsort's */
+
+/**
+ * @brief priority queue on a Vec: the smallest element (by @p cmp_fn ) comes out first
+ *
+ * each node has @p arity children, 2 (binary heap) or 4. a 4-ary heap is half as deep,
+ * and the 4 children of a node are next to each other (often in the same cache line), so
+ * it's usually faster for pop-heavy workloads.
+ *
+ * an indexed heap (see @p heap_new_indexed ) also tracks where each element is, by an id
+ * chosen when it's pushed, so it can be found to change its priority (decrease-key) or to
+ * remove it, in O(log n)
+ */
+typedef struct Heap {
+   Vec       vec; /**< the elements, in heap order. one spare slot is always reserved */
+   HeapCmpFn cmp_fn;
+   size_t    arity; /**< number of children of each node, 2 or 4 */
+   bool      indexed;
+   Vec       ids; /**< indexed only: id of each element, in heap order */
+   Vec       pos; /**< indexed only: position in the heap of each id, or HEAP_NONE */
+} Heap;
+
+/**
+ * @brief initialize empty heap
+ *
+ * @param[out] h Heap
+ * @param[in] size size of the elements
+ * @param[in] cmp_fn comparison function, the smallest element is on top
+ * @param[in] arity children per node, 2 or 4
+ */
+void heap_new(Heap *h, size_t size, HeapCmpFn cmp_fn, size_t arity);
+
+/**
+ * @brief initialize empty indexed heap
+ *
+ * see @p heap_new . elements are pushed with an id, and the heap keeps a map from
+ * ids to positions, as big as the biggest id, so ids should be small and dense
+ */
+void heap_new_indexed(Heap *h, size_t size, HeapCmpFn cmp_fn, size_t arity);
+
+/**
+ * @brief turn a Vec into a heap, in O(n)
+ *
+ * the heap takes the memory of @p v , which is left empty
+ *
+ * @param[out] h Heap
+ * @param[in,out] v Vec, its elements can't own memory (no @p free_fn )
+ * @param[in] cmp_fn comparison function, the smallest element is on top
+ * @param[in] arity children per node, 2 or 4
+ *
+ * @return false in case of failure (@p v is untouched)
+ */
+bool heap_from(Heap *h, Vec *v, HeapCmpFn cmp_fn, size_t arity);
+
+/**
+ * @brief free the heap
+ *
+ * @param[in,out] h Heap
+ */
+void heap_free(Heap *h);
+
+/**
+ * @brief number of elements
+ */
+INLINE static size_t heap_len(const Heap *h)
+{
+   return h->vec.len;
+}
+
+/**
+ * @brief if the heap is empty
+ */
+INLINE static bool heap_is_empty(const Heap *h)
+{
+   return h->vec.len == 0;
+}
+
+/**
+ * @brief get a reference to the smallest element
+ *
+ * WARNING: this is invalidated by any change to the heap
+ *
+ * @return pointer to the element, or NULL if empty
+ */
+INLINE static void *heap_peek(const Heap *h)
+{
+   return vec_at(&h->vec, 0);
+}
+
+/**
+ * @brief insert an element through shallow-copy, in O(log n)
+ *
+ * not for indexed heaps, see @p heap_push_id
+ *
+ * @param[in,out] h Heap
+ * @param[in] elem element to insert
+ *
+ * @return false in case of failure
+ */
+bool heap_push(Heap *h, const void *elem);
+
+/**
+ * @brief remove the smallest element, in O(log n)
+ *
+ * @param[in,out] h Heap
+ * @param[out] elem if != NULL, on exit it's set with the element removed
+ *
+ * @return false if empty
+ */
+bool heap_pop(Heap *h, void *elem);
+
+/**
+ * @brief insert an element with id @p id through shallow-copy, in O(log n)
+ *
+ * @param[in,out] h indexed Heap
+ * @param[in] id id of the element, not in the heap already
+ * @param[in] elem element to insert
+ *
+ * @return false in case of failure, or if @p id is in the heap
+ */
+bool heap_push_id(Heap *h, size_t id, const void *elem);
+
+/**
+ * @brief remove the smallest element, in O(log n)
+ *
+ * @param[in,out] h indexed Heap
+ * @param[out] id if != NULL, on exit it's set with the id of the element removed
+ * @param[out] elem if != NULL, on exit it's set with the element removed
+ *
+ * @return false if empty
+ */
+bool heap_pop_id(Heap *h, size_t *id, void *elem);
+
+/**
+ * @brief if the element with id @p id is in the heap
+ */
+INLINE static bool heap_contains_id(const Heap *h, size_t id)
+{
+   return id < h->pos.len && ((const size_t *)h->pos.ptr)[id] != HEAP_NONE;
+}
+
+/**
+ * @brief get a reference to the element with id @p id
+ *
+ * WARNING: this is invalidated by any change to the heap. use @p heap_update_id to change it
+ *
+ * @return pointer to the element, or NULL if not in the heap
+ */
+INLINE static void *heap_at_id(const Heap *h, size_t id)
+{
+   if (!heap_contains_id(h, id))
+      return NULL;
+   return vec_at(&h->vec, ((const size_t *)h->pos.ptr)[id]);
+}
+
+/**
+ * @brief replace the element with id @p id , moving it up or down, in O(log n)
+ *
+ * decrease-key when the new element is smaller, but bigger works too
+ *
+ * @param[in,out] h indexed Heap
+ * @param[in] id id of the element
+ * @param[in] elem new element
+ *
+ * @return false if @p id is not in the heap
+ */
+bool heap_update_id(Heap *h, size_t id, const void *elem);
+
+/**
+ * @brief remove the element with id @p id , in O(log n)
+ *
+ * @param[in,out] h indexed Heap
+ * @param[in] id id of the element
+ * @param[out] elem if != NULL, on exit it's set with the element removed
+ *
+ * @return false if @p id is not in the heap
+ */
+bool heap_remove_id(Heap *h, size_t id, void *elem);
+
+#endif /* __HEAP_H__ */
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "ihashmap.h"
+#include "hash_internal.h"
+
+INLINE static size_t ihashmap_key_size(const IHashMap *map, const void *key)
+{
+   return map->key_size == HASHMAP_LEN_STR ? strlen((char *)key) + 1 : map->key_size;
+}
+
+/**
+ * @brief link @p node at the head of @p bucket
+ */
+INLINE static void ihashnode_link(IHashNode *node, IHashNode **bucket)
+{
+   node->next = *bucket;
+   if (node->next)
+      node->next->pprev = &node->next;
+   node->pprev = bucket;
+   *bucket = node;
+}
+
+static IHashNode *
+ihashmap_find_hashed(const IHashMap *map, const void *key, size_t key_size, Hash hash)
+{
+   IHashNode *node;
+
+   if (!map->n_buckets)
+      return NULL;
+
+   for (node = map->buckets[bucket_idx(hash, map->n_buckets)]; node; node = node->next) {
+      if (node->hash == hash && !map->cmp_fn(map->key_fn(node), key, key_size))
+         return node;
+   }
+
+   return NULL;
+}
+
+/**
+ * @brief move every node to a new array of @p n_buckets buckets
+ */
+static void ihashmap_resize(IHashMap *map, Hash n_buckets)
+{
+   IHashNode **buckets = (IHashNode **)calloc((size_t)n_buckets, sizeof(IHashNode *));
+
+   while (map->n_buckets--) {
+      IHashNode *node = map->buckets[map->n_buckets];
+
+      while (node) {
+         IHashNode *next = node->next;
+         ihashnode_link(node, &buckets[bucket_idx(node->hash, n_buckets)]);
+         node = next;
+      }
+   }
+
+   free(map->buckets);
+   map->buckets = buckets;
+   map->n_buckets = n_buckets;
+}
+
+void ihashmap_new(IHashMap *map, size_t key_size, IHashKeyFn key_fn, HashFn hash_fn, CmpFn cmp_fn)
+{
+   memset(map, 0, sizeof(*map));
+   map->key_size = key_size;
+   map->key_fn = key_fn;
+   map->hash_fn = hash_fn ? hash_fn : hashmap_default_hash_fn;
+   map->cmp_fn = cmp_fn ? cmp_fn : memcmp;
+}
+
+IHashNode *ihashmap_insert(IHashMap *map, IHashNode *node)
+{
+   const void *key = map->key_fn(node);
+   size_t      key_size = ihashmap_key_size(map, key);
+   Hash        hash = map->hash_fn(key, key_size);
+   IHashNode  *found = ihashmap_find_hashed(map, key, key_size, hash);
+
+   if (found)
+      return found;
+
+   if (!map->n_buckets) {
+      map->n_buckets = START_BUCKETS;
+      map->buckets = calloc(map->n_buckets, sizeof(IHashNode *));
+   }
+
+   node->hash = hash;
+   ihashnode_link(node, &map->buckets[bucket_idx(hash, map->n_buckets)]);
+   map->n_items++;
+   ihashmap_rehash(map);
+
+   return NULL;
+}
+
+IHashNode *ihashmap_find(const IHashMap *map, const void *key)
+{
+   size_t key_size = ihashmap_key_size(map, key);
+   return ihashmap_find_hashed(map, key, key_size, map->hash_fn(key, key_size));
+}
+
+void ihashmap_remove(IHashMap *map, IHashNode *node)
+{
+   *node->pprev = node->next;
+   if (node->next)
+      node->next->pprev = node->pprev;
+   node->next = NULL;
+   node->pprev = NULL;
+   map->n_items--;
+}
+
+bool ihashmap_rehash(IHashMap *map)
+{
+   Hash  n_buckets;
+   float load;
+
+   if (!map->n_buckets)
+      return false;
+
+   load = (float)map->n_items / (float)map->n_buckets;
+   if (load >= MIN_LOAD && load <= MAX_LOAD)
+      return false;
+
+   n_buckets = (Hash)((float)(map->n_items * 2) / (MIN_LOAD + MAX_LOAD));
+   ihashmap_resize(map, roundup_pow2(n_buckets));
+
+   return true;
+}
+
+void ihashmap_stats(const IHashMap *map, HashStats *stats)
+{
+   Hash idx;
+
+   memset(stats, 0, sizeof(*stats));
+   stats->n_items = map->n_items;
+   stats->n_buckets = map->n_buckets;
+   if (map->n_buckets)
+      stats->load = (float)map->n_items / (float)map->n_buckets;
+
+   for (idx = 0; idx < map->n_buckets; idx++) {
+      const IHashNode *node;
+      size_t           len = 0;
+
+      for (node = map->buckets[idx]; node; node = node->next) {
+         len++;
+      }
+      if (len)
+         stats->n_used++;
+      if (len > stats->max_chain)
+         stats->max_chain = len;
+   }
+}
+
+void ihashmap_free(IHashMap *map)
+{
+   free(map->buckets);
+   map->buckets = NULL;
+   map->n_buckets = 0;
+   map->n_items = 0;
+}
+
+IHashNode *ihashiter_next(IHashIter *iter)
+{
+   const IHashMap *map = iter->map;
+
+   if (iter->next) {
+      iter->node = iter->next;
+      iter->next = iter->node->next;
+      return iter->node;
+   }
+
+   while (++iter->idx < map->n_buckets) {
+      if (map->buckets[iter->idx]) {
+         iter->node = map->buckets[iter->idx];
+         iter->next = iter->node->next;
+         return iter->node;
+      }
+   }
+
+   iter->node = NULL;
+   return NULL;
+}
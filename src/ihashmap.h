@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file ihashmap.h
+ */
+#ifndef __IHASHMAP_H__
+#define __IHASHMAP_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hashmap.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief node to be embedded in user structs, just like @p LNode
+ *
+ * hlist-style: @p pprev points to whatever points to this node (the bucket or the previous node),
+ * so a node can be removed in O(1) while the buckets are a single pointer
+ */
+typedef struct IHashNode {
+   struct IHashNode  *next;
+   struct IHashNode **pprev;
+   Hash               hash; /**< key's hash, computed on insertion */
+} IHashNode;
+
+/**
+ * @brief returns a pointer to the key of the struct that contains @p node
+ */
+typedef const void *(*IHashKeyFn)(const IHashNode *node);
+
+/**
+ * @brief intrusive hashmap
+ *
+ * like @p LList, you put a @p IHashNode inside the struct definition of the type you want to use it with,
+ * so inserting an object never allocates or copies anything: the map only owns the array of buckets.
+ * the key lives in the object too, and the map finds it through a user-supplied @p IHashKeyFn
+ *
+ * sizing follows the same policy of @p HashMap: buckets grow automatically on insert,
+ * but not on removal (see @p ihashmap_rehash).
+ *
+ * @note the implementation assumes malloc never fails
+ */
+typedef struct IHashMap {
+   IHashNode **buckets; /**< array of buckets */
+   Hash        n_buckets; /**< number of buckets */
+   size_t      n_items; /**< item count */
+   size_t      key_size; /**< size of the keys if its constant, or HASHMAP_LEN_STR */
+   IHashKeyFn  key_fn; /**< key extraction */
+   HashFn      hash_fn; /**< hash function in use */
+   CmpFn       cmp_fn; /**< compare function in use */
+} IHashMap;
+
+/**
+ * @brief sequential iterator over every node
+ *
+ * the current node can be removed while iterating, other modifications can invalidate this
+ */
+typedef struct IHashIter {
+   const IHashMap *map;
+   IHashNode      *node; /**< current node */
+   IHashNode      *next; /**< node after the current one in its bucket */
+   Hash            idx; /**< current bucket index */
+} IHashIter;
+
+/**
+ * @brief initialize hashmap
+ *
+ * @param[out] map hashmap
+ * @param[in] key_size size of the keys. if they are variable length c-strings, pass HASHMAP_LEN_STR
+ * @param[in] key_fn key extraction function
+ * @param[in] hash_fn if != NULL, custom hash function
+ * @param[in] cmp_fn if != NULL, custom compare function
+ */
+void ihashmap_new(IHashMap *map, size_t key_size, IHashKeyFn key_fn, HashFn hash_fn, CmpFn cmp_fn);
+
+/**
+ * @brief insert @p node, unless its key is already present
+ *
+ * @param[in,out] map hashmap
+ * @param[in,out] node node to insert, with its key already set
+ *
+ * @return the node already present with the same key (in which case @p node is not inserted), or NULL
+ */
+IHashNode *ihashmap_insert(IHashMap *map, IHashNode *node);
+
+/**
+ * @brief find the node corresponding to @p key
+ *
+ * @param[in] map hashmap
+ * @param[in] key key to find
+ *
+ * @return node, or NULL
+ */
+IHashNode *ihashmap_find(const IHashMap *map, const void *key);
+
+/**
+ * @brief remove @p node from the hashmap, in O(1)
+ *
+ * @param[in,out] map hashmap
+ * @param[in,out] node node that belongs to @p map
+ */
+void ihashmap_remove(IHashMap *map, IHashNode *node);
+
+/**
+ * @brief manually request a rehash
+ *
+ * see @p hashmap_rehash
+ *
+ * @param[in,out] map hashmap
+ *
+ * @return if the rehash happened
+ */
+bool ihashmap_rehash(IHashMap *map);
+
+/**
+ * @brief compute statistics about the distribution of the nodes
+ *
+ * see @p hashmap_stats
+ *
+ * @param[in] map hashmap
+ * @param[out] stats statistics
+ */
+void ihashmap_stats(const IHashMap *map, HashStats *stats);
+
+/**
+ * @brief free the buckets
+ *
+ * the nodes are owned by the user, they are just forgotten
+ *
+ * @param[in,out] map hashmap
+ */
+void ihashmap_free(IHashMap *map);
+
+/**
+ * @brief number of nodes in the hashmap
+ */
+INLINE static size_t ihashmap_len(const IHashMap *map)
+{
+   return map->n_items;
+}
+
+/**
+ * @brief the corresponding data of the node
+ *
+ * see @p llist_entry
+ */
+#define ihashmap_entry(node, etype, MEMBER) container_of(node, etype, MEMBER)
+
+/**
+ * @brief initialize iterator
+ *
+ * @param[out] iter
+ * @param[in] map
+ */
+INLINE static void ihashiter_init(IHashIter *iter, const IHashMap *map)
+{
+   iter->map = map;
+   iter->node = iter->next = NULL;
+   iter->idx = (Hash)-1;
+}
+
+/**
+ * @brief step on next node of the hashmap
+ *
+ * @param[in,out] iter iterator
+ *
+ * @return the node, or NULL if the iterator is exhausted
+ */
+IHashNode *ihashiter_next(IHashIter *iter);
+
+#endif /* __IHASHMAP_H__ */
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "packvec.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #define PACKVEC_SSE2
+   #include <emmintrin.h>
+#endif
+
+#define LANES      4 /**< 32-bit lanes the narrow blocks are interleaved in */
+#define LANE_VALS  (PACKVEC_BLOCK / LANES) /**< values per lane */
+#define NARROW_MAX 32 /**< widest block packed in lanes */
+
+/*
+ * a block of width w is 4 * w 32-bit words, in both layouts:
+ * - narrow (w <= 32): value j is the (j / 4)-th value of lane j % 4. each lane is a bitstream
+ *   of w words, and word k of lane l is at 4 * k + l, so 4 consecutive values are unpacked
+ *   together with the same shifts
+ * - wide: value j is at bit j * w of a bitstream of 2 * w 64-bit words
+ */
+
+// MARK: helpers
+
+/**
+ * @brief bits needed to store @p x
+ */
+INLINE static unsigned bit_width(uint64_t x)
+{
+   unsigned w = 0;
+
+   for (; x; x >>= 1)
+      w++;
+
+   return w;
+}
+
+INLINE static const uint32_t *block_words(const PackVec *pv, const PackBlock *blk)
+{
+   return (const uint32_t *)pv->data.ptr + blk->offset;
+}
+
+/**
+ * @brief turn the values of a block into what gets packed, in place
+ *
+ * @return base of the block
+ */
+static uint64_t reduce(PackVecMode mode, uint64_t *vals)
+{
+   uint64_t base = vals[0], prev = vals[0];
+   size_t   j;
+
+   if (mode == PACKVEC_DELTA) {
+      for (j = 0; j < PACKVEC_BLOCK; j++) {
+         uint64_t cur = vals[j];
+
+         vals[j] = cur - prev;
+         prev = cur;
+      }
+      return base;
+   }
+
+   for (j = 1; j < PACKVEC_BLOCK; j++) {
+      if (vals[j] < base)
+         base = vals[j];
+   }
+   for (j = 0; j < PACKVEC_BLOCK; j++)
+      vals[j] -= base;
+
+   return base;
+}
+
+/**
+ * @brief turn the unpacked values of a block back into the original ones
+ */
+INLINE static void restore(PackVecMode mode, uint64_t base, const uint64_t *in, uint64_t *out,
+                           size_t beg, size_t end)
+{
+   size_t j;
+
+   if (mode == PACKVEC_DELTA) {
+      for (j = 0; j < beg; j++)
+         base += in[j];
+      for (j = beg; j < end; j++) {
+         base += in[j];
+         out[j - beg] = base;
+      }
+   }
+   else {
+      for (j = beg; j < end; j++)
+         out[j - beg] = base + in[j];
+   }
+}
+
+// MARK: packing
+
+static void pack_narrow(const uint64_t *vals, unsigned width, uint32_t *words)
+{
+   size_t i, l;
+
+   memset(words, 0, LANES * width * sizeof(uint32_t));
+
+   for (l = 0; l < LANES; l++) {
+      for (i = 0; i < LANE_VALS; i++) {
+         uint32_t val = (uint32_t)vals[i * LANES + l];
+         size_t   bit = i * width, k = bit / 32, shift = bit % 32;
+
+         words[k * LANES + l] |= val << shift;
+         if (shift + width > 32)
+            words[(k + 1) * LANES + l] |= val >> (32 - shift);
+      }
+   }
+}
+
+static void pack_wide(const uint64_t *vals, unsigned width, uint32_t *words)
+{
+   uint64_t stream[2 * 64];
+   size_t   j;
+
+   memset(stream, 0, 2 * width * sizeof(uint64_t));
+
+   for (j = 0; j < PACKVEC_BLOCK; j++) {
+      size_t bit = j * width, k = bit / 64, shift = bit % 64;
+
+      stream[k] |= vals[j] << shift;
+      if (shift + width > 64)
+         stream[k + 1] |= vals[j] >> (64 - shift);
+   }
+
+   memcpy(words, stream, 2 * width * sizeof(uint64_t));
+}
+
+/**
+ * @brief pack the tail into a new block
+ */
+static bool pack_tail(PackVec *pv)
+{
+   PackBlock blk;
+   uint64_t  vals[PACKVEC_BLOCK], max = 0;
+   size_t    j;
+
+   memcpy(vals, pv->tail, sizeof(vals));
+   blk.base = reduce(pv->mode, vals);
+   for (j = 0; j < PACKVEC_BLOCK; j++)
+      max |= vals[j];
+   blk.width = bit_width(max);
+   blk.offset = pv->data.len;
+
+   if (!vec_reserve(&pv->blocks, pv->blocks.len + 1) ||
+       !vec_reserve(&pv->data, pv->data.len + LANES * blk.width))
+      return false;
+
+   /* all the same (FOR) or no gaps (DELTA), nothing to store */
+   if (!blk.width)
+      ;
+   else if (blk.width <= NARROW_MAX)
+      pack_narrow(vals, blk.width, (uint32_t *)pv->data.ptr + blk.offset);
+   else
+      pack_wide(vals, blk.width, (uint32_t *)pv->data.ptr + blk.offset);
+
+   pv->data.len += LANES * blk.width;
+   vec_push(&pv->blocks, &blk);
+
+   return true;
+}
+
+// MARK: unpacking
+
+#ifdef PACKVEC_SSE2
+
+/**
+ * @brief unpack the first @p n values (rounded up to 4), the 4 lanes at once
+ */
+static void unpack_narrow(const uint32_t *words, unsigned width, uint64_t *out, size_t n)
+{
+   const __m128i *in = (const __m128i *)words;
+   const __m128i  mask = _mm_set1_epi32(width == 32 ? -1 : (int)((1u << width) - 1));
+   __m128i        cur;
+   unsigned       i, k = 0, shift = 0;
+
+   if (!width) {
+      memset(out, 0, PACKVEC_BLOCK * sizeof(uint64_t));
+      return;
+   }
+
+   cur = _mm_loadu_si128(in);
+   for (i = 0; i < (n + LANES - 1) / LANES; i++) {
+      __m128i v = _mm_srl_epi32(cur, _mm_cvtsi32_si128((int)shift));
+
+      shift += width;
+      if (shift >= 32) {
+         shift -= 32;
+         if (++k < width) {
+            cur = _mm_loadu_si128(in + k);
+            if (shift)
+               v = _mm_or_si128(v, _mm_sll_epi32(cur, _mm_cvtsi32_si128((int)(width - shift))));
+         }
+      }
+
+      /* widen the 4 values to 64 bits */
+      v = _mm_and_si128(v, mask);
+      _mm_storeu_si128((__m128i *)(out + i * LANES), _mm_unpacklo_epi32(v, _mm_setzero_si128()));
+      _mm_storeu_si128((__m128i *)(out + i * LANES + 2),
+                       _mm_unpackhi_epi32(v, _mm_setzero_si128()));
+   }
+}
+
+#else
+
+/**
+ * @brief unpack the first @p n values (rounded up to 4)
+ */
+static void unpack_narrow(const uint32_t *words, unsigned width, uint64_t *out, size_t n)
+{
+   uint32_t mask = width == 32 ? UINT32_MAX : (1u << width) - 1;
+   size_t   i, l;
+
+   for (l = 0; l < LANES; l++) {
+      for (i = 0; i < (n + LANES - 1) / LANES; i++) {
+         size_t   bit = i * width, k = bit / 32, shift = bit % 32;
+         uint32_t val = width ? words[k * LANES + l] >> shift : 0;
+
+         if (shift + width > 32)
+            val |= words[(k + 1) * LANES + l] << (32 - shift);
+         out[i * LANES + l] = val & mask;
+      }
+   }
+}
+
+#endif
+
+/**
+ * @brief unpack the first @p n values
+ */
+static void unpack_wide(const uint32_t *words, unsigned width, uint64_t *out, size_t n)
+{
+   uint64_t stream[2 * 64];
+   uint64_t mask = width == 64 ? UINT64_MAX : ((uint64_t)1 << width) - 1;
+   size_t   j;
+
+   memcpy(stream, words, (n * width + 63) / 64 * sizeof(uint64_t));
+
+   for (j = 0; j < n; j++) {
+      size_t   bit = j * width, k = bit / 64, shift = bit % 64;
+      uint64_t val = stream[k] >> shift;
+
+      if (shift + width > 64)
+         val |= stream[k + 1] << (64 - shift);
+      out[j] = val & mask;
+   }
+}
+
+/**
+ * @brief decode the values [ @p beg , @p end ) of block @p b
+ *
+ * only the values up to @p end are unpacked, DELTA needs the ones before @p beg too
+ */
+static void decode_block(const PackVec *pv, size_t b, size_t beg, size_t end, uint64_t *out)
+{
+   const PackBlock *blk = (const PackBlock *)pv->blocks.ptr + b;
+   uint64_t         vals[PACKVEC_BLOCK];
+
+   if (blk->width <= NARROW_MAX)
+      unpack_narrow(block_words(pv, blk), blk->width, vals, end);
+   else
+      unpack_wide(block_words(pv, blk), blk->width, vals, end);
+
+   restore(pv->mode, blk->base, vals, out, beg, end);
+}
+
+// MARK: API
+
+void packvec_new(PackVec *pv, PackVecMode mode)
+{
+   vec_new(&pv->blocks, sizeof(PackBlock), NULL);
+   vec_new(&pv->data, sizeof(uint32_t), NULL);
+   pv->len = 0;
+   pv->mode = mode;
+}
+
+void packvec_free(PackVec *pv)
+{
+   vec_free(&pv->blocks);
+   vec_free(&pv->data);
+   pv->len = 0;
+}
+
+bool packvec_push(PackVec *pv, uint64_t val)
+{
+   pv->tail[pv->len % PACKVEC_BLOCK] = val;
+   if (pv->len % PACKVEC_BLOCK == PACKVEC_BLOCK - 1 && !pack_tail(pv))
+      return false;
+   pv->len++;
+
+   return true;
+}
+
+bool packvec_push_n(PackVec *pv, const uint64_t *vals, size_t n)
+{
+   while (n) {
+      size_t used = pv->len % PACKVEC_BLOCK, cnt = PACKVEC_BLOCK - used;
+
+      if (cnt > n)
+         cnt = n;
+      memcpy(pv->tail + used, vals, cnt * sizeof(uint64_t));
+      if (used + cnt == PACKVEC_BLOCK && !pack_tail(pv))
+         return false;
+
+      pv->len += cnt;
+      vals += cnt;
+      n -= cnt;
+   }
+
+   return true;
+}
+
+uint64_t packvec_get(const PackVec *pv, size_t pos)
+{
+   const PackBlock *blk;
+   size_t           b = pos / PACKVEC_BLOCK, j = pos % PACKVEC_BLOCK;
+   const uint32_t  *words;
+   uint64_t         val;
+
+   assert(pos < pv->len);
+
+   if (b == pv->blocks.len)
+      return pv->tail[j];
+
+   blk = (const PackBlock *)pv->blocks.ptr + b;
+   if (pv->mode == PACKVEC_DELTA) {
+      decode_block(pv, b, j, j + 1, &val);
+      return val;
+   }
+
+   /* only the value asked for */
+   words = block_words(pv, blk);
+   if (!blk->width)
+      val = 0;
+   else if (blk->width <= NARROW_MAX) {
+      size_t bit = (j / LANES) * blk->width, k = bit / 32, shift = bit % 32, l = j % LANES;
+
+      val = words[k * LANES + l] >> shift;
+      if (shift + blk->width > 32)
+         val |= (uint64_t)words[(k + 1) * LANES + l] << (32 - shift);
+      val &= ((uint64_t)1 << blk->width) - 1;
+   }
+   else {
+      uint64_t lo, hi = 0, mask = blk->width == 64 ? UINT64_MAX : ((uint64_t)1 << blk->width) - 1;
+      size_t   bit = j * blk->width, k = bit / 64, shift = bit % 64;
+
+      memcpy(&lo, words + 2 * k, sizeof(lo));
+      if (shift + blk->width > 64)
+         memcpy(&hi, words + 2 * (k + 1), sizeof(hi));
+      val = ((lo >> shift) | (shift ? hi << (64 - shift) : 0)) & mask;
+   }
+
+   return blk->base + val;
+}
+
+size_t packvec_decode(const PackVec *pv, size_t pos, uint64_t *out, size_t n)
+{
+   size_t done = 0;
+
+   if (pos >= pv->len)
+      return 0;
+   if (n > pv->len - pos)
+      n = pv->len - pos;
+
+   while (done < n) {
+      size_t b = (pos + done) / PACKVEC_BLOCK, beg = (pos + done) % PACKVEC_BLOCK;
+      size_t end = beg + (n - done) < PACKVEC_BLOCK ? beg + (n - done) : PACKVEC_BLOCK;
+
+      if (b == pv->blocks.len)
+         memcpy(out + done, pv->tail + beg, (end - beg) * sizeof(uint64_t));
+      else
+         decode_block(pv, b, beg, end, out + done);
+      done += end - beg;
+   }
+
+   return n;
+}
+
+size_t packvec_bytes(const PackVec *pv)
+{
+   return pv->data.len * sizeof(uint32_t) + pv->blocks.len * sizeof(PackBlock);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "segvec.h"
+
+void segvec_new(SegVec *sv, size_t size, FreeFn free_fn)
+{
+   size_t i;
+
+   for (i = 0; i < SEGVEC_MAX_SEGS; i++)
+      sv->segs[i] = NULL;
+   sv->n_segs = 0;
+   sv->len = sv->cap = 0;
+   sv->size = size;
+   sv->free_fn = free_fn;
+   sv->alloc = NULL;
+}
+
+void segvec_new_in(SegVec *sv, size_t size, FreeFn free_fn, const Allocator *alloc)
+{
+   segvec_new(sv, size, free_fn);
+   sv->alloc = alloc;
+}
+
+void segvec_free(SegVec *sv)
+{
+   size_t i;
+
+   segvec_truncate(sv, 0);
+
+   for (i = 0; i < sv->n_segs; i++) {
+      allocator_free(sv->alloc, sv->segs[i], segvec_seg_len(i) * sv->size);
+      sv->segs[i] = NULL;
+   }
+   sv->n_segs = 0;
+   sv->cap = 0;
+}
+
+bool segvec_reserve(SegVec *sv, size_t nelem)
+{
+   while (sv->cap < nelem) {
+      size_t seg_len = segvec_seg_len(sv->n_segs);
+      void  *seg;
+
+      if (sv->n_segs == SEGVEC_MAX_SEGS || seg_len > SIZE_MAX / sv->size)
+         return false;
+
+      seg = allocator_realloc(sv->alloc, NULL, 0, seg_len * sv->size);
+      if (!seg)
+         return false;
+
+      sv->segs[sv->n_segs++] = seg;
+      sv->cap += seg_len;
+   }
+
+   return true;
+}
+
+void *segvec_seg(const SegVec *sv, size_t seg, size_t *len)
+{
+   size_t beg, seg_len;
+
+   if (seg >= sv->n_segs)
+      return NULL;
+
+   /* the segments before hold BASE * (2^seg - 1) elements */
+   seg_len = segvec_seg_len(seg);
+   beg = seg_len - SEGVEC_BASE;
+   if (beg >= sv->len)
+      return NULL;
+
+   *len = sv->len - beg < seg_len ? sv->len - beg : seg_len;
+   return sv->segs[seg];
+}
+
+bool segvec_push_n(SegVec *sv, const void *elems, size_t nelem)
+{
+   const char *src = elems;
+   size_t      pos;
+
+   if (nelem > SIZE_MAX - sv->len || !segvec_reserve(sv, sv->len + nelem))
+      return false;
+
+   /* a run of slots in each segment touched */
+   for (pos = sv->len; nelem;) {
+      size_t offset, seg = segvec_locate(pos, &offset);
+      size_t n = segvec_seg_len(seg) - offset;
+      char  *dst = (char *)sv->segs[seg] + offset * sv->size;
+
+      if (n > nelem)
+         n = nelem;
+
+      if (src) {
+         memcpy(dst, src, n * sv->size);
+         src += n * sv->size;
+      }
+      else
+         memset(dst, 0, n * sv->size);
+
+      pos += n;
+      nelem -= n;
+   }
+   sv->len = pos;
+
+   return true;
+}
+
+void *segvec_push(SegVec *sv, const void *elem)
+{
+   size_t offset, seg;
+   char  *dst;
+
+   if (sv->len == sv->cap && !segvec_reserve(sv, sv->len + 1))
+      return NULL;
+
+   seg = segvec_locate(sv->len, &offset);
+   dst = (char *)sv->segs[seg] + offset * sv->size;
+   if (elem)
+      memcpy(dst, elem, sv->size);
+   else
+      memset(dst, 0, sv->size);
+   sv->len++;
+
+   return dst;
+}
+
+bool segvec_pop(SegVec *sv, void *elem)
+{
+   void *last;
+
+   if (!sv->len)
+      return false;
+
+   last = segvec_at(sv, sv->len - 1);
+   if (elem)
+      memcpy(elem, last, sv->size);
+   else if (sv->free_fn)
+      sv->free_fn(last);
+   sv->len--;
+
+   return true;
+}
+
+void segvec_truncate(SegVec *sv, size_t new_len)
+{
+   if (new_len < sv->len) {
+      if (sv->free_fn) {
+         size_t i;
+         for (i = new_len; i < sv->len; i++) {
+            sv->free_fn(segvec_at(sv, i));
+         }
+      }
+      sv->len = new_len;
+   }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file segvec.h
+ */
+#ifndef __SEGVEC_H__
+#define __SEGVEC_H__
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "allocator.h"
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+#define SEGVEC_BASE_BITS 4
+#define SEGVEC_BASE      ((size_t)1 << SEGVEC_BASE_BITS) /**< elements of the first segment */
+#define SEGVEC_MAX_SEGS  (sizeof(size_t) * CHAR_BIT - SEGVEC_BASE_BITS)
+
+/**
+ * @brief dynamic array whose elements never move
+ *
+ * the elements are stored in segments of geometrically increasing size: the first one holds
+ * SEGVEC_BASE elements, and each one after twice the previous one. growing allocates a new
+ * segment and never copies, so pointers to elements stay valid until they are removed.
+ * indexing is still O(1), the segment is found from the highest set bit of the position.
+ * good for append-only logs and node storage
+ */
+typedef struct SegVec {
+   void            *segs[SEGVEC_MAX_SEGS]; /**< segments, the ones past @p n_segs are NULL */
+   size_t           n_segs; /**< number of segments allocated */
+   size_t           len; /**< number of elements */
+   size_t           cap; /**< number of elements the segments allocated can hold */
+   size_t           size; /**< size of the data type to be held */
+   FreeFn           free_fn; /**< if != NULL, free function for elements */
+   const Allocator *alloc; /**< source of the memory of the segments, NULL for malloc */
+} SegVec;
+
+/**
+ * @brief floor(log2( @p n )), @p n != 0
+ */
+INLINE static unsigned segvec_log2(size_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return (unsigned)(sizeof(unsigned long long) * CHAR_BIT - 1) -
+          (unsigned)__builtin_clzll((unsigned long long)n);
+#else
+   unsigned log = 0;
+
+   for (; n > 1; n >>= 1)
+      log++;
+
+   return log;
+#endif
+}
+
+/**
+ * @brief number of elements of segment @p seg
+ */
+INLINE static size_t segvec_seg_len(size_t seg)
+{
+   return SEGVEC_BASE << seg;
+}
+
+/**
+ * @brief segment that holds position @p pos , and the offset of @p pos in it
+ */
+INLINE static size_t segvec_locate(size_t pos, size_t *offset)
+{
+   /* segment k holds the positions for which pos + BASE is in [BASE << k, BASE << (k + 1)) */
+   size_t   biased = pos + SEGVEC_BASE;
+   unsigned seg = segvec_log2(biased) - SEGVEC_BASE_BITS;
+
+   *offset = biased - segvec_seg_len(seg);
+   return seg;
+}
+
+/**
+ * @brief initialize empty struct
+ *
+ * @param[out] sv SegVec
+ * @param[in] size size of the single elements it's going to contain
+ * @param[in] free_fn free function for elements, or NULL
+ */
+void segvec_new(SegVec *sv, size_t size, FreeFn free_fn);
+
+/**
+ * @brief initialize empty struct, taking the memory from @p alloc
+ *
+ * see @p segvec_new
+ *
+ * @param[in] alloc allocator, or NULL for malloc
+ */
+void segvec_new_in(SegVec *sv, size_t size, FreeFn free_fn, const Allocator *alloc);
+
+/**
+ * @brief free the elements (through @p free_fn ) and all the segments
+ *
+ * @param[in,out] sv SegVec
+ */
+void segvec_free(SegVec *sv);
+
+/**
+ * @brief allocate segments until there's space for at least @p nelem elements
+ *
+ * never moves the elements already there
+ *
+ * @param[in,out] sv SegVec
+ * @param[in] nelem number of elements
+ *
+ * @return false in case of failure
+ */
+bool segvec_reserve(SegVec *sv, size_t nelem);
+
+/**
+ * @brief number of elements
+ */
+INLINE static size_t segvec_len(const SegVec *sv)
+{
+   return sv->len;
+}
+
+/**
+ * @brief get a reference to the element at @p pos
+ *
+ * the pointer stays valid until the element is removed
+ *
+ * @param[in] sv SegVec
+ * @param[in] pos index of the element
+ *
+ * @return pointer to element, or NULL
+ */
+INLINE static void *segvec_at(const SegVec *sv, size_t pos)
+{
+   size_t offset, seg;
+
+   if (pos >= sv->len)
+      return NULL;
+
+   seg = segvec_locate(pos, &offset);
+   return (char *)sv->segs[seg] + offset * sv->size;
+}
+
+/**
+ * @brief the elements of segment @p seg , a contiguous slice, for bulk scans
+ *
+ *    for (seg = 0; (ptr = segvec_seg(&sv, seg, &len)); seg++)
+ *       ...
+ *
+ * @param[in] sv SegVec
+ * @param[in] seg index of the segment
+ * @param[out] len number of elements in the slice
+ *
+ * @return start of the slice, or NULL if the segment holds no elements
+ */
+void *segvec_seg(const SegVec *sv, size_t seg, size_t *len);
+
+/**
+ * @brief bulk append of elements through shallow-copy
+ *
+ * @param[in,out] sv SegVec
+ * @param[in] elems array of elements. if NULL, the new elements are zeroed
+ * @param[in] nelem number of elements of the array
+ *
+ * @return false in case of failure
+ */
+bool segvec_push_n(SegVec *sv, const void *elems, size_t nelem);
+
+/**
+ * @brief append element through shallow-copy
+ *
+ * @param[in,out] sv SegVec
+ * @param[in] elem element to insert, or NULL to zero it
+ *
+ * @return pointer to the inserted element, or NULL in case of failure
+ */
+void *segvec_push(SegVec *sv, const void *elem);
+
+/**
+ * @brief remove the last element
+ *
+ * if the element owns memory, that will be freed automatically through @p free_fn
+ * or through @p elem if it's not NULL. the segments are kept
+ *
+ * @param[in,out] sv SegVec
+ * @param[out] elem if != NULL, on exit it's set with the element removed
+ *
+ * @return false if empty
+ */
+bool segvec_pop(SegVec *sv, void *elem);
+
+/**
+ * @brief remove the elements after @p new_len , freeing them through @p free_fn
+ *
+ * the segments are kept
+ *
+ * @param[in,out] sv SegVec
+ * @param[in] new_len new number of elements
+ */
+void segvec_truncate(SegVec *sv, size_t new_len);
+
+#endif /* __SEGVEC_H__ */
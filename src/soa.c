@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "soa.h"
+
+#define CACHE_LINE    64
+#define GROWTH_FACTOR 2
+
+/**
+ * @brief bytes of a column of @p nrows fields of @p size , padded to a cache line
+ */
+INLINE static size_t col_bytes(size_t size, size_t nrows)
+{
+   return (size * nrows + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+bool soa_new_in(Soa *s, const size_t *sizes, size_t n_cols, const Allocator *alloc)
+{
+   size_t i;
+
+   assert(n_cols > 0);
+
+   /* sizes and column pointers, in one chunk */
+   s->cols = allocator_realloc(alloc, NULL, 0, n_cols * (sizeof(void *) + sizeof(size_t)));
+   if (!s->cols)
+      return false;
+   s->sizes = (size_t *)(s->cols + n_cols);
+
+   for (i = 0; i < n_cols; i++) {
+      assert(sizes[i] > 0);
+      s->cols[i] = NULL;
+      s->sizes[i] = sizes[i];
+   }
+
+   s->n_cols = n_cols;
+   s->len = s->cap = 0;
+   s->mem = NULL;
+   s->mem_size = 0;
+   s->alloc = alloc;
+
+   return true;
+}
+
+bool soa_new(Soa *s, const size_t *sizes, size_t n_cols)
+{
+   return soa_new_in(s, sizes, n_cols, NULL);
+}
+
+void soa_free(Soa *s)
+{
+   if (s->mem)
+      allocator_free(s->alloc, s->mem, s->mem_size);
+   allocator_free(s->alloc, s->cols, s->n_cols * (sizeof(void *) + sizeof(size_t)));
+
+   s->cols = NULL;
+   s->sizes = NULL;
+   s->n_cols = s->len = s->cap = 0;
+   s->mem = NULL;
+   s->mem_size = 0;
+}
+
+bool soa_reserve(Soa *s, size_t nrows)
+{
+   size_t cap, mem_size, i;
+   char  *mem, *col;
+
+   if (nrows <= s->cap)
+      return true;
+
+   cap = s->cap * GROWTH_FACTOR;
+   if (cap < nrows)
+      cap = nrows;
+
+   /* one block for everything, with room to align the first column */
+   mem_size = CACHE_LINE - 1;
+   for (i = 0; i < s->n_cols; i++)
+      mem_size += col_bytes(s->sizes[i], cap);
+
+   mem = allocator_realloc(s->alloc, NULL, 0, mem_size);
+   if (!mem)
+      return false;
+
+   /* columns can't be realloc'd in place, they all move */
+   col = mem + (CACHE_LINE - 1 - ((uintptr_t)mem + CACHE_LINE - 1) % CACHE_LINE);
+   for (i = 0; i < s->n_cols; i++) {
+      if (s->len)
+         memcpy(col, s->cols[i], s->len * s->sizes[i]);
+      s->cols[i] = col;
+      col += col_bytes(s->sizes[i], cap);
+   }
+
+   if (s->mem)
+      allocator_free(s->alloc, s->mem, s->mem_size);
+   s->mem = mem;
+   s->mem_size = mem_size;
+   s->cap = cap;
+
+   return true;
+}
+
+bool soa_push(Soa *s, const void *const *fields)
+{
+   size_t i;
+
+   if (s->len == s->cap && !soa_reserve(s, s->len + 1))
+      return false;
+
+   for (i = 0; i < s->n_cols; i++) {
+      char *dst = (char *)s->cols[i] + s->len * s->sizes[i];
+
+      if (fields && fields[i])
+         memcpy(dst, fields[i], s->sizes[i]);
+      else
+         memset(dst, 0, s->sizes[i]);
+   }
+   s->len++;
+
+   return true;
+}
+
+bool soa_get(const Soa *s, size_t row, void *const *fields)
+{
+   size_t i;
+
+   if (row >= s->len)
+      return false;
+
+   for (i = 0; i < s->n_cols; i++) {
+      if (fields[i])
+         memcpy(fields[i], (char *)s->cols[i] + row * s->sizes[i], s->sizes[i]);
+   }
+
+   return true;
+}
+
+bool soa_swap_remove(Soa *s, size_t row, void *const *fields)
+{
+   size_t i, last;
+
+   if (row >= s->len)
+      return false;
+
+   if (fields)
+      soa_get(s, row, fields);
+
+   last = s->len - 1;
+   if (row != last) {
+      for (i = 0; i < s->n_cols; i++) {
+         size_t size = s->sizes[i];
+         char  *col = s->cols[i];
+
+         memcpy(col + row * size, col + last * size, size);
+      }
+   }
+   s->len--;
+
+   return true;
+}
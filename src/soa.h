@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file soa.h
+ */
+#ifndef __SOA_H__
+#define __SOA_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "allocator.h"
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief size of the member @p field of the struct @p T , to build the list of column sizes
+ *
+ *    size_t sizes[] = {SOA_FIELD_SIZE(Rec, id), SOA_FIELD_SIZE(Rec, price)};
+ */
+#define SOA_FIELD_SIZE(T, field) sizeof(((T *)0)->field)
+
+/**
+ * @brief records stored as a structure of arrays: one contiguous column per field
+ *
+ * scanning a field only touches that column, instead of dragging the whole record
+ * through the cache. all the columns live in a single block and grow together, each one
+ * starts on a cache line, so it can be handed as is to SIMD kernels.
+ * rows are read and written field by field, as an array with a pointer per column
+ *
+ *    Soa s;
+ *    soa_new(&s, sizes, 2);
+ *    soa_push(&s, (const void *[]){&id, &price});
+ *    double *prices = soa_col(&s, 1);
+ */
+typedef struct Soa {
+   void           **cols; /**< start of each column */
+   size_t          *sizes; /**< size of the fields of each column */
+   size_t           n_cols; /**< number of columns */
+   size_t           len; /**< number of rows */
+   size_t           cap; /**< number of rows for which there is space allocated */
+   void            *mem; /**< block holding all the columns */
+   size_t           mem_size;
+   const Allocator *alloc; /**< source of the memory, NULL for malloc */
+} Soa;
+
+/**
+ * @brief initialize empty struct
+ *
+ * @param[out] s Soa
+ * @param[in] sizes size of the field of each column (see @p SOA_FIELD_SIZE )
+ * @param[in] n_cols number of columns
+ *
+ * @return false in case of failure
+ */
+bool soa_new(Soa *s, const size_t *sizes, size_t n_cols);
+
+/**
+ * @brief initialize empty struct, taking the memory from @p alloc
+ *
+ * see @p soa_new
+ *
+ * @param[in] alloc allocator, or NULL for malloc
+ */
+bool soa_new_in(Soa *s, const size_t *sizes, size_t n_cols, const Allocator *alloc);
+
+/**
+ * @brief free all the columns
+ *
+ * @param[in,out] s Soa
+ */
+void soa_free(Soa *s);
+
+/**
+ * @brief reserve space for at least @p nrows rows in every column
+ *
+ * WARNING: moves the columns, pointers to them are invalidated
+ *
+ * @param[in,out] s Soa
+ * @param[in] nrows number of rows
+ *
+ * @return false in case of failure
+ */
+bool soa_reserve(Soa *s, size_t nrows);
+
+/**
+ * @brief drop the rows after @p new_len
+ *
+ * @param[in,out] s Soa
+ * @param[in] new_len new number of rows
+ */
+INLINE static void soa_truncate(Soa *s, size_t new_len)
+{
+   if (new_len < s->len)
+      s->len = new_len;
+}
+
+/**
+ * @brief number of rows
+ */
+INLINE static size_t soa_len(const Soa *s)
+{
+   return s->len;
+}
+
+/**
+ * @brief raw pointer to column @p col , with @p soa_len elements
+ *
+ * WARNING: this can be invalidated by insertions
+ *
+ * @param[in] s Soa
+ * @param[in] col index of the column
+ *
+ * @return pointer to the column, aligned to a cache line (NULL while nothing is allocated)
+ */
+INLINE static void *soa_col(const Soa *s, size_t col)
+{
+   return s->cols[col];
+}
+
+/**
+ * @brief pointer to the field of column @p col at row @p row
+ *
+ * WARNING: this can be invalidated by insertions
+ *
+ * @param[in] s Soa
+ * @param[in] row index of the row
+ * @param[in] col index of the column
+ *
+ * @return pointer to the field, or NULL
+ */
+INLINE static void *soa_at(const Soa *s, size_t row, size_t col)
+{
+   if (row < s->len && col < s->n_cols)
+      return (char *)s->cols[col] + row * s->sizes[col];
+   return NULL;
+}
+
+/**
+ * @brief append a row through shallow-copy of its fields
+ *
+ * @param[in,out] s Soa
+ * @param[in] fields array with a pointer to the field of each column. if NULL, or one of the
+ *                   pointers is NULL, the fields are zeroed
+ *
+ * @return false in case of failure
+ */
+bool soa_push(Soa *s, const void *const *fields);
+
+/**
+ * @brief get a shallow-copy of the fields of row @p row
+ *
+ * @param[in] s Soa
+ * @param[in] row index of the row
+ * @param[out] fields array with a destination for the field of each column, NULL to skip one
+ *
+ * @return false in case of failure
+ */
+bool soa_get(const Soa *s, size_t row, void *const *fields);
+
+/**
+ * @brief remove row @p row , moving the last one in its place
+ *
+ * O(1), but doesn't keep the order of the rows
+ *
+ * @param[in,out] s Soa
+ * @param[in] row index of the row
+ * @param[out] fields if != NULL, on exit the fields of the removed row are copied there
+ *                    (see @p soa_get )
+ *
+ * @return false in case of failure
+ */
+bool soa_swap_remove(Soa *s, size_t row, void *const *fields);
+
+#endif /* __SOA_H__ */
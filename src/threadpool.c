@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+   #include <windows.h>
+#else
+   #include <unistd.h>
+#endif
+
+#include "threadpool.h"
+
+/**
+ * @brief take and run tasks of the current job until there are none left
+ */
+static void run_tasks(ThreadPool *pool)
+{
+   size_t idx;
+
+   while ((idx = atomic_fetch_add_explicit(&pool->next_task, 1, memory_order_relaxed)) <
+          pool->n_tasks)
+      pool->fn(pool->ctx, idx);
+}
+
+static int worker_main(void *arg)
+{
+   ThreadPool *pool = arg;
+   size_t      seen = 0;
+
+   mtx_lock(&pool->mtx);
+   for (;;) {
+      while (pool->generation == seen && !pool->stop)
+         cnd_wait(&pool->work_cnd, &pool->mtx);
+      if (pool->stop)
+         break;
+      seen = pool->generation;
+      mtx_unlock(&pool->mtx);
+
+      run_tasks(pool);
+
+      mtx_lock(&pool->mtx);
+      if (--pool->n_busy == 0)
+         cnd_signal(&pool->done_cnd);
+   }
+   mtx_unlock(&pool->mtx);
+
+   return 0;
+}
+
+size_t threadpool_n_cpus(void)
+{
+#ifdef _WIN32
+   SYSTEM_INFO info;
+
+   GetSystemInfo(&info);
+   return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+#else
+   long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+   return n > 0 ? (size_t)n : 1;
+#endif
+}
+
+bool threadpool_new(ThreadPool *pool, size_t n_threads)
+{
+   size_t i;
+
+   if (!n_threads)
+      n_threads = threadpool_n_cpus();
+
+   pool->n_threads = n_threads;
+   pool->fn = NULL;
+   pool->ctx = NULL;
+   pool->n_tasks = 0;
+   atomic_init(&pool->next_task, 0);
+   pool->n_busy = 0;
+   pool->generation = 0;
+   pool->stop = false;
+   mtx_init(&pool->mtx, mtx_plain);
+   cnd_init(&pool->work_cnd);
+   cnd_init(&pool->done_cnd);
+
+   pool->threads = n_threads > 1 ? malloc((n_threads - 1) * sizeof(thrd_t)) : NULL;
+   for (i = 0; i + 1 < n_threads; i++) {
+      if (thrd_create(&pool->threads[i], worker_main, pool) != thrd_success) {
+         /* stop the ones already started */
+         pool->n_threads = i + 1;
+         threadpool_free(pool);
+         return false;
+      }
+   }
+
+   return true;
+}
+
+void threadpool_run(ThreadPool *pool, TaskFn fn, void *ctx, size_t n_tasks)
+{
+   size_t i;
+
+   if (!pool || pool->n_threads == 1 || n_tasks == 1) {
+      for (i = 0; i < n_tasks; i++)
+         fn(ctx, i);
+      return;
+   }
+
+   mtx_lock(&pool->mtx);
+   pool->fn = fn;
+   pool->ctx = ctx;
+   pool->n_tasks = n_tasks;
+   atomic_store_explicit(&pool->next_task, 0, memory_order_relaxed);
+   pool->n_busy = pool->n_threads - 1;
+   pool->generation++;
+   cnd_broadcast(&pool->work_cnd);
+   mtx_unlock(&pool->mtx);
+
+   run_tasks(pool);
+
+   /* every worker must be done with the job before it can be replaced */
+   mtx_lock(&pool->mtx);
+   while (pool->n_busy)
+      cnd_wait(&pool->done_cnd, &pool->mtx);
+   mtx_unlock(&pool->mtx);
+}
+
+size_t threadpool_n_threads(const ThreadPool *pool)
+{
+   return pool ? pool->n_threads : 1;
+}
+
+void threadpool_free(ThreadPool *pool)
+{
+   size_t i;
+
+   mtx_lock(&pool->mtx);
+   pool->stop = true;
+   cnd_broadcast(&pool->work_cnd);
+   mtx_unlock(&pool->mtx);
+
+   for (i = 0; i + 1 < pool->n_threads; i++)
+      thrd_join(pool->threads[i], NULL);
+
+   free(pool->threads);
+   pool->threads = NULL;
+   pool->n_threads = 0;
+   mtx_destroy(&pool->mtx);
+   cnd_destroy(&pool->work_cnd);
+   cnd_destroy(&pool->done_cnd);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file threadpool.h
+ */
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <threads.h>
+
+/**
+ * @brief a task of a parallel job
+ *
+ * @param[in,out] ctx context given to @p threadpool_run
+ * @param[in] idx index of the task, in [0, n_tasks)
+ */
+typedef void (*TaskFn)(void *ctx, size_t idx);
+
+/**
+ * @brief fixed set of worker threads, that run fork-join jobs
+ *
+ * a job is @p n_tasks calls of the same function. the workers and the calling thread take
+ * the next task index from a shared atomic counter until they run out, so faster threads
+ * just end up running more tasks. the threads are kept between jobs, sleeping.
+ *
+ * a pool runs one job at a time, so it must be used by one thread at a time.
+ * the workers keep a pointer to it, so it must not be moved
+ *
+ * @note requires C11 threads and atomics
+ */
+typedef struct ThreadPool {
+   thrd_t       *threads; /**< workers */
+   size_t        n_threads; /**< workers, plus the calling thread */
+   mtx_t         mtx;
+   cnd_t         work_cnd; /**< a new job (or stop) for the workers */
+   cnd_t         done_cnd; /**< all the workers are done with the job */
+   TaskFn        fn; /**< current job */
+   void         *ctx;
+   size_t        n_tasks;
+   atomic_size_t next_task; /**< next task index to run */
+   size_t        n_busy; /**< workers that didn't finish the current job */
+   size_t        generation; /**< incremented for every job */
+   bool          stop;
+} ThreadPool;
+
+/**
+ * @brief number of online CPUs, at least 1
+ */
+size_t threadpool_n_cpus(void);
+
+/**
+ * @brief create a pool and start its workers
+ *
+ * @param[out] pool ThreadPool
+ * @param[in] n_threads threads that run a job, including the caller of @p threadpool_run
+ *            (so n_threads - 1 workers are started). 0 means @p threadpool_n_cpus
+ *
+ * @return false if a thread could not be started
+ */
+bool threadpool_new(ThreadPool *pool, size_t n_threads);
+
+/**
+ * @brief run @p fn for every index in [0, @p n_tasks ), and wait for all of them to finish
+ *
+ * the calling thread runs tasks too.
+ * tasks should be big enough to amortize an atomic increment, and small enough to balance the load
+ *
+ * @param[in,out] pool ThreadPool, or NULL to run everything on the calling thread
+ * @param[in] fn function to run
+ * @param[in,out] ctx passed to @p fn
+ * @param[in] n_tasks number of tasks
+ */
+void threadpool_run(ThreadPool *pool, TaskFn fn, void *ctx, size_t n_tasks);
+
+/**
+ * @brief threads that run a job, including the caller. 1 if @p pool is NULL
+ */
+size_t threadpool_n_threads(const ThreadPool *pool);
+
+/**
+ * @brief stop and join the workers, then free the pool
+ *
+ * @param[in,out] pool ThreadPool
+ */
+void threadpool_free(ThreadPool *pool);
+
+#endif /* __THREADPOOL_H__ */
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "timewheel.h"
+
+#define SLOT_MASK  ((Tick)TIMEWHEEL_SLOTS - 1)
+#define MAX_DELTA  (((Tick)1 << (TIMEWHEEL_SLOT_BITS * TIMEWHEEL_LEVELS)) - 1) /**< furthest tick that fits the wheels */
+
+/**
+ * @brief index of the slot of @p level for @p tick
+ */
+INLINE static size_t slot_idx(Tick tick, size_t level)
+{
+   return (size_t)((tick >> (TIMEWHEEL_SLOT_BITS * level)) & SLOT_MASK);
+}
+
+/**
+ * @brief find the slot where a timer that expires at @p expire belongs
+ *
+ * @param[in] tw timing wheel
+ * @param[in] expire expiration tick
+ *
+ * @return slot
+ */
+static LList *timewheel_slot(TimeWheel *tw, Tick expire)
+{
+   Tick   delta;
+   size_t level;
+
+   /* already expired: due at the tick being processed, or on the next advance if the clock is caught up */
+   if (expire < tw->clk)
+      return tw->clk > tw->now ? &tw->due : &tw->slots[0][slot_idx(tw->clk, 0)];
+
+   delta = expire - tw->clk;
+   if (delta > MAX_DELTA) {
+      delta = MAX_DELTA;
+      expire = tw->clk + delta;
+   }
+
+   for (level = 0; level < TIMEWHEEL_LEVELS - 1; level++) {
+      if (delta >> (TIMEWHEEL_SLOT_BITS * (level + 1)) == 0)
+         break;
+   }
+
+   return &tw->slots[level][slot_idx(expire, level)];
+}
+
+/**
+ * @brief reschedule every timer in a slot of @p level, moving them to the lower wheels
+ *
+ * @param[in,out] tw timing wheel
+ * @param[in] level wheel to cascade
+ *
+ * @return index of the slot that was cascaded
+ */
+static size_t timewheel_cascade(TimeWheel *tw, size_t level)
+{
+   size_t idx = slot_idx(tw->clk, level);
+   LList  pending;
+   LNode *curr, *next;
+
+   llist_init(&pending);
+   llist_join_front(&tw->slots[level][idx], &pending);
+
+   llist_foreach(&pending, curr, next) {
+      Timer *timer = timer_entry(curr, Timer, link);
+
+      llist_remove(curr);
+      llist_push_back(timewheel_slot(tw, timer->expire), curr);
+   }
+
+   return idx;
+}
+
+/**
+ * @brief first tick after the current one where a slot has to be processed or cascaded
+ *
+ * for every level, the first non-empty slot after the current index is reached in this rotation
+ * of the level, while the ones up to the current index wait for the next rotation (the
+ * boundary of the next level, taken conservatively). the ticks in between would only find
+ * empty slots, so they can be skipped
+ *
+ * @param[in] tw timing wheel
+ *
+ * @return next tick to process, > tw->clk
+ */
+static Tick timewheel_next_event(const TimeWheel *tw)
+{
+   Tick   next = (Tick)-1;
+   size_t level, idx, j;
+
+   for (level = 0; level < TIMEWHEEL_LEVELS; level++) {
+      size_t shift = TIMEWHEEL_SLOT_BITS * level;
+      Tick   rotation = tw->clk >> (shift + TIMEWHEEL_SLOT_BITS) << (shift + TIMEWHEEL_SLOT_BITS);
+      bool   wrapped = false;
+
+      idx = slot_idx(tw->clk, level);
+      for (j = 0; j <= idx; j++) {
+         if (!llist_is_empty(&tw->slots[level][j])) {
+            wrapped = true;
+            break;
+         }
+      }
+      if (wrapped) {
+         Tick boundary = rotation + ((Tick)1 << (shift + TIMEWHEEL_SLOT_BITS));
+
+         if (boundary < next)
+            next = boundary;
+      }
+
+      for (j = idx + 1; j < TIMEWHEEL_SLOTS; j++) {
+         if (!llist_is_empty(&tw->slots[level][j])) {
+            Tick tick = rotation | ((Tick)j << shift);
+
+            if (tick < next)
+               next = tick;
+            break;
+         }
+      }
+   }
+
+   return next;
+}
+
+void timewheel_init(TimeWheel *tw, Tick now)
+{
+   size_t level, idx;
+
+   for (level = 0; level < TIMEWHEEL_LEVELS; level++) {
+      for (idx = 0; idx < TIMEWHEEL_SLOTS; idx++) {
+         llist_init(&tw->slots[level][idx]);
+      }
+   }
+   llist_init(&tw->due);
+   tw->now = now;
+   tw->clk = now + 1;
+   tw->n_timers = 0;
+}
+
+void timewheel_add(TimeWheel *tw, Timer *timer, Tick expire)
+{
+   timer->expire = expire;
+   llist_push_back(timewheel_slot(tw, expire), &timer->link);
+   tw->n_timers++;
+}
+
+/**
+ * @brief move up to @p budget timers from @p slot to @p expired
+ *
+ * @return if @p slot was emptied
+ */
+static bool
+timewheel_collect(TimeWheel *tw, LList *slot, LList *expired, size_t *n_expired, size_t budget)
+{
+   while (!llist_is_empty(slot)) {
+      LNode *node = llist_first(slot);
+
+      if (*n_expired == budget)
+         return false;
+
+      llist_remove(node);
+      llist_push_back(expired, node);
+      tw->n_timers--;
+      (*n_expired)++;
+   }
+
+   return true;
+}
+
+size_t timewheel_advance(TimeWheel *tw, Tick now, LList *expired, size_t budget)
+{
+   size_t n_expired = 0;
+
+   if (now > tw->now)
+      tw->now = now;
+
+   if (!timewheel_collect(tw, &tw->due, expired, &n_expired, budget))
+      return n_expired;
+
+   while (tw->clk <= tw->now) {
+      size_t idx = slot_idx(tw->clk, 0);
+
+      if (!tw->n_timers) {
+         tw->clk = tw->now + 1;
+         break;
+      }
+
+      /* resuming after the budget ran out cascades again, but the slots are empty by then */
+      if (!idx) {
+         size_t level;
+
+         for (level = 1; level < TIMEWHEEL_LEVELS; level++) {
+            if (timewheel_cascade(tw, level))
+               break;
+         }
+      }
+
+      if (!timewheel_collect(tw, &tw->slots[0][idx], expired, &n_expired, budget))
+         return n_expired;
+
+      /* jump over the ticks with nothing to do, so the work doesn't grow with the time elapsed */
+      if (idx + 1 < TIMEWHEEL_SLOTS && !llist_is_empty(&tw->slots[0][idx + 1]))
+         tw->clk++;
+      else {
+         Tick next = timewheel_next_event(tw);
+
+         tw->clk = next <= tw->now ? next : tw->now + 1;
+      }
+   }
+
+   return n_expired;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file timewheel.h
+ */
+#ifndef __TIMEWHEEL_H__
+#define __TIMEWHEEL_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "llist.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+#define TIMEWHEEL_LEVELS    4 /**< number of wheels in the hierarchy */
+#define TIMEWHEEL_SLOT_BITS 6
+#define TIMEWHEEL_SLOTS     (1 << TIMEWHEEL_SLOT_BITS) /**< slots per wheel */
+
+#define TIMEWHEEL_UNBOUNDED ((size_t)-1) /**< budget for timewheel_advance that never stops early */
+
+typedef uint64_t Tick; /**< unit of time of the wheel, its meaning is up to the user */
+
+/**
+ * @brief timer to be embedded in user structs, just like @p LNode
+ */
+typedef struct Timer {
+   LNode link;
+   Tick  expire; /**< tick at which the timer expires */
+} Timer;
+
+/**
+ * @brief hierarchical timing wheel
+ *
+ * every wheel has TIMEWHEEL_SLOTS slots, each one being an intrusive @p LList of @p Timer
+ * the first wheel has a resolution of 1 tick, every next one is TIMEWHEEL_SLOTS times coarser,
+ * and its slots are cascaded down to the previous wheel when that one wraps around.
+ *
+ * adding and removing timers is O(1), and advancing the clock costs O(expired) plus a scan of
+ * the slots for every slot processed or cascaded: runs of empty slots are jumped over, so the
+ * work doesn't depend on how many ticks elapsed (a far-future timer adds a few steps every
+ * TIMEWHEEL_SLOTS^TIMEWHEEL_LEVELS ticks). when no timer is pending at all, the clock just jumps forward.
+ *
+ * timers further than TIMEWHEEL_SLOTS^TIMEWHEEL_LEVELS ticks in the future are parked in the
+ * last slot of the last wheel and rescheduled every time it's cascaded.
+ *
+ * implementation based on the (pre 4.8) timer wheel of the linux kernel
+ */
+typedef struct TimeWheel {
+   LList  slots[TIMEWHEEL_LEVELS][TIMEWHEEL_SLOTS];
+   LList  due; /**< timers added when already expired */
+   Tick   now; /**< last time passed to timewheel_advance (or timewheel_init) */
+   Tick   clk; /**< next tick to be processed */
+   size_t n_timers; /**< number of pending timers */
+} TimeWheel;
+
+/**
+ * @brief initialize the wheel
+ *
+ * @param[out] tw timing wheel
+ * @param[in] now current time
+ */
+void timewheel_init(TimeWheel *tw, Tick now);
+
+/**
+ * @brief initialize timer, so that it can be removed even if it was never added
+ *
+ * @param[out] timer timer
+ */
+INLINE static void timer_init(Timer *timer)
+{
+   llist_init(&timer->link);
+   timer->expire = 0;
+}
+
+/**
+ * @brief if @p timer is currently scheduled in a wheel
+ */
+INLINE static bool timer_pending(const Timer *timer)
+{
+   return !llist_is_empty(&timer->link);
+}
+
+/**
+ * @brief schedule @p timer
+ *
+ * if @p expire is not in the future, the timer expires on the next call to @p timewheel_advance
+ *
+ * @param[in,out] tw timing wheel
+ * @param[in,out] timer timer, must not be pending already
+ * @param[in] expire tick at which the timer expires
+ */
+void timewheel_add(TimeWheel *tw, Timer *timer, Tick expire);
+
+/**
+ * @brief unschedule @p timer, if pending
+ *
+ * @param[in,out] tw timing wheel
+ * @param[in,out] timer timer
+ */
+INLINE static void timewheel_remove(TimeWheel *tw, Timer *timer)
+{
+   if (timer_pending(timer)) {
+      llist_remove(&timer->link);
+      tw->n_timers--;
+   }
+}
+
+/**
+ * @brief move the clock forward, collecting the expired timers
+ *
+ * if @p budget is reached, the clock stops at the tick being processed
+ * and the next call resumes from there
+ *
+ * @param[in,out] tw timing wheel
+ * @param[in] now current time. if it's in the past, only pending expirations are collected
+ * @param[out] expired list where the expired timers are appended (in expiration order)
+ * @param[in] budget maximum number of timers to collect, or TIMEWHEEL_UNBOUNDED
+ *
+ * @return number of timers collected
+ */
+size_t timewheel_advance(TimeWheel *tw, Tick now, LList *expired, size_t budget);
+
+/**
+ * @brief the corresponding data of the timer
+ *
+ * see @p llist_entry
+ */
+#define timer_entry(timer, etype, MEMBER) container_of(timer, etype, MEMBER)
+
+#endif /* __TIMEWHEEL_H__ */
@@ -5,8 +5,25 @@
  * https://opensource.org/licenses/MIT
  */
 
+#if defined(__linux__)
+   #define VEC_MMAP
+   #ifndef _GNU_SOURCE
+      #define _GNU_SOURCE /* mremap */
+   #endif
+#endif
+
+#include <assert.h>
 #include <stdlib.h>
 
+#ifdef _WIN32
+   #include <malloc.h>
+#endif
+
+#ifdef VEC_MMAP
+   #include <sys/mman.h>
+   #include <unistd.h>
+#endif
+
 #include "vec.h"
 
 /**
@@ -35,12 +52,140 @@ INLINE static const char *vec_at_unchecked_const(const Vec *v, size_t pos)
    return vec_at_unchecked((Vec *)v, pos);
 }
 
+static size_t mmap_threshold = 0; /**< see vec_set_mmap_threshold */
+
+/**
+ * @brief allocate @p bytes aligned to @p align , freed with @p aligned_free
+ */
+static void *aligned_malloc(size_t align, size_t bytes)
+{
+#ifdef _WIN32
+   return _aligned_malloc(bytes, align);
+#else
+   void *ptr;
+
+   return posix_memalign(&ptr, align, bytes) ? NULL : ptr;
+#endif
+}
+
+static void aligned_free(void *ptr)
+{
+#ifdef _WIN32
+   _aligned_free(ptr);
+#else
+   free(ptr);
+#endif
+}
+
+/**
+ * @brief move the elements of an aligned Vec to a new block for @p cap elements at least
+ *
+ * the block is rounded up to a multiple of the alignment, and the capacity includes it
+ *
+ * @return false if the allocation failed (the Vec is unchanged)
+ */
+static bool vec_realloc_aligned(Vec *v, size_t cap)
+{
+   size_t bytes = (cap * v->size + v->align - 1) / v->align * v->align;
+   void  *ptr = aligned_malloc(v->align, bytes);
+
+   if (!ptr)
+      return false;
+
+   if (v->len)
+      vec_memcpy(v, ptr, v->ptr, v->len);
+   if (v->cap && !(v->flags & VEC_BORROWED))
+      aligned_free(v->ptr);
+
+   v->ptr = ptr;
+   v->cap = bytes / v->size;
+   v->flags &= ~VEC_BORROWED;
+
+   return true;
+}
+
+#ifdef VEC_MMAP
+
+/**
+ * @brief size of the mapping that holds @p nelem elements
+ */
+static size_t mapped_size(const Vec *v, size_t nelem)
+{
+   size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+   return (nelem * v->size + page - 1) / page * page;
+}
+
+/**
+ * @brief grow (or shrink) the mapping of @p v , or move the elements into a new one
+ *
+ * @return false if the mapping failed (the Vec is unchanged)
+ */
+static bool vec_remap(Vec *v, size_t cap)
+{
+   size_t new_size = mapped_size(v, cap);
+   void  *ptr;
+
+   if (v->flags & VEC_MAPPED)
+      ptr = mremap(v->ptr, mapped_size(v, v->cap), new_size, MREMAP_MAYMOVE);
+   else {
+      ptr = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (ptr != MAP_FAILED && v->len)
+         vec_memcpy(v, ptr, v->ptr, v->len);
+   }
+
+   if (ptr == MAP_FAILED)
+      return false;
+
+#ifdef MADV_HUGEPAGE
+   /* just a hint, it's fine if THP is disabled */
+   madvise(ptr, new_size, MADV_HUGEPAGE);
+#endif
+
+   if (!(v->flags & VEC_MAPPED)) {
+      if (!(v->flags & VEC_BORROWED))
+         free(v->ptr);
+      v->flags = (v->flags & ~VEC_BORROWED) | VEC_MAPPED;
+   }
+   v->ptr = ptr;
+   v->cap = cap;
+
+   return true;
+}
+
+/**
+ * @brief if @p v should be in a mapping to hold @p cap elements
+ */
+INLINE static bool vec_wants_mapping(const Vec *v, size_t cap)
+{
+   /* mappings are page aligned */
+   return (v->flags & VEC_MAPPED) ||
+          (!v->alloc && mmap_threshold && cap * v->size >= mmap_threshold &&
+           v->align <= (size_t)sysconf(_SC_PAGESIZE));
+}
+
+#endif
+
+void vec_set_mmap_threshold(size_t bytes)
+{
+   mmap_threshold = bytes;
+}
+
 void vec_new(Vec *v, size_t size, FreeFn free_fn)
 {
    v->ptr = NULL;
    v->len = v->cap = 0;
    v->size = size;
    v->free_fn = free_fn;
+   v->alloc = NULL;
+   v->flags = 0;
+   v->align = 0;
+}
+
+void vec_new_in(Vec *v, size_t size, FreeFn free_fn, const Allocator *alloc)
+{
+   vec_new(v, size, free_fn);
+   v->alloc = alloc;
 }
 
 void vec_new_with(Vec *v, size_t size, size_t nelem, FreeFn free_fn)
@@ -49,6 +194,24 @@ void vec_new_with(Vec *v, size_t size, size_t nelem, FreeFn free_fn)
    vec_reserve(v, nelem);
 }
 
+void vec_new_aligned(Vec *v, size_t size, size_t nelem, size_t align, FreeFn free_fn)
+{
+   assert(align && !(align & (align - 1)));
+
+   vec_new(v, size, free_fn);
+   /* posix_memalign's minimum */
+   v->align = align < sizeof(void *) ? sizeof(void *) : align;
+   vec_reserve(v, nelem);
+}
+
+void vec_new_inline(Vec *v, size_t size, void *buf, size_t nelem, FreeFn free_fn)
+{
+   vec_new(v, size, free_fn);
+   v->ptr = buf;
+   v->cap = nelem;
+   v->flags = VEC_BORROWED;
+}
+
 void vec_from(Vec *v, size_t size, const void *arr, size_t nelem, FreeFn free_fn)
 {
    vec_new(v, size, free_fn);
@@ -64,10 +227,21 @@ void vec_free(Vec *v)
             v->free_fn(vec_at_unchecked(v, i));
          }
       }
-      free(v->ptr);
+#ifdef VEC_MMAP
+      if (v->flags & VEC_MAPPED)
+         munmap(v->ptr, mapped_size(v, v->cap));
+      else
+#endif
+      if (v->flags & VEC_BORROWED)
+         ;
+      else if (v->align)
+         aligned_free(v->ptr);
+      else
+         allocator_free(v->alloc, v->ptr, v->cap * v->size);
    }
    v->ptr = NULL;
    v->len = v->cap = 0;
+   v->flags = 0;
 }
 
 void vec_truncate(Vec *v, size_t new_len)
@@ -83,26 +257,67 @@ void vec_truncate(Vec *v, size_t new_len)
    }
 }
 
-void vec_reserve(Vec *v, size_t nelem)
+bool vec_reserve(Vec *v, size_t nelem)
 {
-   if (nelem > v->cap) {
-      v->cap *= GROWTH_FACTOR;
-      if (v->cap < nelem)
-         v->cap = nelem;
+   size_t cap;
+   void  *ptr;
 
-      if (v->ptr)
-         v->ptr = realloc(v->ptr, v->cap * v->size);
-      else
-         v->ptr = malloc(v->cap * v->size);
+   if (nelem <= v->cap)
+      return true;
+
+   cap = v->cap * GROWTH_FACTOR;
+   if (cap < nelem)
+      cap = nelem;
+
+#ifdef VEC_MMAP
+   if (vec_wants_mapping(v, cap))
+      return vec_remap(v, cap);
+#endif
+
+   if (v->align)
+      return vec_realloc_aligned(v, cap);
+
+   if (v->flags & VEC_BORROWED) {
+      /* spill out of the borrowed storage */
+      ptr = allocator_realloc(v->alloc, NULL, 0, cap * v->size);
+      if (ptr)
+         vec_memcpy(v, ptr, v->ptr, v->len);
    }
+   else
+      ptr = allocator_realloc(v->alloc, v->ptr, v->cap * v->size, cap * v->size);
+
+   if (!ptr)
+      return false;
+
+   v->ptr = ptr;
+   v->cap = cap;
+   v->flags &= ~VEC_BORROWED;
+
+   return true;
 }
 
 void vec_shrink_to_fit(Vec *v)
 {
+   /* borrowed storage can't be given back */
+   if (v->flags & VEC_BORROWED)
+      return;
+
    if (v->cap > v->len) {
-      if (v->len) {
-         v->cap = v->len;
-         v->ptr = realloc(v->ptr, v->cap * v->size);
+#ifdef VEC_MMAP
+      if (v->len && (v->flags & VEC_MAPPED)) {
+         vec_remap(v, v->len);
+         return;
+      }
+#endif
+      if (v->len && v->align)
+         vec_realloc_aligned(v, v->len);
+      else if (v->len) {
+         void *ptr = allocator_realloc(v->alloc, v->ptr, v->cap * v->size, v->len * v->size);
+
+         if (ptr) {
+            v->ptr = ptr;
+            v->cap = v->len;
+         }
       }
       else
          vec_free(v);
@@ -136,7 +351,8 @@ void *vec_insert_n(Vec *v, size_t pos, const void *elems, size_t nelem)
    if (pos > v->len)
       return NULL;
 
-   vec_reserve(v, v->len + nelem);
+   if (!vec_reserve(v, v->len + nelem))
+      return NULL;
    vec_memmove(v, vec_at_unchecked(v, pos + nelem), vec_at_unchecked(v, pos), v->len - pos);
    if (elems)
       vec_memcpy(v, vec_at_unchecked(v, pos), elems, nelem);
@@ -174,6 +390,78 @@ bool vec_remove_n(Vec *v, size_t pos, void *elems, size_t nelem)
    return true;
 }
 
+bool vec_swap_remove(Vec *v, size_t pos, void *elem)
+{
+   if (pos >= v->len)
+      return false;
+
+   if (elem)
+      vec_memcpy(v, elem, vec_at_unchecked(v, pos), 1);
+   else if (v->free_fn)
+      v->free_fn(vec_at_unchecked(v, pos));
+
+   v->len--;
+   if (pos != v->len)
+      vec_memcpy(v, vec_at_unchecked(v, pos), vec_at_unchecked(v, v->len), 1);
+
+   return true;
+}
+
+/**
+ * @brief move the run of kept elements [ @p beg, @p end ) down to @p dst
+ *
+ * @return position after the run moved
+ */
+INLINE static size_t vec_compact_run(Vec *v, size_t dst, size_t beg, size_t end)
+{
+   if (dst != beg && end > beg)
+      vec_memmove(v, vec_at_unchecked(v, dst), vec_at_unchecked(v, beg), end - beg);
+   return dst + (end - beg);
+}
+
+size_t vec_retain(Vec *v, VecPredFn pred, void *ctx)
+{
+   size_t i, dst = 0, run = 0, old_len = v->len;
+
+   /* elements are only moved down, so the ones not checked yet are still in place */
+   for (i = 0; i < v->len; i++) {
+      if (pred(vec_at_unchecked(v, i), ctx))
+         continue;
+
+      if (v->free_fn)
+         v->free_fn(vec_at_unchecked(v, i));
+      dst = vec_compact_run(v, dst, run, i);
+      run = i + 1;
+   }
+   v->len = vec_compact_run(v, dst, run, v->len);
+
+   return old_len - v->len;
+}
+
+bool vec_remove_indices(Vec *v, const size_t *sorted_idx, size_t n)
+{
+   size_t k, dst;
+
+   for (k = 0; k < n; k++) {
+      if (sorted_idx[k] >= v->len || (k && sorted_idx[k] <= sorted_idx[k - 1]))
+         return false;
+   }
+   if (!n)
+      return true;
+
+   dst = sorted_idx[0];
+   for (k = 0; k < n; k++) {
+      size_t next = k + 1 < n ? sorted_idx[k + 1] : v->len;
+
+      if (v->free_fn)
+         v->free_fn(vec_at_unchecked(v, sorted_idx[k]));
+      dst = vec_compact_run(v, dst, sorted_idx[k] + 1, next);
+   }
+   v->len -= n;
+
+   return true;
+}
+
 bool vec_swap(Vec *v, size_t pos1, size_t pos2, size_t nelem)
 {
    char tmp[256];
@@ -16,6 +16,8 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "allocator.h"
+
 #ifdef _MSC_VER
    #define INLINE __inline
 #elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
@@ -26,17 +28,82 @@
 
 typedef void (*FreeFn)(void *); /**< free function for elements */
 
+/**
+ * @brief type of plain numeric elements, for the algorithms that interpret them
+ * (e.g. @p vec_sort_radix )
+ */
+typedef enum VecType {
+   VEC_U8,
+   VEC_U16,
+   VEC_U32,
+   VEC_U64,
+   VEC_I8,
+   VEC_I16,
+   VEC_I32,
+   VEC_I64,
+   VEC_F32, /**< float */
+   VEC_F64, /**< double */
+} VecType;
+
+/**
+ * @brief size in bytes of an element of @p type
+ */
+INLINE static size_t vec_type_size(VecType type)
+{
+   static const size_t sizes[] = {1, 2, 4, 8, 1, 2, 4, 8, 4, 8};
+   return sizes[type];
+}
+
+#define VEC_BORROWED 0x1u /**< @p ptr is not owned (e.g. inline storage), it's never freed */
+#define VEC_MAPPED   0x2u /**< @p ptr is an anonymous mapping (see @p vec_set_mmap_threshold ) */
+
 /**
  * @brief dynamic heap-allocated array
  */
 typedef struct Vec {
-   void  *ptr; /**< underlying data */
-   size_t len; /**< number of usable elements */
-   size_t cap; /**< number of elements for which there is space allocated */
-   size_t size; /**< size of the data type to be held */
-   FreeFn free_fn; /**< if != NULL, free function for elements */
+   void            *ptr; /**< underlying data */
+   size_t           len; /**< number of usable elements */
+   size_t           cap; /**< number of elements for which there is space allocated */
+   size_t           size; /**< size of the data type to be held */
+   FreeFn           free_fn; /**< if != NULL, free function for elements */
+   const Allocator *alloc; /**< source of the memory of @p ptr , NULL for malloc */
+   unsigned         flags; /**< VEC_* flags about the memory of @p ptr */
+   size_t           align; /**< alignment of @p ptr , 0 for the allocator's (see vec_new_aligned) */
 } Vec;
 
+/**
+ * @brief anonymous struct of a Vec with inline storage for @p N elements of type @p T
+ *
+ * the Vec uses the inline storage until it's exceeded, then it spills to the heap.
+ * every vec_* function works on the @p vec member. initialize it with @p smallvec_init
+ *
+ *    SMALLVEC(int, 8) sv;
+ *    smallvec_init(&sv, NULL);
+ *    vec_push(&sv.vec, &elem);
+ *
+ * @note the struct can't be moved/copied while the inline storage is in use
+ */
+#define SMALLVEC(T, N) \
+   struct {            \
+      Vec vec;         \
+      T   buf[N];      \
+   }
+
+/**
+ * @brief initialize the Vec of a @p SMALLVEC on its inline storage
+ *
+ * @param[out] sv pointer to the SMALLVEC
+ * @param[in] free_fn free function for elements, or NULL
+ */
+#define smallvec_init(sv, free_fn)                                                                 \
+   vec_new_inline(                                                                                 \
+      &(sv)->vec,                                                                                  \
+      sizeof((sv)->buf[0]),                                                                        \
+      (sv)->buf,                                                                                   \
+      sizeof((sv)->buf) / sizeof((sv)->buf[0]),                                                    \
+      free_fn                                                                                      \
+   )
+
 /**
  * @brief initialize empty struct
  *
@@ -56,6 +123,46 @@ void vec_new(Vec *v, size_t size, FreeFn free_fn);
  */
 void vec_new_with(Vec *v, size_t size, size_t nelem, FreeFn free_fn);
 
+/**
+ * @brief initialize struct with memory aligned to @p align , and reserve space
+ *
+ * the memory is rounded up to a multiple of @p align , and that padding is part of the capacity,
+ * so SIMD kernels can process the tail with full-width aligned loads past the last element.
+ * the Vec keeps the alignment when it grows or shrinks, every growth is a copy (there's no
+ * aligned realloc). it uses the system allocator (posix_memalign, or _aligned_malloc on Windows)
+ *
+ * @param[out] v Vec
+ * @param[in] size size of the single elements it's going to contain
+ * @param[in] nelem number of elements to reserve memory for
+ * @param[in] align alignment in bytes, a power of 2 up to the page size (e.g. 32, 64, 4096)
+ * @param[in] free_fn free function for elements, or NULL
+ */
+void vec_new_aligned(Vec *v, size_t size, size_t nelem, size_t align, FreeFn free_fn);
+
+/**
+ * @brief initialize empty struct, that takes memory from @p alloc
+ *
+ * @param[out] v Vec
+ * @param[in] size size of the single elements it's going to contain
+ * @param[in] free_fn free function for elements, or NULL
+ * @param[in] alloc allocator, it must outlive the Vec. NULL for malloc
+ */
+void vec_new_in(Vec *v, size_t size, FreeFn free_fn, const Allocator *alloc);
+
+/**
+ * @brief initialize struct on borrowed storage, without allocating
+ *
+ * @p buf is used until more than @p nelem elements are needed, then the elements move to the heap.
+ * it's never freed by the Vec, and it must outlive it (or the spill)
+ *
+ * @param[out] v Vec
+ * @param[in] size size of the single elements it's going to contain
+ * @param[in] buf storage for @p nelem elements, suitably aligned
+ * @param[in] nelem capacity of @p buf
+ * @param[in] free_fn free function for elements, or NULL
+ */
+void vec_new_inline(Vec *v, size_t size, void *buf, size_t nelem, FreeFn free_fn);
+
 /**
  * @brief initialize struct with the content of an array
  *
@@ -72,7 +179,8 @@ void vec_from(Vec *v, size_t size, const void *arr, size_t nelem, FreeFn free_fn
 /**
  * @brief release memory
  *
- * doesn't reset size.
+ * doesn't reset size or alignment. borrowed storage (see @p vec_new_inline ) is left alone,
+ * and the Vec goes back to using the heap.
  * if the single elements own memory, that needs to be release before by the caller
  *
  * @param[in,out] v Vec
@@ -94,8 +202,25 @@ void vec_truncate(Vec *v, size_t new_len);
  *
  * @param[in,out] v Vec
  * @param[in] nelem number of elements to reserve memory for
+ *
+ * @return false if the allocator is out of memory (the Vec is unchanged)
  */
-void vec_reserve(Vec *v, size_t nelem);
+bool vec_reserve(Vec *v, size_t nelem);
+
+/**
+ * @brief back Vecs that grow to @p bytes or more with anonymous memory mappings
+ *
+ * a mapped Vec grows with mremap, which moves the page tables instead of copying the elements,
+ * so growing a big Vec never needs twice its memory. the mappings are marked for transparent
+ * huge pages (MADV_HUGEPAGE), cutting TLB misses on big scans.
+ * only Vecs on the default allocator are mapped, and they stay mapped until freed.
+ * it's process-wide and not synchronized, set it at startup
+ *
+ * @note Linux only, elsewhere it has no effect
+ *
+ * @param[in] bytes threshold, 0 to disable (the default)
+ */
+void vec_set_mmap_threshold(size_t bytes);
 
 /**
  * @brief shrink allocated memory to what is exactly needed for length
@@ -253,6 +378,50 @@ INLINE static bool vec_pop(Vec *v, void *elem)
    return vec_remove_n(v, v->len - 1, elem, 1);
 }
 
+/**
+ * @brief remove element from pos, moving the last one in its place
+ *
+ * O(1), but doesn't keep the order of the elements. see @p vec_remove_n for details
+ *
+ * @param[in,out] v Vec
+ * @param[in] pos index of the element
+ * @param[out] elem if != NULL, on exit it's set with the element removed
+ *
+ * @return false in case of failure
+ */
+bool vec_swap_remove(Vec *v, size_t pos, void *elem);
+
+typedef bool (*VecPredFn)(const void *elem, void *ctx); /**< predicate on elements */
+
+/**
+ * @brief keep only the elements for which @p pred is true, in order
+ *
+ * compacts in a single pass, moving each run of kept elements once.
+ * the elements removed are freed through @p free_fn .
+ * @p pred is called once per element, in order
+ *
+ * @param[in,out] v Vec
+ * @param[in] pred predicate, true to keep the element
+ * @param[in] ctx passed to @p pred
+ *
+ * @return number of elements removed
+ */
+size_t vec_retain(Vec *v, VecPredFn pred, void *ctx);
+
+/**
+ * @brief remove the elements at the positions in @p sorted_idx
+ *
+ * compacts in a single pass, see @p vec_retain
+ *
+ * @param[in,out] v Vec
+ * @param[in] sorted_idx positions of the elements, strictly increasing
+ * @param[in] n number of positions
+ *
+ * @return false if the positions are out of range or not strictly increasing
+ *         (nothing is removed)
+ */
+bool vec_remove_indices(Vec *v, const size_t *sorted_idx, size_t n);
+
 /**
  * @brief if Vec is empty
  *
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "vec_deque.h"
+
+#define MIN_CAP 4
+
+/**
+ * @brief pointer to the slot of the element at @p pos , counting from the front
+ */
+INLINE static char *slot(const VecDeque *dq, size_t pos)
+{
+   return (char *)dq->ptr + ((dq->head + pos) & (dq->cap - 1)) * dq->size;
+}
+
+/**
+ * @brief number of slots from @p pos to the end of the ring buffer, at most @p nelem
+ */
+INLINE static size_t run_len(const VecDeque *dq, size_t pos, size_t nelem)
+{
+   size_t to_end = dq->cap - ((dq->head + pos) & (dq->cap - 1));
+   return nelem < to_end ? nelem : to_end;
+}
+
+/**
+ * @brief copy @p nelem elements from @p src into the slots starting at @p pos (zero them if NULL)
+ */
+static void copy_in(VecDeque *dq, size_t pos, const char *src, size_t nelem)
+{
+   while (nelem) {
+      size_t n = run_len(dq, pos, nelem);
+
+      if (src) {
+         memcpy(slot(dq, pos), src, n * dq->size);
+         src += n * dq->size;
+      }
+      else
+         memset(slot(dq, pos), 0, n * dq->size);
+      pos += n;
+      nelem -= n;
+   }
+}
+
+/**
+ * @brief copy the @p nelem elements starting at @p pos into @p dst
+ */
+static void copy_out(const VecDeque *dq, size_t pos, char *dst, size_t nelem)
+{
+   while (nelem) {
+      size_t n = run_len(dq, pos, nelem);
+
+      memcpy(dst, slot(dq, pos), n * dq->size);
+      dst += n * dq->size;
+      pos += n;
+      nelem -= n;
+   }
+}
+
+/**
+ * @brief free the @p nelem elements starting at @p pos through @p free_fn
+ */
+static void free_elems(VecDeque *dq, size_t pos, size_t nelem)
+{
+   size_t i;
+
+   if (dq->free_fn) {
+      for (i = 0; i < nelem; i++)
+         dq->free_fn(slot(dq, pos + i));
+   }
+}
+
+void vec_deque_new(VecDeque *dq, size_t size, FreeFn free_fn)
+{
+   dq->ptr = NULL;
+   dq->head = dq->len = dq->cap = 0;
+   dq->size = size;
+   dq->free_fn = free_fn;
+   dq->alloc = NULL;
+}
+
+void vec_deque_new_in(VecDeque *dq, size_t size, FreeFn free_fn, const Allocator *alloc)
+{
+   vec_deque_new(dq, size, free_fn);
+   dq->alloc = alloc;
+}
+
+void vec_deque_free(VecDeque *dq)
+{
+   if (dq->cap) {
+      free_elems(dq, 0, dq->len);
+      allocator_free(dq->alloc, dq->ptr, dq->cap * dq->size);
+   }
+   dq->ptr = NULL;
+   dq->head = dq->len = dq->cap = 0;
+}
+
+bool vec_deque_reserve(VecDeque *dq, size_t nelem)
+{
+   size_t old_cap = dq->cap, cap;
+   char  *ptr;
+
+   if (nelem <= old_cap)
+      return true;
+
+   cap = old_cap ? old_cap * 2 : MIN_CAP;
+   while (cap < nelem) {
+      if (cap > SIZE_MAX / 2 / dq->size)
+         return false;
+      cap *= 2;
+   }
+
+   ptr = allocator_realloc(dq->alloc, dq->ptr, old_cap * dq->size, cap * dq->size);
+   if (!ptr)
+      return false;
+
+   /* the elements that wrapped around must be moved, the cap at least doubled so they fit */
+   if (dq->head + dq->len > old_cap) {
+      size_t head_len = old_cap - dq->head;
+      size_t tail_len = dq->len - head_len;
+
+      if (tail_len <= head_len)
+         memcpy(ptr + old_cap * dq->size, ptr, tail_len * dq->size);
+      else {
+         memcpy(ptr + (cap - head_len) * dq->size, ptr + dq->head * dq->size,
+                head_len * dq->size);
+         dq->head = cap - head_len;
+      }
+   }
+
+   dq->ptr = ptr;
+   dq->cap = cap;
+
+   return true;
+}
+
+void vec_deque_slices(const VecDeque *dq, void **first, size_t *first_len, void **second,
+                      size_t *second_len)
+{
+   if (!dq->len) {
+      *first = *second = dq->ptr;
+      *first_len = *second_len = 0;
+      return;
+   }
+
+   *first = slot(dq, 0);
+   *first_len = run_len(dq, 0, dq->len);
+   *second = dq->ptr;
+   *second_len = dq->len - *first_len;
+}
+
+bool vec_deque_push_back_n(VecDeque *dq, const void *elems, size_t nelem)
+{
+   if (!nelem)
+      return true;
+   if (nelem > SIZE_MAX - dq->len || !vec_deque_reserve(dq, dq->len + nelem))
+      return false;
+
+   copy_in(dq, dq->len, elems, nelem);
+   dq->len += nelem;
+
+   return true;
+}
+
+bool vec_deque_push_front_n(VecDeque *dq, const void *elems, size_t nelem)
+{
+   if (!nelem)
+      return true;
+   if (nelem > SIZE_MAX - dq->len || !vec_deque_reserve(dq, dq->len + nelem))
+      return false;
+
+   dq->head = (dq->head - nelem) & (dq->cap - 1);
+   dq->len += nelem;
+   copy_in(dq, 0, elems, nelem);
+
+   return true;
+}
+
+bool vec_deque_pop_front_n(VecDeque *dq, void *elems, size_t nelem)
+{
+   if (nelem > dq->len)
+      return false;
+   if (!nelem)
+      return true;
+
+   if (elems)
+      copy_out(dq, 0, elems, nelem);
+   else
+      free_elems(dq, 0, nelem);
+
+   dq->len -= nelem;
+   /* restart from the beginning when empty, so the next run doesn't wrap */
+   dq->head = dq->len ? (dq->head + nelem) & (dq->cap - 1) : 0;
+
+   return true;
+}
+
+bool vec_deque_pop_back_n(VecDeque *dq, void *elems, size_t nelem)
+{
+   if (nelem > dq->len)
+      return false;
+   if (!nelem)
+      return true;
+
+   if (elems)
+      copy_out(dq, dq->len - nelem, elems, nelem);
+   else
+      free_elems(dq, dq->len - nelem, nelem);
+
+   dq->len -= nelem;
+   if (!dq->len)
+      dq->head = 0;
+
+   return true;
+}
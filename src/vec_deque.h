@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file vec_deque.h
+ */
+#ifndef __VEC_DEQUE_H__
+#define __VEC_DEQUE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "allocator.h"
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief double-ended queue on a growable ring buffer
+ *
+ * O(1) push/pop at both ends, instead of shifting everything like @p vec_insert at 0.
+ * the capacity is a power of two, so positions wrap with a mask. the elements are
+ * contiguous modulo the capacity: at most two slices (see @p vec_deque_slices )
+ */
+typedef struct VecDeque {
+   void            *ptr; /**< ring buffer */
+   size_t           head; /**< index in @p ptr of the first element */
+   size_t           len; /**< number of elements */
+   size_t           cap; /**< size of the ring buffer, 0 or a power of two */
+   size_t           size; /**< size of the data type to be held */
+   FreeFn           free_fn; /**< if != NULL, free function for elements */
+   const Allocator *alloc; /**< source of the memory of @p ptr , NULL for malloc */
+} VecDeque;
+
+/**
+ * @brief initialize empty struct
+ *
+ * @param[out] dq VecDeque
+ * @param[in] size size of the single elements it's going to contain
+ * @param[in] free_fn free function for elements, or NULL
+ */
+void vec_deque_new(VecDeque *dq, size_t size, FreeFn free_fn);
+
+/**
+ * @brief initialize empty struct, taking the memory from @p alloc
+ *
+ * see @p vec_deque_new
+ *
+ * @param[in] alloc allocator, or NULL for malloc
+ */
+void vec_deque_new_in(VecDeque *dq, size_t size, FreeFn free_fn, const Allocator *alloc);
+
+/**
+ * @brief free the elements (through @p free_fn ) and the ring buffer
+ *
+ * @param[in,out] dq VecDeque
+ */
+void vec_deque_free(VecDeque *dq);
+
+/**
+ * @brief reserve space for at least @p nelem elements
+ *
+ * @param[in,out] dq VecDeque
+ * @param[in] nelem number of elements
+ *
+ * @return false in case of failure
+ */
+bool vec_deque_reserve(VecDeque *dq, size_t nelem);
+
+/**
+ * @brief number of elements
+ */
+INLINE static size_t vec_deque_len(const VecDeque *dq)
+{
+   return dq->len;
+}
+
+/**
+ * @brief check if the deque is empty
+ */
+INLINE static bool vec_deque_is_empty(const VecDeque *dq)
+{
+   return dq->len == 0;
+}
+
+/**
+ * @brief get a reference to the element at @p pos , counting from the front
+ *
+ * WARNING: this can be invalidated by insertions
+ *
+ * @param[in] dq VecDeque
+ * @param[in] pos index of the element
+ *
+ * @return pointer to element, or NULL
+ */
+INLINE static void *vec_deque_at(const VecDeque *dq, size_t pos)
+{
+   if (pos < dq->len)
+      return (char *)dq->ptr + ((dq->head + pos) & (dq->cap - 1)) * dq->size;
+   return NULL;
+}
+
+/**
+ * @brief get a reference to the first element, or NULL if empty
+ */
+INLINE static void *vec_deque_front(const VecDeque *dq)
+{
+   return vec_deque_at(dq, 0);
+}
+
+/**
+ * @brief get a reference to the last element, or NULL if empty
+ */
+INLINE static void *vec_deque_back(const VecDeque *dq)
+{
+   return vec_deque_at(dq, dq->len - 1);
+}
+
+/**
+ * @brief the elements as two contiguous slices, the first one followed by the second one
+ *
+ * the second one is empty unless the elements wrap around the end of the ring buffer
+ *
+ * @param[in] dq VecDeque
+ * @param[out] first start of the first slice
+ * @param[out] first_len number of elements of the first slice
+ * @param[out] second start of the second slice
+ * @param[out] second_len number of elements of the second slice
+ */
+void vec_deque_slices(const VecDeque *dq, void **first, size_t *first_len, void **second,
+                      size_t *second_len);
+
+/**
+ * @brief bulk insert at the back through shallow-copy
+ *
+ * @param[in,out] dq VecDeque
+ * @param[in] elems array of elements, they keep their order. if NULL, they are zeroed
+ * @param[in] nelem number of elements of the array
+ *
+ * @return false in case of failure
+ */
+bool vec_deque_push_back_n(VecDeque *dq, const void *elems, size_t nelem);
+
+/**
+ * @brief bulk insert at the front through shallow-copy
+ *
+ * @p elems[0] becomes the first element
+ *
+ * @param[in,out] dq VecDeque
+ * @param[in] elems array of elements, they keep their order. if NULL, they are zeroed
+ * @param[in] nelem number of elements of the array
+ *
+ * @return false in case of failure
+ */
+bool vec_deque_push_front_n(VecDeque *dq, const void *elems, size_t nelem);
+
+/**
+ * @brief bulk remove from the front
+ *
+ * if the element owns memory, that will be freed automatically through @p free_fn
+ * or through @p elems if it's not NULL
+ *
+ * @param[in,out] dq VecDeque
+ * @param[out] elems if != NULL, on exit it's set with the elements removed, in order
+ * @param[in] nelem number of elements to be removed
+ *
+ * @return false if there are less than @p nelem elements (nothing is removed)
+ */
+bool vec_deque_pop_front_n(VecDeque *dq, void *elems, size_t nelem);
+
+/**
+ * @brief bulk remove from the back
+ *
+ * see @p vec_deque_pop_front_n
+ *
+ * @param[out] elems if != NULL, on exit it's set with the elements removed, in order
+ *                   (the last element of the deque is the last one)
+ */
+bool vec_deque_pop_back_n(VecDeque *dq, void *elems, size_t nelem);
+
+/**
+ * @brief insert element at the back through shallow-copy
+ *
+ * @return false in case of failure
+ */
+INLINE static bool vec_deque_push_back(VecDeque *dq, const void *elem)
+{
+   return vec_deque_push_back_n(dq, elem, 1);
+}
+
+/**
+ * @brief insert element at the front through shallow-copy
+ *
+ * @return false in case of failure
+ */
+INLINE static bool vec_deque_push_front(VecDeque *dq, const void *elem)
+{
+   return vec_deque_push_front_n(dq, elem, 1);
+}
+
+/**
+ * @brief remove the first element
+ *
+ * see @p vec_deque_pop_front_n
+ *
+ * @return false if empty
+ */
+INLINE static bool vec_deque_pop_front(VecDeque *dq, void *elem)
+{
+   return vec_deque_pop_front_n(dq, elem, 1);
+}
+
+/**
+ * @brief remove the last element
+ *
+ * see @p vec_deque_pop_back_n
+ *
+ * @return false if empty
+ */
+INLINE static bool vec_deque_pop_back(VecDeque *dq, void *elem)
+{
+   return vec_deque_pop_back_n(dq, elem, 1);
+}
+
+/**
+ * @brief remove all the elements, freeing them through @p free_fn
+ *
+ * doesn't deallocate the ring buffer
+ *
+ * @param[in,out] dq VecDeque
+ */
+INLINE static void vec_deque_clear(VecDeque *dq)
+{
+   vec_deque_pop_front_n(dq, NULL, dq->len);
+}
+
+#endif /* __VEC_DEQUE_H__ */
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+   #define _GNU_SOURCE /* mremap */
+#endif
+
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+   #define VEC_FILE_POSIX
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+#endif
+
+#include "vec_file.h"
+
+#ifdef VEC_FILE_POSIX
+
+/* last byte is the version */
+static const char file_magic[8] = {'C', 'S', 'V', 'E', 'C', 0, 0, 1};
+
+INLINE static VecFileHeader *file_header(VecFile *vf)
+{
+   return vf->map;
+}
+
+INLINE static void *file_elems(VecFile *vf)
+{
+   return (char *)vf->map + VEC_FILE_HEADER_SIZE;
+}
+
+/**
+ * @brief resize the file and its mapping to @p new_size bytes, header included
+ *
+ * @return false if it failed (and nothing changed)
+ */
+static bool file_resize(VecFile *vf, size_t new_size)
+{
+   void *map;
+
+   /* the mapping can't go past the end of the file: grow it first, shrink it last */
+   if (new_size > vf->map_size && ftruncate(vf->fd, (off_t)new_size))
+      return false;
+
+#ifdef __linux__
+   map = mremap(vf->map, vf->map_size, new_size, MREMAP_MAYMOVE);
+#else
+   map = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, vf->fd, 0);
+   if (map != MAP_FAILED)
+      munmap(vf->map, vf->map_size);
+#endif
+
+   if (map == MAP_FAILED) {
+      if (new_size > vf->map_size && ftruncate(vf->fd, (off_t)vf->map_size)) {
+         /* the file is just bigger than it needs to be */
+      }
+      return false;
+   }
+
+   if (new_size < vf->map_size && ftruncate(vf->fd, (off_t)new_size)) {
+      /* same */
+   }
+
+   vf->map = map;
+   vf->map_size = new_size;
+   file_header(vf)->cap = (new_size - VEC_FILE_HEADER_SIZE) / vf->vec.size;
+
+   return true;
+}
+
+static void *file_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+   VecFile *vf = ctx;
+
+   (void)ptr;
+   (void)old_size;
+
+   if (vf->read_only || !file_resize(vf, VEC_FILE_HEADER_SIZE + new_size))
+      return NULL;
+
+   return file_elems(vf);
+}
+
+static void file_free(void *ctx, void *ptr, size_t size)
+{
+   VecFile *vf = ctx;
+
+   (void)ptr;
+   (void)size;
+
+   if (!vf->read_only)
+      file_resize(vf, VEC_FILE_HEADER_SIZE);
+}
+
+bool vec_file_open(VecFile *vf, const char *path, size_t size, unsigned flags)
+{
+   VecFileHeader *hdr;
+   struct stat    st;
+   bool           is_new = false;
+   int            oflags;
+
+   vf->read_only = flags & VEC_FILE_READ_ONLY;
+   oflags = vf->read_only ? O_RDONLY : O_RDWR;
+   if ((flags & VEC_FILE_CREATE) && !vf->read_only)
+      oflags |= O_CREAT;
+
+   vf->fd = open(path, oflags, 0644);
+   if (vf->fd < 0)
+      return false;
+   if (fstat(vf->fd, &st))
+      goto fail_close;
+
+   if (st.st_size == 0 && !vf->read_only) {
+      if (ftruncate(vf->fd, VEC_FILE_HEADER_SIZE))
+         goto fail_close;
+      st.st_size = VEC_FILE_HEADER_SIZE;
+      is_new = true;
+   }
+   if ((size_t)st.st_size < VEC_FILE_HEADER_SIZE)
+      goto fail_close;
+
+   vf->map_size = (size_t)st.st_size;
+   vf->map = mmap(NULL, vf->map_size, vf->read_only ? PROT_READ : PROT_READ | PROT_WRITE,
+                  MAP_SHARED, vf->fd, 0);
+   if (vf->map == MAP_FAILED)
+      goto fail_close;
+
+   hdr = file_header(vf);
+   if (is_new) {
+      memcpy(hdr->magic, file_magic, sizeof(file_magic));
+      hdr->size = size;
+      hdr->len = 0;
+      hdr->cap = 0;
+   }
+   if (memcmp(hdr->magic, file_magic, sizeof(file_magic)) || hdr->size != size ||
+       hdr->len > hdr->cap || hdr->cap > (vf->map_size - VEC_FILE_HEADER_SIZE) / size)
+      goto fail_unmap;
+
+   vf->alloc.realloc_fn = file_realloc;
+   vf->alloc.free_fn = file_free;
+   vf->alloc.ctx = vf;
+
+   vec_new_in(&vf->vec, size, NULL, &vf->alloc);
+   vf->vec.ptr = file_elems(vf);
+   vf->vec.len = hdr->len;
+   /* read-only has no room to spare: adding elements must reserve, and fail */
+   vf->vec.cap = vf->read_only ? hdr->len : hdr->cap;
+
+   return true;
+
+fail_unmap:
+   munmap(vf->map, vf->map_size);
+fail_close:
+   close(vf->fd);
+   return false;
+}
+
+bool vec_file_sync(VecFile *vf)
+{
+   if (vf->read_only)
+      return false;
+
+   file_header(vf)->len = vf->vec.len;
+   return !msync(vf->map, vf->map_size, MS_SYNC);
+}
+
+void vec_file_close(VecFile *vf)
+{
+   if (!vf->read_only)
+      file_header(vf)->len = vf->vec.len;
+
+   munmap(vf->map, vf->map_size);
+   close(vf->fd);
+
+   vf->map = NULL;
+   vf->map_size = 0;
+   vf->fd = -1;
+   vec_new(&vf->vec, vf->vec.size, NULL);
+}
+
+#else
+
+bool vec_file_open(VecFile *vf, const char *path, size_t size, unsigned flags)
+{
+   (void)vf;
+   (void)path;
+   (void)size;
+   (void)flags;
+   return false;
+}
+
+bool vec_file_sync(VecFile *vf)
+{
+   (void)vf;
+   return false;
+}
+
+void vec_file_close(VecFile *vf)
+{
+   (void)vf;
+}
+
+#endif
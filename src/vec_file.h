@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file vec_file.h
+ */
+#ifndef __VEC_FILE_H__
+#define __VEC_FILE_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "allocator.h"
+#include "vec.h"
+
+#define VEC_FILE_CREATE    0x1u /**< create the file if it doesn't exist */
+#define VEC_FILE_READ_ONLY 0x2u /**< map the file read-only, the Vec can't be modified */
+
+#define VEC_FILE_HEADER_SIZE 64 /**< bytes before the elements, so they are well aligned */
+
+/**
+ * @brief header at the start of the file
+ */
+typedef struct VecFileHeader {
+   char     magic[8];
+   uint64_t size; /**< element size */
+   uint64_t len; /**< number of elements, as of the last sync/close */
+   uint64_t cap; /**< number of elements the file has room for */
+} VecFileHeader;
+
+/**
+ * @brief Vec whose elements live in a memory-mapped file
+ *
+ * the file is a small header followed by the elements, and it's mapped shared, so loading
+ * it doesn't read or copy anything: pages are faulted in when touched.
+ * the Vec takes its memory from an allocator that grows the file (ftruncate) and the mapping
+ * (mremap on Linux, unmap and map again elsewhere), so every vec_* function works on
+ * the @p vec member, as long as elements are plain data (no pointers, no free function).
+ *
+ * the length is written to the header by @p vec_file_sync and @p vec_file_close .
+ * the elements are written back by the OS whenever it wants, @p vec_file_sync forces it.
+ * @p vec_free on the Vec empties the file
+ *
+ *    VecFile vf;
+ *    vec_file_open(&vf, "col.bin", sizeof(double), VEC_FILE_CREATE);
+ *    vec_push(&vf.vec, &elem);
+ *    vec_file_close(&vf);
+ *
+ * @note POSIX only, elsewhere @p vec_file_open always fails
+ * @note the struct can't be moved/copied while open, the Vec points to its allocator
+ * @note the file is in the native byte order
+ */
+typedef struct VecFile {
+   Vec       vec; /**< the elements */
+   Allocator alloc; /**< grows the file, given to @p vec */
+   int       fd;
+   void     *map; /**< mapping of the whole file, header included */
+   size_t    map_size;
+   bool      read_only;
+} VecFile;
+
+/**
+ * @brief open (or create) a file and map it
+ *
+ * @param[out] vf VecFile
+ * @param[in] path path of the file
+ * @param[in] size size of the elements, it must match the one in the file
+ * @param[in] flags VEC_FILE_* flags
+ *
+ * @return false if the file can't be opened/mapped, or isn't a Vec of elements of @p size
+ */
+bool vec_file_open(VecFile *vf, const char *path, size_t size, unsigned flags);
+
+/**
+ * @brief write the length to the header, and flush everything to the file (msync)
+ *
+ * @param[in,out] vf VecFile
+ *
+ * @return false if the flush failed, or the file is read-only
+ */
+bool vec_file_sync(VecFile *vf);
+
+/**
+ * @brief write the length to the header, then unmap and close the file
+ *
+ * doesn't flush, the OS writes the pages back later (see @p vec_file_sync )
+ *
+ * @param[in,out] vf VecFile
+ */
+void vec_file_close(VecFile *vf);
+
+#endif /* __VEC_FILE_H__ */
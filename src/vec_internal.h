@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file vec_internal.h
+ *
+ * helpers shared by the kernels over Vec columns (sorting, searching, hashing), so the order
+ * they give to typed keys stays the same.
+ * only for the library's .c files, it's not part of the API
+ */
+#ifndef __VEC_INTERNAL_H__
+#define __VEC_INTERNAL_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+   #define PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+   #define PREFETCH(ptr) ((void)(ptr))
+#endif
+
+// MARK: ordered keys
+
+/**
+ * @brief map the elements to unsigned integers with the same order, or back if @p inverse
+ */
+INLINE static void to_ordered(void *data, size_t n, VecType type, bool inverse)
+{
+   size_t i;
+
+   switch (type) {
+   case VEC_I8: {
+      uint8_t *p = data;
+      for (i = 0; i < n; i++)
+         p[i] ^= 0x80u;
+      break;
+   }
+   case VEC_I16: {
+      uint16_t *p = data;
+      for (i = 0; i < n; i++)
+         p[i] ^= 0x8000u;
+      break;
+   }
+   case VEC_I32: {
+      uint32_t *p = data;
+      for (i = 0; i < n; i++)
+         p[i] ^= 0x80000000u;
+      break;
+   }
+   case VEC_I64: {
+      uint64_t *p = data;
+      for (i = 0; i < n; i++)
+         p[i] ^= 0x8000000000000000ull;
+      break;
+   }
+   case VEC_F32: {
+      uint32_t *p = data;
+      for (i = 0; i < n; i++) {
+         if (!inverse)
+            p[i] = (p[i] >> 31) ? ~p[i] : p[i] | 0x80000000u;
+         else
+            p[i] = (p[i] >> 31) ? p[i] ^ 0x80000000u : ~p[i];
+      }
+      break;
+   }
+   case VEC_F64: {
+      uint64_t *p = data;
+      for (i = 0; i < n; i++) {
+         if (!inverse)
+            p[i] = (p[i] >> 63) ? ~p[i] : p[i] | 0x8000000000000000ull;
+         else
+            p[i] = (p[i] >> 63) ? p[i] ^ 0x8000000000000000ull : ~p[i];
+      }
+      break;
+   }
+   default:
+      break;
+   }
+}
+
+/**
+ * @brief read the key of @p type at @p ptr, mapped to an unsigned integer with the same order
+ * (the same mapping as @p to_ordered )
+ */
+INLINE static uint64_t ordered_key(const void *ptr, VecType type)
+{
+   uint8_t  k8;
+   uint16_t k16;
+   uint32_t k32;
+   uint64_t k64;
+
+   switch (type) {
+   case VEC_U8:
+      memcpy(&k8, ptr, 1);
+      return k8;
+   case VEC_I8:
+      memcpy(&k8, ptr, 1);
+      return k8 ^ 0x80u;
+   case VEC_U16:
+      memcpy(&k16, ptr, 2);
+      return k16;
+   case VEC_I16:
+      memcpy(&k16, ptr, 2);
+      return k16 ^ 0x8000u;
+   case VEC_U32:
+      memcpy(&k32, ptr, 4);
+      return k32;
+   case VEC_I32:
+      memcpy(&k32, ptr, 4);
+      return k32 ^ 0x80000000u;
+   case VEC_F32:
+      memcpy(&k32, ptr, 4);
+      return (k32 >> 31) ? ~k32 : k32 | 0x80000000u;
+   case VEC_U64:
+      memcpy(&k64, ptr, 8);
+      return k64;
+   case VEC_I64:
+      memcpy(&k64, ptr, 8);
+      return k64 ^ 0x8000000000000000ull;
+   default:
+      memcpy(&k64, ptr, 8);
+      return (k64 >> 63) ? ~k64 : k64 | 0x8000000000000000ull;
+   }
+}
+
+#endif /* __VEC_INTERNAL_H__ */
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec_parallel.h"
+
+#define DEFAULT_GRAIN     1024 /**< minimum elements per chunk when the caller gives none */
+#define CHUNKS_PER_THREAD 8 /**< enough to balance the load, few enough to amortize scheduling */
+#define CACHE_LINE        64
+
+/**
+ * @brief how a Vec is split, shared by the tasks
+ */
+typedef struct ParJob {
+   char      *base;
+   size_t     len;
+   size_t     size;
+   size_t     chunk_len; /**< elements per chunk, the last one may have less */
+   size_t     n_chunks;
+   VecChunkFn fn;
+   VecFoldFn  fold_fn;
+   void      *ctx;
+   char      *accs; /**< accumulator of every chunk, each in its own cache lines */
+   size_t     acc_stride;
+} ParJob;
+
+// MARK: helpers
+
+/**
+ * @brief split @p v in chunks of at least @p grain elements, about CHUNKS_PER_THREAD per thread
+ */
+static void split(ParJob *job, const Vec *v, size_t grain, const ThreadPool *pool)
+{
+   size_t n_threads = threadpool_n_threads(pool);
+   size_t target = n_threads > 1 ? n_threads * CHUNKS_PER_THREAD : 1;
+
+   job->base = v->ptr;
+   job->len = v->len;
+   job->size = v->size;
+   job->chunk_len = (v->len + target - 1) / target;
+   if (!grain)
+      grain = DEFAULT_GRAIN;
+   if (job->chunk_len < grain)
+      job->chunk_len = grain;
+   job->n_chunks = (v->len + job->chunk_len - 1) / job->chunk_len;
+}
+
+/**
+ * @brief bounds of chunk @p idx
+ */
+INLINE static void chunk_bounds(const ParJob *job, size_t idx, size_t *beg, size_t *n)
+{
+   *beg = idx * job->chunk_len;
+   *n = job->len - *beg < job->chunk_len ? job->len - *beg : job->chunk_len;
+}
+
+static void for_task(void *ctx, size_t idx)
+{
+   ParJob *job = ctx;
+   size_t  beg, n;
+
+   chunk_bounds(job, idx, &beg, &n);
+   job->fn(job->base + beg * job->size, beg, n, job->ctx);
+}
+
+static void fold_task(void *ctx, size_t idx)
+{
+   ParJob *job = ctx;
+   size_t  beg, n;
+
+   chunk_bounds(job, idx, &beg, &n);
+   job->fold_fn(job->accs + idx * job->acc_stride, job->base + beg * job->size, n, job->ctx);
+}
+
+// MARK: API
+
+void vec_parallel_for(Vec *v, VecChunkFn fn, void *ctx, size_t grain, ThreadPool *pool)
+{
+   ParJob job;
+
+   split(&job, v, grain, pool);
+   job.fn = fn;
+   job.ctx = ctx;
+
+   threadpool_run(pool, for_task, &job, job.n_chunks);
+}
+
+bool vec_parallel_reduce(const Vec *v, void *acc, size_t acc_size, VecFoldFn fold_fn,
+                         VecCombineFn combine_fn, void *ctx, size_t grain, ThreadPool *pool)
+{
+   ParJob job;
+   char  *mem;
+   size_t i;
+
+   split(&job, v, grain, pool);
+
+   /* a single chunk is folded straight into the result */
+   if (job.n_chunks <= 1) {
+      if (job.n_chunks)
+         fold_fn(acc, job.base, job.len, ctx);
+      return true;
+   }
+
+   /* the accumulators are padded, so the folds don't write to the same cache lines */
+   job.acc_stride = (acc_size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+   mem = malloc(job.n_chunks * job.acc_stride + CACHE_LINE);
+   if (!mem)
+      return false;
+   job.accs = mem + (CACHE_LINE - (uintptr_t)mem % CACHE_LINE) % CACHE_LINE;
+   for (i = 0; i < job.n_chunks; i++)
+      memcpy(job.accs + i * job.acc_stride, acc, acc_size);
+   job.fold_fn = fold_fn;
+   job.ctx = ctx;
+
+   threadpool_run(pool, fold_task, &job, job.n_chunks);
+
+   for (i = 0; i < job.n_chunks; i++)
+      combine_fn(acc, job.accs + i * job.acc_stride, ctx);
+
+   free(mem);
+
+   return true;
+}
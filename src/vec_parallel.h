@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file vec_parallel.h
+ */
+#ifndef __VEC_PARALLEL_H__
+#define __VEC_PARALLEL_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "threadpool.h"
+#include "vec.h"
+
+/**
+ * @brief work on a chunk of consecutive elements
+ *
+ * @param[in,out] elems first element of the chunk
+ * @param[in] pos position of @p elems in the Vec
+ * @param[in] n number of elements in the chunk
+ * @param[in,out] ctx context given to @p vec_parallel_for
+ */
+typedef void (*VecChunkFn)(void *elems, size_t pos, size_t n, void *ctx);
+
+/**
+ * @brief fold a chunk of consecutive elements into @p acc
+ *
+ * @param[in,out] acc accumulator of the chunk, starts as a copy of the identity
+ * @param[in] elems first element of the chunk
+ * @param[in] n number of elements in the chunk
+ * @param[in,out] ctx context given to @p vec_parallel_reduce
+ */
+typedef void (*VecFoldFn)(void *acc, const void *elems, size_t n, void *ctx);
+
+/**
+ * @brief combine the accumulator of a chunk, @p other , into @p acc
+ */
+typedef void (*VecCombineFn)(void *acc, const void *other, void *ctx);
+
+/**
+ * @brief call @p fn on chunks covering all the elements, using the threads of @p pool
+ *
+ * the Vec is split in chunks of at least @p grain elements, and about 8 per thread, so the
+ * threads that finish early take the chunks left (see @p threadpool_run ).
+ * @p fn gets whole chunks, so its inner loop can be vectorized
+ *
+ * @param[in,out] v Vec
+ * @param[in] fn function to run on every chunk. chunks run concurrently, on disjoint elements
+ * @param[in,out] ctx passed to @p fn
+ * @param[in] grain minimum elements per chunk, 0 for a default (e.g. when @p fn is cheap
+ *            per element, a bigger grain amortizes the scheduling)
+ * @param[in,out] pool ThreadPool, or NULL to run on the calling thread
+ */
+void vec_parallel_for(Vec *v, VecChunkFn fn, void *ctx, size_t grain, ThreadPool *pool);
+
+/**
+ * @brief reduce the elements to a single value, using the threads of @p pool
+ *
+ * every chunk (see @p vec_parallel_for ) is folded in its own accumulator, then the
+ * accumulators are combined in order. the chunks depend on @p grain and on the number of
+ * threads of @p pool , so the result is deterministic for a given grain and thread count
+ * (it may change with either, e.g. for floating point sums). @p fold_fn and @p combine_fn
+ * must be associative, they don't have to be commutative
+ *
+ * @param[in] v Vec
+ * @param[in,out] acc accumulator: holds the identity of the reduction on input, and the
+ *                result on output
+ * @param[in] acc_size size of @p acc
+ * @param[in] fold_fn folds a chunk of elements in an accumulator
+ * @param[in] combine_fn combines two accumulators
+ * @param[in,out] ctx passed to @p fold_fn and @p combine_fn
+ * @param[in] grain minimum elements per chunk, 0 for a default
+ * @param[in,out] pool ThreadPool, or NULL to run on the calling thread
+ *
+ * @return false in case of failure (the accumulators could not be allocated)
+ */
+bool vec_parallel_reduce(const Vec *v, void *acc, size_t acc_size, VecFoldFn fold_fn,
+                         VecCombineFn combine_fn, void *ctx, size_t grain, ThreadPool *pool);
+
+#endif /* __VEC_PARALLEL_H__ */
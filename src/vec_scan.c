@@ -0,0 +1,818 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "vec_scan.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+   #define SCAN_X86
+   #include <immintrin.h>
+
+   #define TARGET(isa)   __attribute__((target(isa)))
+   #define ALWAYS_INLINE __attribute__((always_inline)) inline
+#endif
+
+#define SCAN_BUF 256 /**< selected positions buffered before being appended to the outputs */
+
+static VecScanIsa isa_limit = VEC_SCAN_AVX2;
+
+/**
+ * @brief best instruction set supported by the CPU
+ */
+static VecScanIsa isa_supported(void)
+{
+#ifdef SCAN_X86
+   if (__builtin_cpu_supports("avx2"))
+      return VEC_SCAN_AVX2;
+   if (__builtin_cpu_supports("sse2"))
+      return VEC_SCAN_SSE2;
+#endif
+   return VEC_SCAN_SCALAR;
+}
+
+VecScanIsa vec_scan_isa(void)
+{
+   VecScanIsa isa = isa_supported();
+
+   return isa < isa_limit ? isa : isa_limit;
+}
+
+VecScanIsa vec_scan_set_isa(VecScanIsa isa)
+{
+   isa_limit = isa;
+   return vec_scan_isa();
+}
+
+INLINE static unsigned size_log2(size_t size)
+{
+   unsigned log = 0;
+
+   for (; size > 1; size >>= 1)
+      log++;
+
+   return log;
+}
+
+// MARK: Output
+
+/**
+ * @brief buffers the positions selected by a filter, and appends them to the outputs
+ */
+typedef struct Emitter {
+   const Vec *v; /**< Vec being filtered */
+   Vec       *out_idx;
+   Vec       *out_vals;
+   size_t     buf[SCAN_BUF];
+   size_t     n_buf;
+   size_t     total; /**< positions flushed so far */
+} Emitter;
+
+static void emitter_flush(Emitter *em)
+{
+   size_t i;
+
+   if (!em->n_buf)
+      return;
+
+   if (em->out_idx)
+      vec_insert_n(em->out_idx, em->out_idx->len, em->buf, em->n_buf);
+
+   if (em->out_vals && vec_reserve(em->out_vals, em->out_vals->len + em->n_buf)) {
+      size_t size = em->v->size;
+      char  *dst = (char *)em->out_vals->ptr + em->out_vals->len * size;
+
+      for (i = 0; i < em->n_buf; i++)
+         memcpy(dst + i * size, (const char *)em->v->ptr + em->buf[i] * size, size);
+      em->out_vals->len += em->n_buf;
+   }
+
+   em->total += em->n_buf;
+   em->n_buf = 0;
+}
+
+INLINE static void emit(Emitter *em, size_t idx)
+{
+   em->buf[em->n_buf++] = idx;
+   if (em->n_buf == SCAN_BUF)
+      emitter_flush(em);
+}
+
+// MARK: Scalar
+
+#define SCALAR_FIND(T)                                                                             \
+   do {                                                                                            \
+      T k;                                                                                         \
+                                                                                                   \
+      memcpy(&k, key, sizeof(T));                                                                  \
+      for (; i < len; i++) {                                                                       \
+         if (((const T *)p)[i] == k)                                                               \
+            return i;                                                                              \
+      }                                                                                            \
+      return len;                                                                                  \
+   } while (0)
+
+/**
+ * @brief position of the first element equal to @p key , starting from @p i
+ */
+static size_t find_scalar(const char *p, size_t len, size_t size, const void *key, size_t i)
+{
+   switch (size) {
+   case 1:
+      SCALAR_FIND(uint8_t);
+   case 2:
+      SCALAR_FIND(uint16_t);
+   case 4:
+      SCALAR_FIND(uint32_t);
+   case 8:
+      SCALAR_FIND(uint64_t);
+   default:
+      for (; i < len; i++) {
+         if (!memcmp(p + i * size, key, size))
+            return i;
+      }
+      return len;
+   }
+}
+
+#define SCALAR_COUNT(T)                                                                            \
+   do {                                                                                            \
+      T k;                                                                                         \
+                                                                                                   \
+      memcpy(&k, key, sizeof(T));                                                                  \
+      for (; i < len; i++)                                                                         \
+         count += ((const T *)p)[i] == k;                                                          \
+   } while (0)
+
+/**
+ * @brief number of elements equal to @p key , starting from @p i
+ */
+static size_t count_scalar(const char *p, size_t len, size_t size, const void *key, size_t i)
+{
+   size_t count = 0;
+
+   switch (size) {
+   case 1:
+      SCALAR_COUNT(uint8_t);
+      break;
+   case 2:
+      SCALAR_COUNT(uint16_t);
+      break;
+   case 4:
+      SCALAR_COUNT(uint32_t);
+      break;
+   case 8:
+      SCALAR_COUNT(uint64_t);
+      break;
+   default:
+      for (; i < len; i++)
+         count += !memcmp(p + i * size, key, size);
+      break;
+   }
+
+   return count;
+}
+
+#define SCALAR_FILTER(T)                                                                           \
+   do {                                                                                            \
+      T l, h, x;                                                                                   \
+                                                                                                   \
+      memcpy(&l, lo, sizeof(T));                                                                   \
+      memcpy(&h, hi, sizeof(T));                                                                   \
+      for (; i < len; i++) {                                                                       \
+         x = ((const T *)p)[i];                                                                    \
+         if (x >= l && x <= h)                                                                     \
+            emit(em, i);                                                                           \
+      }                                                                                            \
+   } while (0)
+
+/**
+ * @brief select the elements in [ @p lo, @p hi ], starting from @p i
+ */
+static void filter_scalar(const char *p, size_t len, VecType type, const void *lo, const void *hi,
+                          Emitter *em, size_t i)
+{
+   switch (type) {
+   case VEC_U8:
+      SCALAR_FILTER(uint8_t);
+      break;
+   case VEC_U16:
+      SCALAR_FILTER(uint16_t);
+      break;
+   case VEC_U32:
+      SCALAR_FILTER(uint32_t);
+      break;
+   case VEC_U64:
+      SCALAR_FILTER(uint64_t);
+      break;
+   case VEC_I8:
+      SCALAR_FILTER(int8_t);
+      break;
+   case VEC_I16:
+      SCALAR_FILTER(int16_t);
+      break;
+   case VEC_I32:
+      SCALAR_FILTER(int32_t);
+      break;
+   case VEC_I64:
+      SCALAR_FILTER(int64_t);
+      break;
+   case VEC_F32:
+      SCALAR_FILTER(float);
+      break;
+   case VEC_F64:
+      SCALAR_FILTER(double);
+      break;
+   }
+}
+
+#ifdef SCAN_X86
+
+// MARK: SIMD
+
+/*
+ * every kernel compares a whole register and reduces it to a mask with one bit per byte
+ * (movemask_epi8), so an element of n bytes sets n bits. the same mask handling then works
+ * for every element size: counts are divided by the size, and positions are byte offsets
+ * shifted right by log2(size)
+ */
+
+/**
+ * @brief bits set in @p x . not __builtin_popcount , that's a library call without POPCNT
+ */
+INLINE static unsigned popcount32(uint32_t x)
+{
+   x = x - ((x >> 1) & 0x55555555u);
+   x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+   x = (x + (x >> 4)) & 0x0f0f0f0fu;
+   return (x * 0x01010101u) >> 24;
+}
+
+/**
+ * @brief emit the elements whose bits are set in @p mask
+ *
+ * @param[in] byte_off offset of the block in the Vec's buffer
+ * @param[in] shift log2 of the element size
+ */
+INLINE static void emit_mask(Emitter *em, uint32_t mask, size_t byte_off, unsigned shift)
+{
+   uint32_t elem_bits = (1u << (1u << shift)) - 1;
+
+   while (mask) {
+      unsigned bit = (unsigned)__builtin_ctz(mask);
+
+      emit(em, (byte_off + bit) >> shift);
+      mask &= ~(elem_bits << bit);
+   }
+}
+
+/**
+ * @brief lo and hi as raw integers of the element size, with the sign bit flipped for unsigned
+ * types, so that a signed comparison orders them right (@p flip is what to xor elements with)
+ */
+static void int_bounds(VecType type, const void *lo, const void *hi, uint64_t *l, uint64_t *h,
+                       uint64_t *flip)
+{
+   size_t size = vec_type_size(type);
+   bool   is_unsigned = type == VEC_U8 || type == VEC_U16 || type == VEC_U32 || type == VEC_U64;
+
+   *l = 0;
+   *h = 0;
+   memcpy(l, lo, size); /* little endian, like every x86 */
+   memcpy(h, hi, size);
+   *flip = is_unsigned ? (uint64_t)1 << (size * 8 - 1) : 0;
+   *l ^= *flip;
+   *h ^= *flip;
+}
+
+/* SSE2 */
+
+TARGET("sse2") static ALWAYS_INLINE __m128i splat_sse2(uint64_t x, size_t size)
+{
+   switch (size) {
+   case 1:
+      return _mm_set1_epi8((char)x);
+   case 2:
+      return _mm_set1_epi16((short)x);
+   case 4:
+      return _mm_set1_epi32((int)x);
+   default:
+      return _mm_set1_epi64x((long long)x);
+   }
+}
+
+TARGET("sse2") static ALWAYS_INLINE uint32_t eq_mask_sse2(__m128i x, __m128i k, size_t size)
+{
+   __m128i eq;
+
+   switch (size) {
+   case 1:
+      eq = _mm_cmpeq_epi8(x, k);
+      break;
+   case 2:
+      eq = _mm_cmpeq_epi16(x, k);
+      break;
+   case 4:
+      eq = _mm_cmpeq_epi32(x, k);
+      break;
+   default:
+      /* no 64 bit compare in SSE2: both halves must be equal */
+      eq = _mm_cmpeq_epi32(x, k);
+      eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+      break;
+   }
+
+   return (uint32_t)_mm_movemask_epi8(eq);
+}
+
+/**
+ * @brief bytes of the elements in [ @p l, @p h ] (signed comparison, after xor with @p flip )
+ */
+TARGET("sse2") static ALWAYS_INLINE uint32_t
+in_mask_sse2(__m128i x, __m128i l, __m128i h, __m128i flip, size_t size)
+{
+   __m128i out;
+
+   x = _mm_xor_si128(x, flip);
+   switch (size) {
+   case 1:
+      out = _mm_or_si128(_mm_cmpgt_epi8(l, x), _mm_cmpgt_epi8(x, h));
+      break;
+   case 2:
+      out = _mm_or_si128(_mm_cmpgt_epi16(l, x), _mm_cmpgt_epi16(x, h));
+      break;
+   default:
+      out = _mm_or_si128(_mm_cmpgt_epi32(l, x), _mm_cmpgt_epi32(x, h));
+      break;
+   }
+
+   return ~(uint32_t)_mm_movemask_epi8(out) & 0xffffu;
+}
+
+/**
+ * @brief find in whole blocks, the rest is left to the scalar loop
+ *
+ * @param[out] done elements checked
+ *
+ * @return position of the element, or @p len if not found (yet)
+ */
+TARGET("sse2") static ALWAYS_INLINE size_t
+find_blocks_sse2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   uint64_t k = 0;
+   __m128i  kv;
+   size_t   n_bytes = len * size, i;
+
+   memcpy(&k, key, size);
+   kv = splat_sse2(k, size);
+
+   for (i = 0; i + 16 <= n_bytes; i += 16) {
+      uint32_t mask = eq_mask_sse2(_mm_loadu_si128((const __m128i *)(p + i)), kv, size);
+
+      if (mask)
+         return (i + (size_t)__builtin_ctz(mask)) / size;
+   }
+
+   *done = i / size;
+   return len;
+}
+
+TARGET("sse2") static ALWAYS_INLINE size_t
+count_blocks_sse2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   uint64_t k = 0;
+   __m128i  kv;
+   size_t   n_bytes = len * size, i, bits = 0;
+
+   memcpy(&k, key, size);
+   kv = splat_sse2(k, size);
+
+   for (i = 0; i + 16 <= n_bytes; i += 16)
+      bits += popcount32(eq_mask_sse2(_mm_loadu_si128((const __m128i *)(p + i)), kv, size));
+
+   *done = i / size;
+   return bits / size;
+}
+
+TARGET("sse2") static size_t
+find_sse2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   switch (size) {
+   case 1:
+      return find_blocks_sse2(p, len, 1, key, done);
+   case 2:
+      return find_blocks_sse2(p, len, 2, key, done);
+   case 4:
+      return find_blocks_sse2(p, len, 4, key, done);
+   default:
+      return find_blocks_sse2(p, len, 8, key, done);
+   }
+}
+
+TARGET("sse2") static size_t
+count_sse2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   switch (size) {
+   case 1:
+      return count_blocks_sse2(p, len, 1, key, done);
+   case 2:
+      return count_blocks_sse2(p, len, 2, key, done);
+   case 4:
+      return count_blocks_sse2(p, len, 4, key, done);
+   default:
+      return count_blocks_sse2(p, len, 8, key, done);
+   }
+}
+
+/**
+ * @brief filter whole blocks, the rest is left to the scalar loop
+ *
+ * @return elements checked
+ */
+TARGET("sse2") static size_t
+filter_sse2(const char *p, size_t len, VecType type, const void *lo, const void *hi, Emitter *em)
+{
+   size_t   size = vec_type_size(type), n_bytes = len * size, i = 0;
+   unsigned shift = size_log2(size);
+
+   if (type == VEC_F32) {
+      float  l, h;
+      __m128 lv, hv;
+
+      memcpy(&l, lo, sizeof(l));
+      memcpy(&h, hi, sizeof(h));
+      lv = _mm_set1_ps(l);
+      hv = _mm_set1_ps(h);
+      for (; i + 16 <= n_bytes; i += 16) {
+         __m128 x = _mm_loadu_ps((const float *)(p + i));
+         __m128 in = _mm_and_ps(_mm_cmpge_ps(x, lv), _mm_cmple_ps(x, hv));
+
+         emit_mask(em, (uint32_t)_mm_movemask_epi8(_mm_castps_si128(in)), i, shift);
+      }
+   }
+   else if (type == VEC_F64) {
+      double  l, h;
+      __m128d lv, hv;
+
+      memcpy(&l, lo, sizeof(l));
+      memcpy(&h, hi, sizeof(h));
+      lv = _mm_set1_pd(l);
+      hv = _mm_set1_pd(h);
+      for (; i + 16 <= n_bytes; i += 16) {
+         __m128d x = _mm_loadu_pd((const double *)(p + i));
+         __m128d in = _mm_and_pd(_mm_cmpge_pd(x, lv), _mm_cmple_pd(x, hv));
+
+         emit_mask(em, (uint32_t)_mm_movemask_epi8(_mm_castpd_si128(in)), i, shift);
+      }
+   }
+   else if (size < 8) {
+      uint64_t l, h, flip;
+      __m128i  lv, hv, fv;
+
+      /* no 64 bit compare in SSE2, those are left to the scalar loop */
+      int_bounds(type, lo, hi, &l, &h, &flip);
+      lv = splat_sse2(l, size);
+      hv = splat_sse2(h, size);
+      fv = splat_sse2(flip, size);
+
+      switch (size) {
+      case 1:
+         for (; i + 16 <= n_bytes; i += 16)
+            emit_mask(em, in_mask_sse2(_mm_loadu_si128((const __m128i *)(p + i)), lv, hv, fv, 1),
+                      i, shift);
+         break;
+      case 2:
+         for (; i + 16 <= n_bytes; i += 16)
+            emit_mask(em, in_mask_sse2(_mm_loadu_si128((const __m128i *)(p + i)), lv, hv, fv, 2),
+                      i, shift);
+         break;
+      default:
+         for (; i + 16 <= n_bytes; i += 16)
+            emit_mask(em, in_mask_sse2(_mm_loadu_si128((const __m128i *)(p + i)), lv, hv, fv, 4),
+                      i, shift);
+         break;
+      }
+   }
+
+   return i >> shift;
+}
+
+/* AVX2 */
+
+TARGET("avx2,popcnt") static ALWAYS_INLINE __m256i splat_avx2(uint64_t x, size_t size)
+{
+   switch (size) {
+   case 1:
+      return _mm256_set1_epi8((char)x);
+   case 2:
+      return _mm256_set1_epi16((short)x);
+   case 4:
+      return _mm256_set1_epi32((int)x);
+   default:
+      return _mm256_set1_epi64x((long long)x);
+   }
+}
+
+TARGET("avx2,popcnt") static ALWAYS_INLINE uint32_t
+eq_mask_avx2(__m256i x, __m256i k, size_t size)
+{
+   __m256i eq;
+
+   switch (size) {
+   case 1:
+      eq = _mm256_cmpeq_epi8(x, k);
+      break;
+   case 2:
+      eq = _mm256_cmpeq_epi16(x, k);
+      break;
+   case 4:
+      eq = _mm256_cmpeq_epi32(x, k);
+      break;
+   default:
+      eq = _mm256_cmpeq_epi64(x, k);
+      break;
+   }
+
+   return (uint32_t)_mm256_movemask_epi8(eq);
+}
+
+TARGET("avx2,popcnt") static ALWAYS_INLINE uint32_t
+in_mask_avx2(__m256i x, __m256i l, __m256i h, __m256i flip, size_t size)
+{
+   __m256i out;
+
+   x = _mm256_xor_si256(x, flip);
+   switch (size) {
+   case 1:
+      out = _mm256_or_si256(_mm256_cmpgt_epi8(l, x), _mm256_cmpgt_epi8(x, h));
+      break;
+   case 2:
+      out = _mm256_or_si256(_mm256_cmpgt_epi16(l, x), _mm256_cmpgt_epi16(x, h));
+      break;
+   case 4:
+      out = _mm256_or_si256(_mm256_cmpgt_epi32(l, x), _mm256_cmpgt_epi32(x, h));
+      break;
+   default:
+      out = _mm256_or_si256(_mm256_cmpgt_epi64(l, x), _mm256_cmpgt_epi64(x, h));
+      break;
+   }
+
+   return ~(uint32_t)_mm256_movemask_epi8(out);
+}
+
+TARGET("avx2,popcnt") static ALWAYS_INLINE size_t
+find_blocks_avx2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   uint64_t k = 0;
+   __m256i  kv;
+   size_t   n_bytes = len * size, i;
+
+   memcpy(&k, key, size);
+   kv = splat_avx2(k, size);
+
+   /* two registers per iteration, with a single test for both */
+   for (i = 0; i + 64 <= n_bytes; i += 64) {
+      __m256i x1 = _mm256_loadu_si256((const __m256i *)(p + i));
+      __m256i x2 = _mm256_loadu_si256((const __m256i *)(p + i + 32));
+      uint32_t mask1 = eq_mask_avx2(x1, kv, size);
+      uint32_t mask2 = eq_mask_avx2(x2, kv, size);
+
+      if (mask1 | mask2) {
+         if (mask1)
+            return (i + (size_t)__builtin_ctz(mask1)) / size;
+         return (i + 32 + (size_t)__builtin_ctz(mask2)) / size;
+      }
+   }
+   for (; i + 32 <= n_bytes; i += 32) {
+      uint32_t mask = eq_mask_avx2(_mm256_loadu_si256((const __m256i *)(p + i)), kv, size);
+
+      if (mask)
+         return (i + (size_t)__builtin_ctz(mask)) / size;
+   }
+
+   *done = i / size;
+   return len;
+}
+
+TARGET("avx2,popcnt") static ALWAYS_INLINE size_t
+count_blocks_avx2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   uint64_t k = 0;
+   __m256i  kv;
+   size_t   n_bytes = len * size, i, bits = 0;
+
+   memcpy(&k, key, size);
+   kv = splat_avx2(k, size);
+
+   for (i = 0; i + 32 <= n_bytes; i += 32)
+      bits += (size_t)__builtin_popcount(
+         eq_mask_avx2(_mm256_loadu_si256((const __m256i *)(p + i)), kv, size));
+
+   *done = i / size;
+   return bits / size;
+}
+
+TARGET("avx2,popcnt") static size_t
+find_avx2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   switch (size) {
+   case 1:
+      return find_blocks_avx2(p, len, 1, key, done);
+   case 2:
+      return find_blocks_avx2(p, len, 2, key, done);
+   case 4:
+      return find_blocks_avx2(p, len, 4, key, done);
+   default:
+      return find_blocks_avx2(p, len, 8, key, done);
+   }
+}
+
+TARGET("avx2,popcnt") static size_t
+count_avx2(const char *p, size_t len, size_t size, const void *key, size_t *done)
+{
+   switch (size) {
+   case 1:
+      return count_blocks_avx2(p, len, 1, key, done);
+   case 2:
+      return count_blocks_avx2(p, len, 2, key, done);
+   case 4:
+      return count_blocks_avx2(p, len, 4, key, done);
+   default:
+      return count_blocks_avx2(p, len, 8, key, done);
+   }
+}
+
+TARGET("avx2,popcnt") static size_t
+filter_avx2(const char *p, size_t len, VecType type, const void *lo, const void *hi, Emitter *em)
+{
+   size_t   size = vec_type_size(type), n_bytes = len * size, i = 0;
+   unsigned shift = size_log2(size);
+
+   if (type == VEC_F32) {
+      float  l, h;
+      __m256 lv, hv;
+
+      memcpy(&l, lo, sizeof(l));
+      memcpy(&h, hi, sizeof(h));
+      lv = _mm256_set1_ps(l);
+      hv = _mm256_set1_ps(h);
+      for (; i + 32 <= n_bytes; i += 32) {
+         __m256 x = _mm256_loadu_ps((const float *)(p + i));
+         __m256 in =
+            _mm256_and_ps(_mm256_cmp_ps(x, lv, _CMP_GE_OQ), _mm256_cmp_ps(x, hv, _CMP_LE_OQ));
+
+         emit_mask(em, (uint32_t)_mm256_movemask_epi8(_mm256_castps_si256(in)), i, shift);
+      }
+   }
+   else if (type == VEC_F64) {
+      double  l, h;
+      __m256d lv, hv;
+
+      memcpy(&l, lo, sizeof(l));
+      memcpy(&h, hi, sizeof(h));
+      lv = _mm256_set1_pd(l);
+      hv = _mm256_set1_pd(h);
+      for (; i + 32 <= n_bytes; i += 32) {
+         __m256d x = _mm256_loadu_pd((const double *)(p + i));
+         __m256d in =
+            _mm256_and_pd(_mm256_cmp_pd(x, lv, _CMP_GE_OQ), _mm256_cmp_pd(x, hv, _CMP_LE_OQ));
+
+         emit_mask(em, (uint32_t)_mm256_movemask_epi8(_mm256_castpd_si256(in)), i, shift);
+      }
+   }
+   else {
+      uint64_t l, h, flip;
+      __m256i  lv, hv, fv;
+
+      int_bounds(type, lo, hi, &l, &h, &flip);
+      lv = splat_avx2(l, size);
+      hv = splat_avx2(h, size);
+      fv = splat_avx2(flip, size);
+
+      switch (size) {
+      case 1:
+         for (; i + 32 <= n_bytes; i += 32)
+            emit_mask(em, in_mask_avx2(_mm256_loadu_si256((const __m256i *)(p + i)), lv, hv, fv, 1),
+                      i, shift);
+         break;
+      case 2:
+         for (; i + 32 <= n_bytes; i += 32)
+            emit_mask(em, in_mask_avx2(_mm256_loadu_si256((const __m256i *)(p + i)), lv, hv, fv, 2),
+                      i, shift);
+         break;
+      case 4:
+         for (; i + 32 <= n_bytes; i += 32)
+            emit_mask(em, in_mask_avx2(_mm256_loadu_si256((const __m256i *)(p + i)), lv, hv, fv, 4),
+                      i, shift);
+         break;
+      default:
+         for (; i + 32 <= n_bytes; i += 32)
+            emit_mask(em, in_mask_avx2(_mm256_loadu_si256((const __m256i *)(p + i)), lv, hv, fv, 8),
+                      i, shift);
+         break;
+      }
+   }
+
+   return i >> shift;
+}
+
+#endif /* SCAN_X86 */
+
+// MARK: API
+
+/**
+ * @brief if the SIMD kernels handle elements of @p size
+ */
+INLINE static bool simd_size(size_t size)
+{
+   return size == 1 || size == 2 || size == 4 || size == 8;
+}
+
+size_t vec_find(const Vec *v, const void *key)
+{
+   size_t done = 0;
+
+#ifdef SCAN_X86
+   if (simd_size(v->size)) {
+      size_t pos = v->len;
+
+      switch (vec_scan_isa()) {
+      case VEC_SCAN_AVX2:
+         pos = find_avx2(v->ptr, v->len, v->size, key, &done);
+         break;
+      case VEC_SCAN_SSE2:
+         pos = find_sse2(v->ptr, v->len, v->size, key, &done);
+         break;
+      default:
+         break;
+      }
+      if (pos < v->len)
+         return pos;
+   }
+#endif
+
+   return find_scalar(v->ptr, v->len, v->size, key, done);
+}
+
+size_t vec_count(const Vec *v, const void *key)
+{
+   size_t done = 0, count = 0;
+
+#ifdef SCAN_X86
+   if (simd_size(v->size)) {
+      switch (vec_scan_isa()) {
+      case VEC_SCAN_AVX2:
+         count = count_avx2(v->ptr, v->len, v->size, key, &done);
+         break;
+      case VEC_SCAN_SSE2:
+         count = count_sse2(v->ptr, v->len, v->size, key, &done);
+         break;
+      default:
+         break;
+      }
+   }
+#endif
+
+   return count + count_scalar(v->ptr, v->len, v->size, key, done);
+}
+
+size_t vec_filter_range(const Vec *v, VecType type, const void *lo, const void *hi, Vec *out_idx,
+                        Vec *out_vals)
+{
+   Emitter em;
+   size_t  done = 0;
+
+   assert(v->size == vec_type_size(type));
+   assert(!out_idx || out_idx->size == sizeof(size_t));
+   assert(!out_vals || out_vals->size == v->size);
+
+   em.v = v;
+   em.out_idx = out_idx;
+   em.out_vals = out_vals;
+   em.n_buf = 0;
+   em.total = 0;
+
+#ifdef SCAN_X86
+   switch (vec_scan_isa()) {
+   case VEC_SCAN_AVX2:
+      done = filter_avx2(v->ptr, v->len, type, lo, hi, &em);
+      break;
+   case VEC_SCAN_SSE2:
+      done = filter_sse2(v->ptr, v->len, type, lo, hi, &em);
+      break;
+   default:
+      break;
+   }
+#endif
+
+   filter_scalar(v->ptr, v->len, type, lo, hi, &em, done);
+   emitter_flush(&em);
+
+   return em.total;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file vec_scan.h
+ */
+#ifndef __VEC_SCAN_H__
+#define __VEC_SCAN_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "vec.h"
+
+/**
+ * @brief instruction sets the scans can use
+ *
+ * the best one supported by the CPU is detected on the first scan. SIMD is only available
+ * when compiling with GCC or Clang for x86, everything else uses the scalar loops
+ */
+typedef enum VecScanIsa {
+   VEC_SCAN_SCALAR,
+   VEC_SCAN_SSE2,
+   VEC_SCAN_AVX2,
+} VecScanIsa;
+
+/**
+ * @brief instruction set in use
+ */
+VecScanIsa vec_scan_isa(void);
+
+/**
+ * @brief use @p isa , or the best supported one below it. mostly for tests and benchmarks
+ *
+ * @return instruction set actually in use
+ */
+VecScanIsa vec_scan_set_isa(VecScanIsa isa);
+
+/**
+ * @brief position of the first element equal to @p key
+ *
+ * elements are compared bytewise, so for floats -0 != +0 and a NaN can be found.
+ * elements of 1, 2, 4 and 8 bytes are compared a whole SIMD register at a time
+ *
+ * @param[in] v Vec
+ * @param[in] key element to find
+ *
+ * @return position of the element, or the length of the Vec if not found
+ */
+size_t vec_find(const Vec *v, const void *key);
+
+/**
+ * @brief number of elements equal to @p key
+ *
+ * see @p vec_find for how elements are compared
+ *
+ * @param[in] v Vec
+ * @param[in] key element to count
+ *
+ * @return number of equal elements
+ */
+size_t vec_count(const Vec *v, const void *key);
+
+/**
+ * @brief select the elements in [ @p lo, @p hi ]
+ *
+ * elements are compared as numbers of @p type (NaNs are never selected).
+ * the positions of the selected elements and/or the elements themselves are appended to
+ * @p out_idx and @p out_vals
+ *
+ * @param[in] v Vec of elements of @p type
+ * @param[in] type type of the elements, its size must match
+ * @param[in] lo pointer to the smallest value selected, of @p type
+ * @param[in] hi pointer to the biggest value selected, of @p type
+ * @param[in,out] out_idx optional, Vec of size_t, positions of the elements selected
+ * @param[in,out] out_vals optional, Vec of elements of @p type , elements selected
+ *
+ * @return number of elements selected
+ */
+size_t vec_filter_range(const Vec *v, VecType type, const void *lo, const void *hi, Vec *out_idx,
+                        Vec *out_vals);
+
+#endif /* __VEC_SCAN_H__ */
@@ -0,0 +1,882 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec_internal.h"
+#include "vec_sort.h"
+
+#define INSERTION_THRESHOLD 24 /**< ranges smaller than this are insertion sorted */
+#define NINTHER_THRESHOLD   128 /**< ranges bigger than this use the ninther as pivot */
+#define PARTIAL_INSERTION_LIMIT 8 /**< moves allowed before partial_insertion_sort gives up */
+#define SORTER_BUF          64 /**< elements up to this size are copied on the stack */
+#define PARALLEL_MIN_RUN    4096 /**< elements per run, at least, in a parallel sort */
+
+// MARK: Radix
+
+/**
+ * @brief LSD radix sort of unsigned integers of type @p T, one byte per pass
+ *
+ * the histograms of every byte are built in a single pass, and a byte that is the same
+ * for every element doesn't need its pass
+ */
+#define RADIX_SORT_DEFINE(name, T)                                                                 \
+   static void name(T *data, T *tmp, size_t n)                                                     \
+   {                                                                                               \
+      size_t counts[sizeof(T)][256];                                                               \
+      T     *src = data, *dst = tmp, *swap;                                                        \
+      size_t i, b;                                                                                 \
+                                                                                                   \
+      memset(counts, 0, sizeof(counts));                                                           \
+      for (i = 0; i < n; i++) {                                                                    \
+         for (b = 0; b < sizeof(T); b++)                                                           \
+            counts[b][(src[i] >> (b * 8)) & 0xff]++;                                               \
+      }                                                                                            \
+                                                                                                   \
+      for (b = 0; b < sizeof(T); b++) {                                                            \
+         size_t *count = counts[b];                                                                \
+         size_t  off = 0;                                                                          \
+                                                                                                   \
+         if (count[(src[0] >> (b * 8)) & 0xff] == n)                                               \
+            continue;                                                                              \
+         for (i = 0; i < 256; i++) {                                                               \
+            size_t c = count[i];                                                                   \
+            count[i] = off;                                                                        \
+            off += c;                                                                              \
+         }                                                                                         \
+         for (i = 0; i < n; i++)                                                                   \
+            dst[count[(src[i] >> (b * 8)) & 0xff]++] = src[i];                                     \
+         swap = src;                                                                               \
+         src = dst;                                                                                \
+         dst = swap;                                                                               \
+      }                                                                                            \
+                                                                                                   \
+      if (src != data)                                                                             \
+         memcpy(data, src, n * sizeof(T));                                                         \
+   }
+
+RADIX_SORT_DEFINE(radix_sort_u8, uint8_t)
+RADIX_SORT_DEFINE(radix_sort_u16, uint16_t)
+RADIX_SORT_DEFINE(radix_sort_u32, uint32_t)
+RADIX_SORT_DEFINE(radix_sort_u64, uint64_t)
+
+/**
+ * @brief LSD radix sort of @p keys of @p width bytes, moving @p pos along
+ */
+static void radix_sort_pairs(uint64_t *keys, size_t *pos, size_t n, size_t width)
+{
+   uint64_t *tmp_keys = malloc(n * sizeof(uint64_t));
+   size_t   *tmp_pos = malloc(n * sizeof(size_t));
+   uint64_t *src_keys = keys, *dst_keys = tmp_keys, *swap_keys;
+   size_t   *src_pos = pos, *dst_pos = tmp_pos, *swap_pos;
+   size_t    counts[8][256];
+   size_t    i, b;
+
+   memset(counts, 0, sizeof(counts));
+   for (i = 0; i < n; i++) {
+      for (b = 0; b < width; b++)
+         counts[b][(keys[i] >> (b * 8)) & 0xff]++;
+   }
+
+   for (b = 0; b < width; b++) {
+      size_t *count = counts[b];
+      size_t  off = 0;
+
+      if (count[(src_keys[0] >> (b * 8)) & 0xff] == n)
+         continue;
+      for (i = 0; i < 256; i++) {
+         size_t c = count[i];
+         count[i] = off;
+         off += c;
+      }
+      for (i = 0; i < n; i++) {
+         size_t dst = count[(src_keys[i] >> (b * 8)) & 0xff]++;
+
+         dst_keys[dst] = src_keys[i];
+         dst_pos[dst] = src_pos[i];
+      }
+      swap_keys = src_keys;
+      src_keys = dst_keys;
+      dst_keys = swap_keys;
+      swap_pos = src_pos;
+      src_pos = dst_pos;
+      dst_pos = swap_pos;
+   }
+
+   /* only the positions are needed from now on */
+   if (src_pos != pos)
+      memcpy(pos, src_pos, n * sizeof(size_t));
+
+   free(tmp_keys);
+   free(tmp_pos);
+}
+
+void vec_sort_radix(Vec *v, VecType type)
+{
+   void *tmp;
+
+   assert(v->size == vec_type_size(type));
+
+   if (v->len < 2)
+      return;
+
+   tmp = malloc(v->len * v->size);
+   to_ordered(v->ptr, v->len, type, false);
+
+   switch (v->size) {
+   case 1:
+      radix_sort_u8(v->ptr, tmp, v->len);
+      break;
+   case 2:
+      radix_sort_u16(v->ptr, tmp, v->len);
+      break;
+   case 4:
+      radix_sort_u32(v->ptr, tmp, v->len);
+      break;
+   default:
+      radix_sort_u64(v->ptr, tmp, v->len);
+      break;
+   }
+
+   to_ordered(v->ptr, v->len, type, true);
+   free(tmp);
+}
+
+void vec_sort_radix_by_key(Vec *v, size_t key_offset, VecType key_type)
+{
+   uint64_t *keys;
+   size_t   *pos;
+   char     *elems;
+   size_t    i;
+
+   assert(key_offset + vec_type_size(key_type) <= v->size);
+
+   if (v->len < 2)
+      return;
+
+   keys = malloc(v->len * sizeof(uint64_t));
+   pos = malloc(v->len * sizeof(size_t));
+   for (i = 0; i < v->len; i++) {
+      keys[i] = ordered_key((char *)v->ptr + i * v->size + key_offset, key_type);
+      pos[i] = i;
+   }
+
+   radix_sort_pairs(keys, pos, v->len, vec_type_size(key_type));
+   free(keys);
+
+   /* gather the elements in their final order */
+   elems = malloc(v->len * v->size);
+   for (i = 0; i < v->len; i++)
+      memcpy(elems + i * v->size, (char *)v->ptr + pos[i] * v->size, v->size);
+   memcpy(v->ptr, elems, v->len * v->size);
+
+   free(elems);
+   free(pos);
+}
+
+// MARK: Comparison
+
+/**
+ * @brief state of a comparison sort
+ */
+typedef struct Sorter {
+   char     *base; /**< elements */
+   size_t    size; /**< element size */
+   SortCmpFn cmp_fn;
+   char     *pivot; /**< copy of the pivot being partitioned around */
+   char     *tmp; /**< element being moved */
+} Sorter;
+
+INLINE static char *elem(const Sorter *s, size_t i)
+{
+   return s->base + i * s->size;
+}
+
+INLINE static bool less(const Sorter *s, const void *a, const void *b)
+{
+   return s->cmp_fn(a, b) < 0;
+}
+
+INLINE static void copy_elem(const Sorter *s, void *dst, const void *src)
+{
+   /* fixed sizes become plain loads and stores */
+   switch (s->size) {
+   case 4:
+      memcpy(dst, src, 4);
+      break;
+   case 8:
+      memcpy(dst, src, 8);
+      break;
+   case 16:
+      memcpy(dst, src, 16);
+      break;
+   default:
+      memcpy(dst, src, s->size);
+      break;
+   }
+}
+
+INLINE static void swap_elems(const Sorter *s, size_t i, size_t j)
+{
+   copy_elem(s, s->tmp, elem(s, i));
+   copy_elem(s, elem(s, i), elem(s, j));
+   copy_elem(s, elem(s, j), s->tmp);
+}
+
+static void insertion_sort(const Sorter *s, size_t beg, size_t end)
+{
+   size_t i, j;
+
+   for (i = beg + 1; i < end; i++) {
+      if (!less(s, elem(s, i), elem(s, i - 1)))
+         continue;
+
+      copy_elem(s, s->tmp, elem(s, i));
+      for (j = i; j > beg && less(s, s->tmp, elem(s, j - 1)); j--)
+         copy_elem(s, elem(s, j), elem(s, j - 1));
+      copy_elem(s, elem(s, j), s->tmp);
+   }
+}
+
+/**
+ * @brief insertion sort that gives up after moving PARTIAL_INSERTION_LIMIT elements
+ *
+ * @return if the range got sorted
+ */
+static bool partial_insertion_sort(const Sorter *s, size_t beg, size_t end)
+{
+   size_t moved = 0;
+   size_t i, j;
+
+   for (i = beg + 1; i < end; i++) {
+      if (!less(s, elem(s, i), elem(s, i - 1)))
+         continue;
+
+      copy_elem(s, s->tmp, elem(s, i));
+      for (j = i; j > beg && less(s, s->tmp, elem(s, j - 1)); j--)
+         copy_elem(s, elem(s, j), elem(s, j - 1));
+      copy_elem(s, elem(s, j), s->tmp);
+
+      moved += i - j;
+      if (moved > PARTIAL_INSERTION_LIMIT)
+         return false;
+   }
+
+   return true;
+}
+
+INLINE static void sort2(const Sorter *s, size_t a, size_t b)
+{
+   if (less(s, elem(s, b), elem(s, a)))
+      swap_elems(s, a, b);
+}
+
+/**
+ * @brief sort the elements at @p a, @p b, @p c
+ */
+INLINE static void sort3(const Sorter *s, size_t a, size_t b, size_t c)
+{
+   sort2(s, a, b);
+   sort2(s, b, c);
+   sort2(s, a, b);
+}
+
+static void sift_down(const Sorter *s, size_t beg, size_t root, size_t len)
+{
+   size_t child;
+
+   while ((child = 2 * root + 1) < len) {
+      if (child + 1 < len && less(s, elem(s, beg + child), elem(s, beg + child + 1)))
+         child++;
+      if (!less(s, elem(s, beg + root), elem(s, beg + child)))
+         return;
+      swap_elems(s, beg + root, beg + child);
+      root = child;
+   }
+}
+
+static void heap_sort(const Sorter *s, size_t beg, size_t end)
+{
+   size_t len = end - beg;
+   size_t i;
+
+   for (i = len / 2; i > 0; i--)
+      sift_down(s, beg, i - 1, len);
+   for (i = len - 1; i > 0; i--) {
+      swap_elems(s, beg, beg + i);
+      sift_down(s, beg, 0, i);
+   }
+}
+
+/**
+ * @brief partition around the element at @p beg, elements equal to it go to the right
+ *
+ * @param[out] already_partitioned if no element had to be swapped
+ *
+ * @return final position of the pivot
+ */
+static size_t partition_right(const Sorter *s, size_t beg, size_t end, bool *already_partitioned)
+{
+   size_t first = beg, last = end, pivot_pos;
+
+   copy_elem(s, s->pivot, elem(s, beg));
+
+   /* the pivot selection guarantees an element >= pivot before the end */
+   while (less(s, elem(s, ++first), s->pivot))
+      ;
+
+   /* and if there was an element < pivot before first, there's no need for the bound check */
+   if (first - 1 == beg) {
+      while (first < last && !less(s, elem(s, --last), s->pivot))
+         ;
+   }
+   else {
+      while (!less(s, elem(s, --last), s->pivot))
+         ;
+   }
+
+   *already_partitioned = first >= last;
+
+   while (first < last) {
+      swap_elems(s, first, last);
+      while (less(s, elem(s, ++first), s->pivot))
+         ;
+      while (!less(s, elem(s, --last), s->pivot))
+         ;
+   }
+
+   pivot_pos = first - 1;
+   copy_elem(s, elem(s, beg), elem(s, pivot_pos));
+   copy_elem(s, elem(s, pivot_pos), s->pivot);
+
+   return pivot_pos;
+}
+
+/**
+ * @brief partition around the element at @p beg, elements equal to it go to the left
+ *
+ * used when the pivot is equal to the previous one, so the left part is all equal and done
+ *
+ * @return final position of the pivot
+ */
+static size_t partition_left(const Sorter *s, size_t beg, size_t end)
+{
+   size_t first = beg, last = end, pivot_pos;
+
+   copy_elem(s, s->pivot, elem(s, beg));
+
+   while (less(s, s->pivot, elem(s, --last)))
+      ;
+
+   if (last + 1 == end) {
+      while (first < last && !less(s, s->pivot, elem(s, ++first)))
+         ;
+   }
+   else {
+      while (!less(s, s->pivot, elem(s, ++first)))
+         ;
+   }
+
+   while (first < last) {
+      swap_elems(s, first, last);
+      while (less(s, s->pivot, elem(s, --last)))
+         ;
+      while (!less(s, s->pivot, elem(s, ++first)))
+         ;
+   }
+
+   pivot_pos = last;
+   copy_elem(s, elem(s, beg), elem(s, pivot_pos));
+   copy_elem(s, elem(s, pivot_pos), s->pivot);
+
+   return pivot_pos;
+}
+
+/**
+ * @brief swap some elements around, to break patterns that lead to unbalanced partitions
+ */
+static void break_patterns(const Sorter *s, size_t beg, size_t end)
+{
+   size_t len = end - beg;
+   size_t q = len / 4;
+
+   swap_elems(s, beg, beg + q);
+   swap_elems(s, end - 1, end - q);
+   if (len > NINTHER_THRESHOLD) {
+      swap_elems(s, beg + 1, beg + q + 1);
+      swap_elems(s, beg + 2, beg + q + 2);
+      swap_elems(s, end - 2, end - q - 1);
+      swap_elems(s, end - 3, end - q - 2);
+   }
+}
+
+/**
+ * @brief sort [ @p beg, @p end )
+ *
+ * @param[in] bad_allowed unbalanced partitions left before switching to heap sort
+ * @param[in] leftmost if there's no element before @p beg (otherwise it's <= the whole range)
+ */
+static void pdq_sort(const Sorter *s, size_t beg, size_t end, int bad_allowed, bool leftmost)
+{
+   for (;;) {
+      size_t len = end - beg;
+      size_t half = len / 2;
+      size_t pivot_pos, l_len, r_len;
+      bool   already_partitioned;
+
+      if (len < INSERTION_THRESHOLD) {
+         insertion_sort(s, beg, end);
+         return;
+      }
+
+      /* median of 3, or ninther, moved to beg */
+      if (len > NINTHER_THRESHOLD) {
+         sort3(s, beg, beg + half, end - 1);
+         sort3(s, beg + 1, beg + half - 1, end - 2);
+         sort3(s, beg + 2, beg + half + 1, end - 3);
+         sort3(s, beg + half - 1, beg + half, beg + half + 1);
+         swap_elems(s, beg, beg + half);
+      }
+      else
+         sort3(s, beg + half, beg, end - 1);
+
+      /* equal to the previous pivot: they are all in their final place */
+      if (!leftmost && !less(s, elem(s, beg - 1), elem(s, beg))) {
+         beg = partition_left(s, beg, end) + 1;
+         continue;
+      }
+
+      pivot_pos = partition_right(s, beg, end, &already_partitioned);
+      l_len = pivot_pos - beg;
+      r_len = end - (pivot_pos + 1);
+
+      if (l_len < len / 8 || r_len < len / 8) {
+         if (--bad_allowed == 0) {
+            heap_sort(s, beg, end);
+            return;
+         }
+         if (l_len >= INSERTION_THRESHOLD)
+            break_patterns(s, beg, pivot_pos);
+         if (r_len >= INSERTION_THRESHOLD)
+            break_patterns(s, pivot_pos + 1, end);
+      }
+      else if (already_partitioned && partial_insertion_sort(s, beg, pivot_pos) &&
+               partial_insertion_sort(s, pivot_pos + 1, end))
+         return;
+
+      pdq_sort(s, beg, pivot_pos, bad_allowed, leftmost);
+      beg = pivot_pos + 1;
+      leftmost = false;
+   }
+}
+
+/**
+ * @brief floor(log2( @p n )), the number of unbalanced partitions allowed
+ */
+INLINE static int log2_floor(size_t n)
+{
+   int log = 0;
+
+   for (; n > 1; n >>= 1)
+      log++;
+
+   return log;
+}
+
+/**
+ * @brief setup @p s , using @p buf (2 * SORTER_BUF bytes) for the element copies if they fit
+ */
+static void sorter_init(Sorter *s, void *base, size_t size, SortCmpFn cmp_fn, char *buf)
+{
+   s->base = base;
+   s->size = size;
+   s->cmp_fn = cmp_fn;
+   s->pivot = size <= SORTER_BUF ? buf : malloc(2 * size);
+   s->tmp = s->pivot + size;
+}
+
+static void sorter_free(Sorter *s, char *buf)
+{
+   if (s->pivot != buf)
+      free(s->pivot);
+}
+
+void vec_sort(Vec *v, SortCmpFn cmp_fn)
+{
+   Sorter s;
+   char   buf[2 * SORTER_BUF];
+
+   if (v->len < 2)
+      return;
+
+   sorter_init(&s, v->ptr, v->size, cmp_fn, buf);
+   pdq_sort(&s, 0, v->len, log2_floor(v->len), true);
+   sorter_free(&s, buf);
+}
+
+// MARK: Merge
+
+/**
+ * @brief first position in [ @p beg, @p end ) whose element is not less than @p key
+ */
+static size_t lower_bound(const Sorter *s, size_t beg, size_t end, const void *key)
+{
+   while (beg < end) {
+      size_t mid = beg + (end - beg) / 2;
+
+      if (less(s, elem(s, mid), key))
+         beg = mid + 1;
+      else
+         end = mid;
+   }
+
+   return beg;
+}
+
+/**
+ * @brief first position in [ @p beg, @p end ) whose element is greater than @p key
+ */
+static size_t upper_bound(const Sorter *s, size_t beg, size_t end, const void *key)
+{
+   while (beg < end) {
+      size_t mid = beg + (end - beg) / 2;
+
+      if (!less(s, key, elem(s, mid)))
+         beg = mid + 1;
+      else
+         end = mid;
+   }
+
+   return beg;
+}
+
+static void reverse(const Sorter *s, size_t beg, size_t end)
+{
+   while (beg + 1 < end)
+      swap_elems(s, beg++, --end);
+}
+
+/**
+ * @brief move [ @p mid, @p end ) before [ @p beg, @p mid )
+ */
+static void rotate(const Sorter *s, size_t beg, size_t mid, size_t end)
+{
+   reverse(s, beg, mid);
+   reverse(s, mid, end);
+   reverse(s, beg, end);
+}
+
+/**
+ * @brief stable merge of the sorted ranges [ @p beg, @p mid ) and [ @p mid, @p end )
+ *
+ * the smaller range is moved to @p buf , if it fits in its @p buf_len elements.
+ * otherwise the ranges are split in two merges of half the size with a rotation,
+ * which works without any buffer, in O(n log n)
+ */
+static void
+merge_buffered(const Sorter *s, size_t beg, size_t mid, size_t end, char *buf, size_t buf_len)
+{
+   size_t len1 = mid - beg, len2 = end - mid;
+   size_t i, j, out, cut1, cut2;
+
+   if (!len1 || !len2 || !less(s, elem(s, mid), elem(s, mid - 1)))
+      return;
+
+   if (len1 <= buf_len && len1 <= len2) {
+      memcpy(buf, elem(s, beg), len1 * s->size);
+      for (i = 0, j = mid, out = beg; i < len1 && j < end; out++) {
+         if (less(s, elem(s, j), buf + i * s->size))
+            copy_elem(s, elem(s, out), elem(s, j++));
+         else
+            copy_elem(s, elem(s, out), buf + i++ * s->size);
+      }
+      memcpy(elem(s, out), buf + i * s->size, (len1 - i) * s->size);
+   }
+   else if (len2 <= buf_len) {
+      memcpy(buf, elem(s, mid), len2 * s->size);
+      for (i = mid, j = len2, out = end; i > beg && j > 0;) {
+         if (less(s, buf + (j - 1) * s->size, elem(s, i - 1)))
+            copy_elem(s, elem(s, --out), elem(s, --i));
+         else
+            copy_elem(s, elem(s, --out), buf + --j * s->size);
+      }
+      memcpy(elem(s, beg), buf, j * s->size);
+   }
+   else {
+      if (len1 >= len2) {
+         cut1 = beg + len1 / 2;
+         cut2 = lower_bound(s, mid, end, elem(s, cut1));
+      }
+      else {
+         cut2 = mid + len2 / 2;
+         cut1 = upper_bound(s, beg, mid, elem(s, cut2));
+      }
+      rotate(s, cut1, mid, cut2);
+      mid = cut1 + (cut2 - mid);
+      merge_buffered(s, beg, cut1, mid, buf, buf_len);
+      merge_buffered(s, mid, cut2, end, buf, buf_len);
+   }
+}
+
+/**
+ * @brief stable sort of [ @p beg, @p end ): insertion sort of small blocks, then bottom-up merges
+ */
+static void
+merge_sort(const Sorter *s, size_t beg, size_t end, char *buf, size_t buf_len)
+{
+   size_t width, i;
+
+   for (i = beg; i < end; i += INSERTION_THRESHOLD)
+      insertion_sort(s, i, end - i < INSERTION_THRESHOLD ? end : i + INSERTION_THRESHOLD);
+
+   for (width = INSERTION_THRESHOLD; width < end - beg; width *= 2) {
+      for (i = beg; i + width < end; i += 2 * width)
+         merge_buffered(s, i, i + width, end - i - width < width ? end : i + 2 * width, buf,
+                        buf_len);
+   }
+}
+
+/**
+ * @brief stable merge of @p a and @p b into @p dst
+ */
+static void merge_into(const Sorter *s, const char *a, size_t len_a, const char *b, size_t len_b,
+                       char *dst)
+{
+   const char *end_a = a + len_a * s->size, *end_b = b + len_b * s->size;
+
+   while (a < end_a && b < end_b) {
+      if (less(s, b, a)) {
+         copy_elem(s, dst, b);
+         b += s->size;
+      }
+      else {
+         copy_elem(s, dst, a);
+         a += s->size;
+      }
+      dst += s->size;
+   }
+   memcpy(dst, a, (size_t)(end_a - a));
+   dst += end_a - a;
+   memcpy(dst, b, (size_t)(end_b - b));
+}
+
+/**
+ * @brief how many elements of @p a are among the first @p k of the stable merge of @p a and @p b
+ */
+static size_t
+co_rank(const Sorter *s, size_t k, const char *a, size_t len_a, const char *b, size_t len_b)
+{
+   size_t lo = k > len_b ? k - len_b : 0;
+   size_t hi = k < len_a ? k : len_a;
+
+   while (lo < hi) {
+      size_t i = lo + (hi - lo) / 2;
+      size_t j = k - i;
+
+      /* a[i] still goes before b[j - 1] */
+      if (j > 0 && !less(s, b + (j - 1) * s->size, a + i * s->size))
+         lo = i + 1;
+      else
+         hi = i;
+   }
+
+   return lo;
+}
+
+// MARK: Parallel
+
+/**
+ * @brief state of a parallel sort, shared by the tasks
+ */
+typedef struct ParSort {
+   char     *base;
+   size_t    len;
+   size_t    size;
+   SortCmpFn cmp_fn;
+   bool      stable;
+   char     *scratch;
+   size_t    scratch_len; /**< elements that fit in scratch */
+   size_t    run_len; /**< elements per sorted run */
+   size_t    n_runs;
+   size_t    n_pieces; /**< pieces each merge of two runs is split into */
+   char     *src; /**< runs being merged (base or scratch) */
+   char     *dst; /**< merged runs (the other one) */
+} ParSort;
+
+/**
+ * @brief bounds of run @p idx
+ */
+INLINE static void run_bounds(const ParSort *ps, size_t idx, size_t *beg, size_t *end)
+{
+   *beg = idx * ps->run_len < ps->len ? idx * ps->run_len : ps->len;
+   *end = ps->len - *beg < ps->run_len ? ps->len : *beg + ps->run_len;
+}
+
+/**
+ * @brief sort run @p idx in place, with its share of the scratch buffer
+ */
+static void sort_run_task(void *ctx, size_t idx)
+{
+   ParSort *ps = ctx;
+   Sorter   s;
+   char     buf[2 * SORTER_BUF];
+   size_t   beg, end;
+   size_t   share = ps->scratch_len / ps->n_runs;
+
+   run_bounds(ps, idx, &beg, &end);
+   sorter_init(&s, ps->base, ps->size, ps->cmp_fn, buf);
+
+   if (ps->stable)
+      merge_sort(&s, beg, end, share ? ps->scratch + idx * share * ps->size : NULL, share);
+   else if (end - beg > 1)
+      pdq_sort(&s, beg, end, log2_floor(end - beg), true);
+
+   sorter_free(&s, buf);
+}
+
+/**
+ * @brief merge piece ( @p idx % n_pieces ) of the pair of runs ( @p idx / n_pieces ),
+ * from src into dst
+ */
+static void merge_piece_task(void *ctx, size_t idx)
+{
+   ParSort *ps = ctx;
+   Sorter   s;
+   char     buf[2 * SORTER_BUF];
+   size_t   pair = idx / ps->n_pieces, piece = idx % ps->n_pieces;
+   size_t   beg, mid, end, len_a, len_b, k0, k1, i0, i1;
+   char    *a, *b;
+
+   run_bounds(ps, 2 * pair, &beg, &mid);
+   end = ps->len - mid < ps->run_len ? ps->len : mid + ps->run_len;
+   len_a = mid - beg;
+   len_b = end - mid;
+   a = ps->src + beg * ps->size;
+   b = ps->src + mid * ps->size;
+
+   sorter_init(&s, ps->src, ps->size, ps->cmp_fn, buf);
+
+   /* the output range of the piece, and where it starts in a and b */
+   k0 = (len_a + len_b) * piece / ps->n_pieces;
+   k1 = (len_a + len_b) * (piece + 1) / ps->n_pieces;
+   i0 = co_rank(&s, k0, a, len_a, b, len_b);
+   i1 = co_rank(&s, k1, a, len_a, b, len_b);
+
+   merge_into(&s, a + i0 * ps->size, i1 - i0, b + (k0 - i0) * ps->size, (k1 - i1) - (k0 - i0),
+              ps->dst + (beg + k0) * ps->size);
+
+   sorter_free(&s, buf);
+}
+
+/**
+ * @brief merge the pair of runs @p idx in place, with its share of the scratch buffer
+ */
+static void merge_pair_task(void *ctx, size_t idx)
+{
+   ParSort *ps = ctx;
+   Sorter   s;
+   char     buf[2 * SORTER_BUF];
+   size_t   share = ps->scratch_len / ((ps->n_runs + 1) / 2);
+   size_t   beg, mid, end;
+
+   run_bounds(ps, 2 * idx, &beg, &mid);
+   end = ps->len - mid < ps->run_len ? ps->len : mid + ps->run_len;
+
+   sorter_init(&s, ps->base, ps->size, ps->cmp_fn, buf);
+   merge_buffered(&s, beg, mid, end, share ? ps->scratch + idx * share * ps->size : NULL, share);
+   sorter_free(&s, buf);
+}
+
+static void copy_back_task(void *ctx, size_t idx)
+{
+   ParSort *ps = ctx;
+   size_t   beg, end;
+
+   run_bounds(ps, idx, &beg, &end);
+   memcpy(ps->base + beg * ps->size, ps->src + beg * ps->size, (end - beg) * ps->size);
+}
+
+/**
+ * @brief sort the runs in parallel, then merge them two by two
+ */
+static void sort_parallel(Vec *v, SortCmpFn cmp_fn, ThreadPool *pool, size_t max_scratch,
+                          bool stable)
+{
+   ParSort ps;
+   size_t  n_threads = threadpool_n_threads(pool);
+   size_t  n_pairs;
+
+   if (v->len < 2)
+      return;
+
+   ps.base = v->ptr;
+   ps.len = v->len;
+   ps.size = v->size;
+   ps.cmp_fn = cmp_fn;
+   ps.stable = stable;
+   ps.scratch_len = max_scratch / v->size < v->len ? max_scratch / v->size : v->len;
+   ps.scratch = ps.scratch_len ? malloc(ps.scratch_len * v->size) : NULL;
+
+   /* a run per thread, unless they would be too small to be worth it */
+   ps.n_runs = v->len / PARALLEL_MIN_RUN < n_threads ? v->len / PARALLEL_MIN_RUN : n_threads;
+   if (!ps.n_runs)
+      ps.n_runs = 1;
+   ps.run_len = (v->len + ps.n_runs - 1) / ps.n_runs;
+   threadpool_run(pool, sort_run_task, &ps, ps.n_runs);
+
+   ps.src = ps.base;
+   ps.dst = ps.scratch;
+   for (; ps.n_runs > 1; ps.n_runs = n_pairs, ps.run_len *= 2) {
+      n_pairs = (ps.n_runs + 1) / 2;
+
+      if (ps.scratch_len == ps.len) {
+         /* split the merges, so there's a piece for every thread even in the last rounds */
+         char *swap;
+
+         ps.n_pieces = (n_threads + n_pairs - 1) / n_pairs;
+         threadpool_run(pool, merge_piece_task, &ps, n_pairs * ps.n_pieces);
+         swap = ps.src;
+         ps.src = ps.dst;
+         ps.dst = swap;
+      }
+      else
+         threadpool_run(pool, merge_pair_task, &ps, n_pairs);
+   }
+
+   if (ps.src != ps.base) {
+      ps.n_runs = n_threads;
+      ps.run_len = (ps.len + n_threads - 1) / n_threads;
+      threadpool_run(pool, copy_back_task, &ps, n_threads);
+   }
+
+   free(ps.scratch);
+}
+
+void vec_sort_parallel(Vec *v, SortCmpFn cmp_fn, ThreadPool *pool, size_t max_scratch)
+{
+   sort_parallel(v, cmp_fn, pool, max_scratch, false);
+}
+
+void vec_sort_stable(Vec *v, SortCmpFn cmp_fn, ThreadPool *pool, size_t max_scratch)
+{
+   sort_parallel(v, cmp_fn, pool, max_scratch, true);
+}
+
+bool vec_is_sorted(const Vec *v, SortCmpFn cmp_fn)
+{
+   size_t i;
+
+   for (i = 1; i < v->len; i++) {
+      if (cmp_fn((char *)v->ptr + i * v->size, (char *)v->ptr + (i - 1) * v->size) < 0)
+         return false;
+   }
+
+   return true;
+}
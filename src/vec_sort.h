@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file vec_sort.h
+ */
+#ifndef __VEC_SORT_H__
+#define __VEC_SORT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "threadpool.h"
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+typedef int (*SortCmpFn)(const void *ptr1, const void *ptr2); /**< same as qsort's */
+
+/**
+ * @brief sort numeric elements in ascending order, with a LSD radix sort
+ *
+ * keys are mapped to unsigned integers with the same order (sign bit flipped for signed integers,
+ * all bits flipped for negative floats), then sorted one byte at a time, skipping the bytes
+ * that are the same for every element. runs in O(n) with n elements of extra memory.
+ * floats get a total order by their bits: -NaN < -inf < negatives < -0 < +0 < positives < inf < +NaN
+ * (NaNs with the sign bit set go first, the others last)
+ *
+ * @param[in,out] v Vec of elements of @p type
+ * @param[in] type type of the elements, its size must match
+ */
+void vec_sort_radix(Vec *v, VecType type);
+
+/**
+ * @brief sort elements by a numeric key they contain, with a LSD radix sort
+ *
+ * stable. the keys and the elements' positions are sorted together, and then the elements
+ * are moved once, so the cost of moving big elements is paid only at the end.
+ * extra memory is n keys, n positions and n elements
+ *
+ * @param[in,out] v Vec
+ * @param[in] key_offset offset of the key inside the elements (e.g. offsetof)
+ * @param[in] key_type type of the key
+ */
+void vec_sort_radix_by_key(Vec *v, size_t key_offset, VecType key_type);
+
+/**
+ * @brief sort elements with a comparison function (pattern-defeating quicksort)
+ *
+ * not stable, in place, O(n log n) worst case. quicksort with:
+ * - insertion sort for small ranges
+ * - median of 3 (or ninther) pivot
+ * - detection of already partitioned ranges, that are finished with a bounded insertion sort
+ * - ranges of elements equal to the previous pivot are skipped in one partition
+ * - heapsort after too many unbalanced partitions
+ *
+ * @param[in,out] v Vec
+ * @param[in] cmp_fn comparison function, like qsort's
+ */
+void vec_sort(Vec *v, SortCmpFn cmp_fn);
+
+/**
+ * @brief sort elements with a comparison function, using the threads of @p pool
+ *
+ * not stable. the Vec is split in a run per thread, sorted like @p vec_sort , then the runs are
+ * merged two by two. with a scratch buffer as big as the Vec, the merges go back and forth
+ * between the two, and each merge is split in independent pieces (by binary searching where
+ * the pieces start in both runs), so all the threads work until the end.
+ * with less memory, each merge runs on a single thread and uses its share of the buffer,
+ * falling back to merging by rotations, which needs no memory at all but is slower
+ *
+ * @param[in,out] v Vec
+ * @param[in] cmp_fn comparison function, like qsort's. must be thread-safe
+ * @param[in,out] pool ThreadPool, or NULL to sort on the calling thread
+ * @param[in] max_scratch bytes of extra memory that can be used. SIZE_MAX for as much as needed
+ *            (the size of the Vec), 0 to sort in place
+ */
+void vec_sort_parallel(Vec *v, SortCmpFn cmp_fn, ThreadPool *pool, size_t max_scratch);
+
+/**
+ * @brief stable sort with a comparison function, optionally using the threads of @p pool
+ *
+ * like @p vec_sort_parallel , but the runs are merge sorted too.
+ * with a NULL @p pool it's a plain (buffered) merge sort
+ *
+ * @param[in,out] v Vec
+ * @param[in] cmp_fn comparison function, like qsort's. must be thread-safe
+ * @param[in,out] pool ThreadPool, or NULL to sort on the calling thread
+ * @param[in] max_scratch bytes of extra memory that can be used (see @p vec_sort_parallel )
+ */
+void vec_sort_stable(Vec *v, SortCmpFn cmp_fn, ThreadPool *pool, size_t max_scratch);
+
+/**
+ * @brief check if @p v is sorted according to @p cmp_fn
+ */
+bool vec_is_sorted(const Vec *v, SortCmpFn cmp_fn);
+
+#endif /* __VEC_SORT_H__ */
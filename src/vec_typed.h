@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Alessandro Martone
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+/**
+ * @file vec_typed.h
+ */
+#ifndef __VEC_TYPED_H__
+#define __VEC_TYPED_H__
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "vec.h"
+
+#ifdef _MSC_VER
+   #define INLINE __inline
+#elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
+   #define INLINE inline
+#else
+   #define INLINE
+#endif
+
+/**
+ * @brief define @p name, a @p Vec of @p T with typed inline operations
+ *
+ * the element size is known at compile time, so element accesses are plain loads/stores,
+ * copies are memcpy of constant length, and loops over @p name_data can be vectorized.
+ * push and extend only leave the inline fast path when the capacity has to grow.
+ *
+ * the underlying Vec is the @p vec member (see @p name_as_vec ), so every vec_* function works too.
+ * put it in a header or a .c file, only once per @p name:
+ *
+ *    VEC_DEFINE(IntVec, int)
+ *
+ *    IntVec v;
+ *    IntVec_new(&v, NULL);
+ *    IntVec_push(&v, 42);
+ *
+ * generated functions, all prefixed with @p name and an underscore: new, new_in, new_with,
+ * free, reserve, truncate, len, data, at, get, set, push, pop, extend, insert, as_vec
+ *
+ * @param name name of the struct, and prefix of the functions
+ * @param T element type, must be a complete type that can be assigned
+ */
+#define VEC_DEFINE(name, T)                                                                        \
+   typedef struct name {                                                                           \
+      Vec vec; /**< underlying Vec, of sizeof(T) elements */                                       \
+   } name;                                                                                         \
+                                                                                                   \
+   /** @brief initialize empty struct, see @p vec_new */                                           \
+   INLINE static void name##_new(name *v, FreeFn free_fn)                                          \
+   {                                                                                               \
+      vec_new(&v->vec, sizeof(T), free_fn);                                                        \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief initialize empty struct on @p alloc , see @p vec_new_in */                           \
+   INLINE static void name##_new_in(name *v, FreeFn free_fn, const Allocator *alloc)               \
+   {                                                                                               \
+      vec_new_in(&v->vec, sizeof(T), free_fn, alloc);                                              \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief initialize struct and reserve space, see @p vec_new_with */                          \
+   INLINE static void name##_new_with(name *v, size_t nelem, FreeFn free_fn)                       \
+   {                                                                                               \
+      vec_new_with(&v->vec, sizeof(T), nelem, free_fn);                                            \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief free elements and memory, see @p vec_free */                                         \
+   INLINE static void name##_free(name *v)                                                         \
+   {                                                                                               \
+      vec_free(&v->vec);                                                                           \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief reserve space for @p nelem elements in total, see @p vec_reserve */                  \
+   INLINE static bool name##_reserve(name *v, size_t nelem)                                        \
+   {                                                                                               \
+      return vec_reserve(&v->vec, nelem);                                                          \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief shorten to @p new_len elements, see @p vec_truncate */                               \
+   INLINE static void name##_truncate(name *v, size_t new_len)                                     \
+   {                                                                                               \
+      vec_truncate(&v->vec, new_len);                                                              \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief number of elements */                                                                \
+   INLINE static size_t name##_len(const name *v)                                                  \
+   {                                                                                               \
+      return v->vec.len;                                                                           \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief pointer to the elements, invalidated by insertions */                                \
+   INLINE static T *name##_data(const name *v)                                                     \
+   {                                                                                               \
+      return (T *)v->vec.ptr;                                                                      \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief pointer to element at @p pos, or NULL. see @p vec_at */                              \
+   INLINE static T *name##_at(const name *v, size_t pos)                                           \
+   {                                                                                               \
+      return pos < v->vec.len ? (T *)v->vec.ptr + pos : NULL;                                      \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief copy of the element at @p pos, which must exist */                                   \
+   INLINE static T name##_get(const name *v, size_t pos)                                           \
+   {                                                                                               \
+      assert(pos < v->vec.len);                                                                    \
+      return ((T *)v->vec.ptr)[pos];                                                               \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief overwrite the element at @p pos, which must exist. see @p vec_set */                 \
+   INLINE static void name##_set(name *v, size_t pos, T elem)                                      \
+   {                                                                                               \
+      assert(pos < v->vec.len);                                                                    \
+      if (v->vec.free_fn)                                                                          \
+         v->vec.free_fn((T *)v->vec.ptr + pos);                                                    \
+      ((T *)v->vec.ptr)[pos] = elem;                                                               \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief append @p elem, or return NULL if out of memory. see @p vec_push */                  \
+   INLINE static T *name##_push(name *v, T elem)                                                   \
+   {                                                                                               \
+      T *slot;                                                                                     \
+                                                                                                   \
+      if (v->vec.len == v->vec.cap && !vec_reserve(&v->vec, v->vec.len + 1))                       \
+         return NULL;                                                                              \
+      slot = (T *)v->vec.ptr + v->vec.len++;                                                       \
+      *slot = elem;                                                                                \
+      return slot;                                                                                 \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief remove the last element into @p elem (if != NULL), see @p vec_pop */                 \
+   INLINE static bool name##_pop(name *v, T *elem)                                                 \
+   {                                                                                               \
+      T *last;                                                                                     \
+                                                                                                   \
+      if (!v->vec.len)                                                                             \
+         return false;                                                                             \
+      last = (T *)v->vec.ptr + --v->vec.len;                                                       \
+      if (elem)                                                                                    \
+         *elem = *last;                                                                            \
+      else if (v->vec.free_fn)                                                                     \
+         v->vec.free_fn(last);                                                                     \
+      return true;                                                                                 \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief append @p nelem elements (not from this Vec), or NULL if out of memory */            \
+   INLINE static T *name##_extend(name *v, const T *elems, size_t nelem)                           \
+   {                                                                                               \
+      T *dst;                                                                                      \
+                                                                                                   \
+      if (v->vec.len + nelem > v->vec.cap && !vec_reserve(&v->vec, v->vec.len + nelem))            \
+         return NULL;                                                                              \
+      dst = (T *)v->vec.ptr + v->vec.len;                                                          \
+      if (nelem)                                                                                   \
+         memcpy(dst, elems, nelem * sizeof(T));                                                    \
+      v->vec.len += nelem;                                                                         \
+      return dst;                                                                                  \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief insert @p elem at @p pos, or return NULL on failure. see @p vec_insert */            \
+   INLINE static T *name##_insert(name *v, size_t pos, T elem)                                     \
+   {                                                                                               \
+      T *slot;                                                                                     \
+                                                                                                   \
+      if (pos > v->vec.len)                                                                        \
+         return NULL;                                                                              \
+      if (v->vec.len == v->vec.cap && !vec_reserve(&v->vec, v->vec.len + 1))                       \
+         return NULL;                                                                              \
+      slot = (T *)v->vec.ptr + pos;                                                                \
+      memmove(slot + 1, slot, (v->vec.len - pos) * sizeof(T));                                     \
+      *slot = elem;                                                                                \
+      v->vec.len++;                                                                                \
+      return slot;                                                                                 \
+   }                                                                                               \
+                                                                                                   \
+   /** @brief the underlying Vec, to use the generic functions */                                  \
+   INLINE static Vec *name##_as_vec(name *v)                                                       \
+   {                                                                                               \
+      return &v->vec;                                                                              \
+   }
+
+#endif /* __VEC_TYPED_H__ */
@@ -23,10 +23,15 @@
  * @param[in,out] vs Vstr
  * @param[in] nbytes number of bytes required
  */
-INLINE static void vstr_alloc(VStr *vs, size_t nbytes)
+INLINE static bool vstr_alloc(VStr *vs, size_t nbytes)
 {
-   vs->ptr = malloc(nbytes);
+   char *ptr = allocator_realloc(vs->alloc, NULL, 0, nbytes);
+
+   if (!ptr)
+      return false;
+   vs->ptr = ptr;
    vs->cap = nbytes;
+   return true;
 }
 
 /**
@@ -35,10 +40,15 @@ INLINE static void vstr_alloc(VStr *vs, size_t nbytes)
  * @param[in,out] vs Vstr
  * @param[in] nbytes number of bytes required
  */
-INLINE static void vstr_realloc(VStr *vs, size_t nbytes)
+INLINE static bool vstr_realloc(VStr *vs, size_t nbytes)
 {
-   vs->ptr = realloc(vs->ptr, nbytes);
+   char *ptr = allocator_realloc(vs->alloc, vs->ptr, vs->cap, nbytes);
+
+   if (!ptr)
+      return false;
+   vs->ptr = ptr;
    vs->cap = nbytes;
+   return true;
 }
 
 /**
@@ -50,16 +60,17 @@ INLINE static void vstr_realloc(VStr *vs, size_t nbytes)
  * @param[in,out] vs Vstr
  * @param[in] nbytes number of bytes required
  */
-static void vstr_resize(VStr *vs, size_t nbytes)
+static bool vstr_resize(VStr *vs, size_t nbytes)
 {
    if (vs->cap) {
       if (nbytes < vs->cap || nbytes > vs->cap * GROWTH_FACTOR)
-         vstr_realloc(vs, nbytes);
+         return vstr_realloc(vs, nbytes);
       else if (nbytes > vs->cap)
-         vstr_realloc(vs, vs->cap * GROWTH_FACTOR);
+         return vstr_realloc(vs, vs->cap * GROWTH_FACTOR);
+      return true;
    }
    else
-      vstr_alloc(vs, nbytes > GROWTH_FACTOR ? nbytes : GROWTH_FACTOR);
+      return vstr_alloc(vs, nbytes > GROWTH_FACTOR ? nbytes : GROWTH_FACTOR);
 }
 
 /**
@@ -69,15 +80,20 @@ static void vstr_resize(VStr *vs, size_t nbytes)
  * @param[in] pos start position
  * @param[in] src source string
  * @param[in] nbyte number of bytes of @p src
+ *
+ * @return false if the allocator is out of memory, @p dst is left unchanged
  */
-INLINE static void vstr_append_unchecked(VStr *dst, size_t pos, const char *src, size_t nbyte)
+INLINE static bool vstr_append_unchecked(VStr *dst, size_t pos, const char *src, size_t nbyte)
 {
    size_t new_len = pos + nbyte;
 
-   vstr_reserve(dst, new_len);
+   if (!vstr_reserve(dst, new_len))
+      return false;
    memcpy(&dst->ptr[pos], src, nbyte);
    dst->ptr[pos + nbyte] = '\0';
    dst->len = new_len;
+
+   return true;
 }
 
 /**
@@ -94,7 +110,8 @@ INLINE static int vstr_vsprintf(VStr *dst, size_t pos, const char *format, va_li
    va_end(args_copy);
 
    if (n > 0) {
-      vstr_reserve(dst, pos + n);
+      if (!vstr_reserve(dst, pos + n))
+         return -1;
       vsnprintf(&dst->ptr[pos], n + 1, format, args);
       dst->len = pos + n;
    }
@@ -104,7 +121,15 @@ INLINE static int vstr_vsprintf(VStr *dst, size_t pos, const char *format, va_li
 
 void vstr_new(VStr *vs)
 {
+   vs->ptr = NULL;
    vs->cap = vs->len = 0;
+   vs->alloc = NULL;
+}
+
+void vstr_new_in(VStr *vs, const Allocator *alloc)
+{
+   vstr_new(vs);
+   vs->alloc = alloc;
 }
 
 void vstr_new_with(VStr *vs, size_t len)
@@ -123,7 +148,7 @@ void vstr_from(VStr *vs, const char *src)
 void vstr_free(VStr *vs)
 {
    if (vs->cap)
-      free(vs->ptr);
+      allocator_free(vs->alloc, vs->ptr, vs->cap);
    vs->cap = vs->len = 0;
 }
 
@@ -135,16 +160,18 @@ void vstr_truncate(VStr *vs, size_t new_len)
    }
 }
 
-void vstr_reserve(VStr *vs, size_t len)
+bool vstr_reserve(VStr *vs, size_t len)
 {
    if (len + 1 > vs->cap)
-      vstr_resize(vs, len + 1);
+      return vstr_resize(vs, len + 1);
+   return true;
 }
 
-void vstr_shrink_to_fit(VStr *vs)
+bool vstr_shrink_to_fit(VStr *vs)
 {
    if (vs->cap > vs->len + 1)
-      vstr_resize(vs, vs->len + 1);
+      return vstr_resize(vs, vs->len + 1);
+   return true;
 }
 
 bool vstr_insert(VStr *dst, size_t pos, const char *src, size_t nbyte)
@@ -154,7 +181,8 @@ bool vstr_insert(VStr *dst, size_t pos, const char *src, size_t nbyte)
 
    size_t new_len = dst->len + nbyte;
 
-   vstr_reserve(dst, new_len);
+   if (!vstr_reserve(dst, new_len))
+      return false;
    memmove(&dst->ptr[pos + nbyte], &dst->ptr[pos], dst->len - pos);
    memcpy(&dst->ptr[pos], src, nbyte);
    dst->ptr[new_len] = '\0';
@@ -165,7 +193,8 @@ bool vstr_insert(VStr *dst, size_t pos, const char *src, size_t nbyte)
 
 char *vstr_cpy(VStr *dst, const char *src)
 {
-   vstr_append_unchecked(dst, 0, src, strlen(src));
+   if (!vstr_append_unchecked(dst, 0, src, strlen(src)))
+      return NULL;
 
    return dst->ptr;
 }
@@ -177,14 +206,16 @@ char *vstr_ncpy(VStr *dst, const char *src, size_t nbyte)
    src_len = strlen(src);
    if (src_len < nbyte)
       nbyte = src_len;
-   vstr_append_unchecked(dst, 0, src, nbyte);
+   if (!vstr_append_unchecked(dst, 0, src, nbyte))
+      return NULL;
 
    return dst->ptr;
 }
 
 char *vstr_cat(VStr *dst, const char *src)
 {
-   vstr_append_unchecked(dst, dst->len, src, strlen(src));
+   if (!vstr_append_unchecked(dst, dst->len, src, strlen(src)))
+      return NULL;
 
    return dst->ptr;
 }
@@ -196,7 +227,8 @@ char *vstr_ncat(VStr *dst, const char *src, size_t nbyte)
    src_len = strlen(src);
    if (src_len < nbyte)
       nbyte = src_len;
-   vstr_append_unchecked(dst, dst->len, src, nbyte);
+   if (!vstr_append_unchecked(dst, dst->len, src, nbyte))
+      return NULL;
 
    return dst->ptr;
 }
@@ -14,6 +14,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "allocator.h"
+
 #ifdef _MSC_VER
    #define INLINE __inline
 #elif defined(__STDC__) && __STDC_VERSION__ >= 199901L
@@ -26,9 +28,10 @@
  * @brief dynamic heap-allocated string
  */
 typedef struct VStr {
-   char  *ptr; /**< underlying c-style string (access through vstr_data()) */
-   size_t len; /**< length of the Vstr */
-   size_t cap; /**< capacity allocated */
+   char            *ptr; /**< underlying c-style string (access through vstr_data()) */
+   size_t           len; /**< length of the Vstr */
+   size_t           cap; /**< capacity allocated */
+   const Allocator *alloc; /**< source of the memory of @p ptr , NULL for malloc */
 } VStr;
 
 /**
@@ -41,6 +44,17 @@ typedef struct VStr {
  */
 void vstr_new(VStr *vs);
 
+/**
+ * @brief new Vstr, that takes memory from @p alloc
+ *
+ * if the allocator runs out of memory, operations that need to grow the Vstr fail
+ * (returning false/NULL/-1) and leave it unchanged
+ *
+ * @param[out] vs Vstr
+ * @param[in] alloc allocator, it must outlive the Vstr. NULL for malloc
+ */
+void vstr_new_in(VStr *vs, const Allocator *alloc);
+
 /**
  * @brief new Vstr with reserved space
  *
@@ -81,15 +95,19 @@ void vstr_truncate(VStr *vs, size_t new_len);
  *
  * @param[in,out] vs Vstr
  * @param[in] len minimum number of characters to reserve memory for
+ *
+ * @return false if the allocator is out of memory
  */
-void vstr_reserve(VStr *vs, size_t len);
+bool vstr_reserve(VStr *vs, size_t len);
 
 /**
  * @brief shrink allocated memory to what is exactly needed for length
  *
  * @param[in,out] vs Vstr
+ *
+ * @return false if the allocator could not move the string, @p vs is left unchanged
  */
-void vstr_shrink_to_fit(VStr *vs);
+bool vstr_shrink_to_fit(VStr *vs);
 
 /**
  * @brief return the underlying c-style string, or NULL
@@ -158,7 +176,8 @@ bool vstr_insert(VStr *dest, size_t pos, const char *source, size_t num);
  * @param[in,out] dest Vstr
  * @param[in] source source c-style string
  * 
- * @return the underlying c-style string of @p dest
+ * @return the underlying c-style string of @p dest , or NULL if the allocator is out of memory
+ *         (@p dest is left unchanged)
  */
 char *vstr_cpy(VStr *dest, const char *source);
 
@@ -169,7 +188,8 @@ char *vstr_cpy(VStr *dest, const char *source);
  * @param[in] source source c-style string
  * @param[in] num max number of characters to copy
  * 
- * @return the underlying c-style string of @p dest
+ * @return the underlying c-style string of @p dest , or NULL if the allocator is out of memory
+ *         (@p dest is left unchanged)
  */
 char *vstr_ncpy(VStr *dest, const char *source, size_t num);
 
@@ -179,7 +199,8 @@ char *vstr_ncpy(VStr *dest, const char *source, size_t num);
  * @param[in,out] dest Vstr
  * @param[in] source source c-style string
  * 
- * @return the underlying c-style string of @p dest
+ * @return the underlying c-style string of @p dest , or NULL if the allocator is out of memory
+ *         (@p dest is left unchanged)
  */
 char *vstr_cat(VStr *dest, const char *source);
 
@@ -190,7 +211,8 @@ char *vstr_cat(VStr *dest, const char *source);
  * @param[in] source source c-style string
  * @param[in] num max number of characters to concat
  * 
- * @return the underlying c-style string of @p dest
+ * @return the underlying c-style string of @p dest , or NULL if the allocator is out of memory
+ *         (@p dest is left unchanged)
  */
 char *vstr_ncat(VStr *dest, const char *source, size_t num);
 
@@ -5,6 +5,7 @@
 #include <stdlib.h>
 
 #include "arena.h"
+#include "vec.h"
 
 void test_arena_init_deinit() {
    Arena arena;
@@ -121,6 +122,76 @@ void test_arena_realloc_non_last()
    printf("%s passed\n", __func__);
 }
 
+void test_arena_realloc_grow_last_full_block()
+{
+   Arena arena;
+   arena_init(&arena);
+
+   char *ptr = arena_alloc(&arena, 1024);
+   strcpy(ptr, "hello");
+
+   /* last allocation, but too big for the block: it has to move, with its data */
+   char *new_ptr = arena_realloc(&arena, 64 * 1024, ptr, 1024);
+   assert(new_ptr != NULL && new_ptr != ptr);
+   assert(strcmp(new_ptr, "hello") == 0);
+
+   arena_deinit(&arena);
+   
+   printf("%s passed\n", __func__);
+}
+
+void test_arena_realloc_fail()
+{
+   Arena arena;
+   arena_init(&arena);
+
+   char *ptr = arena_alloc(&arena, 16);
+   strcpy(ptr, "hello");
+
+   /* the last chunk is freed in place to grow it, then the allocation fails: it's still there */
+   assert(arena_realloc(&arena, (size_t)1 << 62, ptr, 16) == NULL);
+   char *next = arena_alloc(&arena, 16);
+   assert(next == ptr + 16);
+   memset(next, 'x', 16);
+   assert(strcmp(ptr, "hello") == 0);
+
+   arena_deinit(&arena);
+   
+   printf("%s passed\n", __func__);
+}
+
+void test_arena_allocator_vec()
+{
+   Arena     arena;
+   Allocator alloc;
+   Vec       v;
+
+   arena_init(&arena);
+   arena_allocator(&arena, &alloc);
+
+   vec_new_in(&v, sizeof(int), NULL, &alloc);
+   int zero = 0;
+   vec_push(&v, &zero);
+   void *first = v.ptr;
+
+   /* last allocation of the arena, grows in place */
+   for (int i = 1; i < 100; i++)
+      vec_push(&v, &i);
+   assert(v.ptr == first);
+   for (int i = 0; i < 100; i++)
+      assert(*(int *)vec_at(&v, i) == i);
+
+   /* everything goes away with the arena, no need to free the Vec */
+   arena_reset(&arena);
+   vec_new_in(&v, sizeof(int), NULL, &alloc);
+   vec_push(&v, &zero);
+   assert(v.ptr == first);
+
+   arena_deinit(&arena);
+   
+   printf("%s passed\n", __func__);
+}
+
 void test_arena_reset_and_reuse()
 {
    Arena arena;
@@ -166,6 +237,9 @@ int main()
    test_arena_free_non_last_alloc();
    test_arena_realloc_grow_last();
    test_arena_realloc_non_last();
+   test_arena_realloc_grow_last_full_block();
+   test_arena_realloc_fail();
+   test_arena_allocator_vec();
    test_arena_reset_and_reuse();
    test_arena_deinit_no_leaks();
    
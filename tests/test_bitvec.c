@@ -0,0 +1,176 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bitvec.h"
+#include "vec_scan.h"
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+/**
+ * @brief @p n random bits, set with probability 1 / @p one_in
+ */
+static void fill_random(BitVec *bv, bool *bits, size_t n, unsigned one_in)
+{
+   bool ok;
+
+   bitvec_new(bv);
+   for (size_t i = 0; i < n; i++) {
+      bits[i] = rng() % one_in == 0;
+      ok = bitvec_push(bv, bits[i]);
+      assert(ok);
+   }
+}
+
+static void test_bits(void)
+{
+   BitVec bv;
+   bool   ok;
+
+   bitvec_new(&bv);
+   assert(bitvec_len(&bv) == 0);
+   assert(bitvec_count(&bv) == 0);
+
+   ok = bitvec_resize(&bv, 200);
+   assert(ok);
+   assert(bitvec_count(&bv) == 0);
+   bitvec_set(&bv, 0);
+   bitvec_set(&bv, 63);
+   bitvec_set(&bv, 64);
+   bitvec_set(&bv, 199);
+   assert(bitvec_test(&bv, 63) && bitvec_test(&bv, 64) && !bitvec_test(&bv, 65));
+   assert(bitvec_count(&bv) == 4);
+   bitvec_clear(&bv, 63);
+   assert(!bitvec_test(&bv, 63));
+   assert(bitvec_count(&bv) == 3);
+
+   /* shrinking drops the bits past the end, growing again brings back 0s */
+   ok = bitvec_resize(&bv, 100);
+   assert(ok);
+   ok = bitvec_resize(&bv, 200);
+   assert(ok);
+   assert(!bitvec_test(&bv, 199));
+   assert(bitvec_count(&bv) == 2);
+
+   ok = bitvec_push(&bv, true);
+   assert(ok);
+   assert(bitvec_len(&bv) == 201 && bitvec_test(&bv, 200));
+
+   bitvec_free(&bv);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_bulk(void)
+{
+   VecScanIsa isas[] = {VEC_SCAN_SCALAR, VEC_SCAN_AVX2};
+   size_t     n = 1000;
+   bool      *a = malloc(n), *b = malloc(n);
+
+   for (size_t k = 0; k < 2; k++) {
+      BitVec x, y, r;
+      size_t cnt = 0;
+      bool   ok;
+
+      vec_scan_set_isa(isas[k]);
+      fill_random(&x, a, n, 2);
+      fill_random(&y, b, n, 3);
+
+      for (size_t i = 0; i < n; i++)
+         cnt += a[i];
+      assert(bitvec_count(&x) == cnt);
+
+      bitvec_new(&r);
+      ok = bitvec_and(&r, &x);
+      assert(!ok);
+
+#define CHECK_OP(fn, op)                                                                           \
+   do {                                                                                            \
+      bitvec_resize(&r, 0);                                                                        \
+      bitvec_resize(&r, n);                                                                        \
+      ok = bitvec_or(&r, &x);                                                                      \
+      assert(ok);                                                                                  \
+      ok = fn(&r, &y);                                                                             \
+      assert(ok);                                                                                  \
+      for (size_t i = 0; i < n; i++)                                                               \
+         assert(bitvec_test(&r, i) == (bool)(a[i] op b[i]));                                       \
+   } while (0)
+
+      CHECK_OP(bitvec_and, &);
+      CHECK_OP(bitvec_or, |);
+      CHECK_OP(bitvec_xor, ^);
+      CHECK_OP(bitvec_andnot, & !);
+
+#undef CHECK_OP
+
+      bitvec_free(&x);
+      bitvec_free(&y);
+      bitvec_free(&r);
+   }
+   vec_scan_set_isa(VEC_SCAN_AVX2);
+
+   free(a);
+   free(b);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_rank_select(void)
+{
+   size_t   sizes[] = {0, 1, 63, 64, 512, 513, 100000};
+   unsigned densities[] = {1, 2, 50, 5000};
+   bool    *bits = malloc(100000);
+
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+      for (size_t d = 0; d < sizeof(densities) / sizeof(*densities); d++) {
+         BitVec bv;
+         size_t rank = 0, n = sizes[s];
+         bool   ok;
+
+         fill_random(&bv, bits, n, densities[d]);
+         ok = bitvec_build_index(&bv);
+         assert(ok);
+
+         for (size_t i = 0; i < n; i++) {
+            assert(bitvec_rank(&bv, i) == rank);
+            if (bits[i]) {
+               assert(bitvec_select(&bv, rank) == i);
+               rank++;
+            }
+         }
+         assert(bitvec_rank(&bv, n) == rank);
+         assert(bitvec_select(&bv, rank) == n);
+
+         /* changes invalidate the index */
+         if (n) {
+            bitvec_set(&bv, 0);
+            assert(!bv.indexed);
+         }
+
+         bitvec_free(&bv);
+      }
+   }
+
+   free(bits);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_bits();
+   test_bulk();
+   test_rank_select();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,135 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "eytzinger.h"
+#include "vec_sort.h"
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+static size_t lower_bound_i32(const int32_t *arr, size_t len, int32_t key)
+{
+   size_t i = 0;
+
+   while (i < len && arr[i] < key)
+      i++;
+   return i;
+}
+
+static size_t upper_bound_i32(const int32_t *arr, size_t len, int32_t key)
+{
+   size_t i = 0;
+
+   while (i < len && arr[i] <= key)
+      i++;
+   return i;
+}
+
+static void test_bounds(void)
+{
+   size_t sizes[] = {0, 1, 2, 3, 7, 8, 100, 1000};
+
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+      Eytzinger ez;
+      Vec       v;
+      int32_t   queries[300];
+      size_t    out[300];
+
+      /* few distinct values, so there are duplicates, negative too */
+      vec_new(&v, sizeof(int32_t), NULL);
+      for (size_t i = 0; i < sizes[s]; i++) {
+         int32_t x = (int32_t)(rng() % 200) - 100;
+         vec_push(&v, &x);
+      }
+      vec_sort_radix(&v, VEC_I32);
+
+      eytzinger_new(&ez, &v, VEC_I32);
+      assert(eytzinger_len(&ez) == sizes[s]);
+
+      for (int32_t key = -110; key < 110; key++) {
+         size_t pos;
+
+         assert(eytzinger_lower_bound(&ez, &key) == lower_bound_i32(v.ptr, v.len, key));
+         assert(eytzinger_upper_bound(&ez, &key) == upper_bound_i32(v.ptr, v.len, key));
+         if (eytzinger_find(&ez, &key, &pos)) {
+            assert(pos == lower_bound_i32(v.ptr, v.len, key));
+            assert(*(int32_t *)vec_at(&v, pos) == key);
+         }
+         else
+            assert(upper_bound_i32(v.ptr, v.len, key) == lower_bound_i32(v.ptr, v.len, key));
+      }
+
+      /* batched, with a group that isn't full */
+      for (size_t i = 0; i < 300; i++)
+         queries[i] = (int32_t)(rng() % 220) - 110;
+      eytzinger_lower_bound_n(&ez, queries, 300, out);
+      for (size_t i = 0; i < 300; i++)
+         assert(out[i] == lower_bound_i32(v.ptr, v.len, queries[i]));
+
+      eytzinger_free(&ez);
+      vec_free(&v);
+   }
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_types(void)
+{
+   Eytzinger ez;
+   Vec       v;
+
+   /* 8 byte keys */
+   vec_new(&v, sizeof(uint64_t), NULL);
+   for (uint64_t i = 0; i < 5000; i++) {
+      uint64_t x = i * 3 + ((uint64_t)1 << 40);
+      vec_push(&v, &x);
+   }
+   eytzinger_new(&ez, &v, VEC_U64);
+   for (uint64_t i = 0; i < 5000; i++) {
+      uint64_t key = i * 3 + ((uint64_t)1 << 40);
+      uint64_t next = key + 1;
+      size_t   pos, batch;
+
+      assert(eytzinger_find(&ez, &key, &pos) && pos == i);
+      assert(!eytzinger_find(&ez, &next, NULL));
+      assert(eytzinger_lower_bound(&ez, &next) == i + 1);
+      eytzinger_lower_bound_n(&ez, &key, 1, &batch);
+      assert(batch == i);
+   }
+   eytzinger_free(&ez);
+   vec_free(&v);
+
+   /* floats, stored in 4 bytes */
+   float fs[] = {-1e9f, -2.5f, -0.5f, 0.0f, 0.25f, 3.0f, 1e9f};
+   vec_new(&v, sizeof(float), NULL);
+   vec_insert_n(&v, 0, fs, 7);
+   eytzinger_new(&ez, &v, VEC_F32);
+   for (size_t i = 0; i < 7; i++) {
+      size_t pos;
+      assert(eytzinger_find(&ez, &fs[i], &pos) && pos == i);
+   }
+   float mid = -1.0f;
+   assert(eytzinger_lower_bound(&ez, &mid) == 2);
+   eytzinger_free(&ez);
+   vec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_bounds();
+   test_types();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
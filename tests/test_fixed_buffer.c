@@ -5,6 +5,7 @@
 #include <stdlib.h>
 
 #include "fixed_buffer.h"
+#include "vstr.h"
 
 #define BUFFER_SIZE 1024
 
@@ -168,6 +169,96 @@ void test_fixed_buffer_exhaustion()
    printf("%s passed\n", __func__);
 }
 
+void test_fixed_buffer_realloc_out_of_space()
+{
+   FixedBuffer fb;
+   char        buffer[BUFFER_SIZE];
+
+   fixed_buffer_init(&fb, buffer, BUFFER_SIZE);
+
+   char *ptr = fixed_buffer_alloc(&fb, 64);
+   strcpy(ptr, "keep");
+
+   /* the failed grow must not leave the chunk free */
+   char *grown = fixed_buffer_realloc(&fb, BUFFER_SIZE * 2, ptr, 64);
+   assert(grown == NULL);
+   char *other = fixed_buffer_alloc(&fb, 64);
+   assert(other != NULL && other != ptr);
+   assert(strcmp(ptr, "keep") == 0);
+   
+   printf("%s passed\n", __func__);
+}
+
+void test_fixed_buffer_allocator_vstr()
+{
+   FixedBuffer fb;
+   Allocator   alloc;
+   char        buffer[BUFFER_SIZE];
+   VStr        vs;
+   bool        ok;
+
+   fixed_buffer_init(&fb, buffer, BUFFER_SIZE);
+   fixed_buffer_allocator(&fb, &alloc);
+
+   vstr_new_in(&vs, &alloc);
+   vstr_cpy(&vs, "hello");
+   assert((char *)vstr_data(&vs) >= buffer && (char *)vstr_data(&vs) < buffer + BUFFER_SIZE);
+
+   /* grows until the buffer is full, then fails leaving the string intact */
+   while (vstr_reserve(&vs, vs.len + 6))
+      vstr_cat(&vs, " world");
+   assert(vs.len < BUFFER_SIZE);
+   size_t len = vs.len;
+   ok = vstr_reserve(&vs, BUFFER_SIZE);
+   assert(!ok);
+   ok = vstr_insert(&vs, 0, "x", BUFFER_SIZE);
+   assert(!ok);
+   assert(vs.len == len);
+   assert(!strncmp(vstr_data(&vs), "hello world", 11));
+
+   vstr_free(&vs);
+   
+   printf("%s passed\n", __func__);
+}
+
+void test_fixed_buffer_allocator_vstr_full()
+{
+   FixedBuffer fb;
+   Allocator   alloc;
+   char        buffer[BUFFER_SIZE];
+   char        big[BUFFER_SIZE * 2];
+   VStr        vs;
+   char       *res;
+
+   fixed_buffer_init(&fb, buffer, BUFFER_SIZE);
+   fixed_buffer_allocator(&fb, &alloc);
+   memset(big, 'x', sizeof(big) - 1);
+   big[sizeof(big) - 1] = '\0';
+
+   vstr_new_in(&vs, &alloc);
+   res = vstr_cpy(&vs, "hello");
+   assert(res != NULL);
+
+   /* every copy and append that doesn't fit fails, leaving the string as it was */
+   res = vstr_cpy(&vs, big);
+   assert(res == NULL);
+   res = vstr_ncpy(&vs, big, BUFFER_SIZE + 1);
+   assert(res == NULL);
+   res = vstr_cat(&vs, big);
+   assert(res == NULL);
+   res = vstr_ncat(&vs, big, BUFFER_SIZE + 1);
+   assert(res == NULL);
+   assert(vs.len == 5 && strcmp(vstr_data(&vs), "hello") == 0);
+
+   /* what fits still goes through */
+   res = vstr_ncat(&vs, big, 3);
+   assert(res != NULL && strcmp(res, "helloxxx") == 0);
+
+   vstr_free(&vs);
+   
+   printf("%s passed\n", __func__);
+}
+
 int main()
 {
    test_fixed_buffer_alloc_basic();
@@ -179,6 +270,9 @@ int main()
    test_fixed_buffer_realloc_non_last();
    test_fixed_buffer_reset();
    test_fixed_buffer_exhaustion();
+   test_fixed_buffer_realloc_out_of_space();
+   test_fixed_buffer_allocator_vstr();
+   test_fixed_buffer_allocator_vstr_full();
 
    printf("%s suite passed!\n", __FILE__);
    return 0;
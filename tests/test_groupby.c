@@ -0,0 +1,203 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "groupby.h"
+
+#define NROWS 100000
+#define NKEYS 1000
+
+static void fill_columns(Vec *keys, Vec *vals, size_t key_size)
+{
+   vec_new(keys, key_size, NULL);
+   vec_new(vals, sizeof(int64_t), NULL);
+
+   srand(42);
+   for (size_t i = 0; i < NROWS; i++) {
+      uint64_t k = (uint64_t)(rand() % NKEYS);
+      int64_t  v = rand() % 2001 - 1000;
+      uint16_t k16 = (uint16_t)k;
+      uint32_t k32 = (uint32_t)k;
+
+      if (key_size == 2)
+         vec_push(keys, &k16);
+      else if (key_size == 4)
+         vec_push(keys, &k32);
+      else
+         vec_push(keys, &k);
+      vec_push(vals, &v);
+   }
+}
+
+/* reference result, with plain arrays since keys are < NKEYS */
+static void naive(const Vec *keys, const Vec *vals, GroupAgg *expected)
+{
+   for (size_t k = 0; k < NKEYS; k++) {
+      expected[k].count = 0;
+      expected[k].sum.i = 0;
+      expected[k].min.i = INT64_MAX;
+      expected[k].max.i = INT64_MIN;
+   }
+   for (size_t i = 0; i < keys->len; i++) {
+      uint64_t k = keys->size == 2   ? *(uint16_t *)vec_at(keys, i)
+                   : keys->size == 4 ? *(uint32_t *)vec_at(keys, i)
+                                     : *(uint64_t *)vec_at(keys, i);
+      int64_t  v = *(int64_t *)vec_at(vals, i);
+
+      expected[k].count++;
+      expected[k].sum.i += v;
+      if (v < expected[k].min.i)
+         expected[k].min.i = v;
+      if (v > expected[k].max.i)
+         expected[k].max.i = v;
+   }
+}
+
+static void check(const GroupBy *gb, const GroupAgg *expected)
+{
+   size_t groups = 0;
+
+   for (uint64_t k = 0; k < NKEYS; k++) {
+      uint16_t        k16 = (uint16_t)k;
+      uint32_t        k32 = (uint32_t)k;
+      const void     *key = gb->key_size == 2   ? (void *)&k16
+                            : gb->key_size == 4 ? (void *)&k32
+                                                : (void *)&k;
+      const GroupAgg *agg = groupby_get(gb, key);
+
+      if (!expected[k].count) {
+         assert(agg == NULL);
+         continue;
+      }
+      groups++;
+      assert(agg != NULL);
+      assert(agg->count == expected[k].count);
+      assert(agg->sum.i == expected[k].sum.i);
+      assert(agg->min.i == expected[k].min.i);
+      assert(agg->max.i == expected[k].max.i);
+   }
+   assert(groups == groupby_len(gb));
+}
+
+static void test_key_sizes(void)
+{
+   size_t    sizes[3] = {2, 4, 8};
+   GroupAgg *expected = malloc(NKEYS * sizeof(GroupAgg));
+
+   for (int s = 0; s < 3; s++) {
+      Vec     keys, vals;
+      GroupBy gb;
+
+      fill_columns(&keys, &vals, sizes[s]);
+      naive(&keys, &vals, expected);
+
+      groupby_new(&gb, sizes[s], GROUPBY_I64);
+      groupby_update(&gb, &keys, &vals);
+      check(&gb, expected);
+
+      groupby_free(&gb);
+      vec_free(&keys);
+      vec_free(&vals);
+   }
+   free(expected);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_partitioned_merge(void)
+{
+   Vec       keys, vals;
+   GroupBy   parts[4], total;
+   GroupAgg *expected = malloc(NKEYS * sizeof(GroupAgg));
+   size_t    chunk = NROWS / 4;
+
+   fill_columns(&keys, &vals, 8);
+   naive(&keys, &vals, expected);
+
+   groupby_new(&total, 8, GROUPBY_I64);
+   for (int p = 0; p < 4; p++) {
+      size_t end = p == 3 ? NROWS : (p + 1) * chunk;
+
+      groupby_new(&parts[p], 8, GROUPBY_I64);
+      groupby_update_range(&parts[p], &keys, &vals, p * chunk, end);
+   }
+   for (int p = 0; p < 4; p++) {
+      groupby_merge(&total, &parts[p]);
+      groupby_free(&parts[p]);
+   }
+   check(&total, expected);
+
+   /* collected columns line up */
+   Vec out_keys, out_aggs;
+   vec_new(&out_keys, sizeof(uint64_t), NULL);
+   vec_new(&out_aggs, sizeof(GroupAgg), NULL);
+   groupby_collect(&total, &out_keys, &out_aggs);
+   assert(out_keys.len == groupby_len(&total));
+   assert(out_aggs.len == groupby_len(&total));
+   for (size_t i = 0; i < out_keys.len; i++) {
+      uint64_t  k = *(uint64_t *)vec_at(&out_keys, i);
+      GroupAgg *agg = vec_at(&out_aggs, i);
+      assert(agg->sum.i == expected[k].sum.i);
+   }
+
+   vec_free(&out_keys);
+   vec_free(&out_aggs);
+   groupby_free(&total);
+   vec_free(&keys);
+   vec_free(&vals);
+   free(expected);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_f64_and_count(void)
+{
+   Vec     keys, vals;
+   GroupBy gb;
+   uint8_t k;
+   double  v;
+
+   vec_new(&keys, sizeof(uint8_t), NULL);
+   vec_new(&vals, sizeof(double), NULL);
+   for (int i = 0; i < 300; i++) {
+      k = (uint8_t)(i % 3);
+      v = i * 0.5;
+      vec_push(&keys, &k);
+      vec_push(&vals, &v);
+   }
+
+   groupby_new(&gb, 1, GROUPBY_F64);
+   groupby_update(&gb, &keys, &vals);
+   assert(groupby_len(&gb) == 3);
+
+   k = 1;
+   const GroupAgg *agg = groupby_get(&gb, &k);
+   assert(agg->count == 100);
+   assert(agg->min.f == 0.5);
+   assert(agg->max.f == 298 * 0.5);
+   groupby_free(&gb);
+
+   groupby_new(&gb, 1, GROUPBY_F64);
+   groupby_update(&gb, &keys, NULL);
+   k = 2;
+   assert(groupby_get(&gb, &k)->count == 100);
+   k = 3;
+   assert(groupby_get(&gb, &k) == NULL);
+   groupby_free(&gb);
+
+   vec_free(&keys);
+   vec_free(&vals);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_key_sizes();
+   test_partitioned_merge();
+   test_f64_and_count();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,266 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hamt.h"
+
+#if defined(_MSC_VER)
+   #if defined(strdup)
+      #undef strdup
+   #endif
+   #define strdup _strdup
+#endif
+
+static void test_set_get_remove(void)
+{
+   Hamt h;
+   bool ok;
+
+   hamt_new(&h, sizeof(int), sizeof(int), NULL, NULL, NULL);
+
+   for (int i = 0; i < 10000; i++) {
+      int val = i * 2;
+      ok = hamt_set(&h, &i, &val);
+      assert(!ok);
+   }
+   assert(hamt_len(&h) == 10000);
+
+   for (int i = 0; i < 10000; i += 2) {
+      int val = -i;
+      ok = hamt_set(&h, &i, &val);
+      assert(ok);
+   }
+   assert(hamt_len(&h) == 10000);
+
+   for (int i = 0; i < 10000; i++) {
+      const int *val = hamt_get(&h, &i, NULL);
+      assert(val && *val == (i % 2 ? i * 2 : -i));
+   }
+
+   int missing = 10000;
+   assert(!hamt_contains(&h, &missing));
+   ok = hamt_remove(&h, &missing);
+   assert(!ok);
+
+   for (int i = 0; i < 10000; i += 3) {
+      ok = hamt_remove(&h, &i);
+      assert(ok);
+   }
+   for (int i = 0; i < 10000; i++)
+      assert(hamt_contains(&h, &i) == (i % 3 != 0));
+
+   hamt_free(&h);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_snapshot(void)
+{
+   Hamt h, snap;
+
+   hamt_new(&h, sizeof(int), sizeof(int), NULL, NULL, NULL);
+   for (int i = 0; i < 1000; i++)
+      hamt_set(&h, &i, &i);
+
+   hamt_snapshot(&snap, &h);
+   assert(h.n_cloned == 0);
+
+   /* every write copies at most the path to its key */
+   for (int i = 0; i < 1000; i += 2) {
+      int val = -1;
+      hamt_set(&h, &i, &val);
+   }
+   for (int i = 1; i < 1000; i += 4)
+      hamt_remove(&h, &i);
+   int key = 5000;
+   hamt_set(&h, &key, &key);
+   assert(h.n_cloned > 0 && h.n_cloned < 1000);
+
+   /* the snapshot still sees the old version */
+   assert(hamt_len(&snap) == 1000);
+   for (int i = 0; i < 1000; i++)
+      assert(*(const int *)hamt_get(&snap, &i, NULL) == i);
+   assert(!hamt_contains(&snap, &key));
+
+   /* and the snapshot can be written without disturbing h */
+   hamt_remove(&snap, &key);
+   key = 0;
+   hamt_set(&snap, &key, &(int){42});
+   assert(*(const int *)hamt_get(&h, &key, NULL) == -1);
+
+   assert(hamt_len(&h) == 1000 - 250 + 1);
+   for (int i = 0; i < 1000; i++) {
+      const int *val = hamt_get(&h, &i, NULL);
+      if (i % 4 == 1)
+         assert(!val);
+      else
+         assert(*val == (i % 2 ? i : -1));
+   }
+
+   /* freeing in any order, the shared parts are released by the last one */
+   hamt_free(&h);
+   assert(*(const int *)hamt_get(&snap, &key, NULL) == 42);
+   hamt_free(&snap);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_no_copy_without_snapshot(void)
+{
+   Hamt h, snap;
+
+   hamt_new(&h, sizeof(int), sizeof(int), NULL, NULL, NULL);
+   for (int i = 0; i < 1000; i++)
+      hamt_set(&h, &i, &i);
+   for (int i = 0; i < 1000; i += 2)
+      hamt_remove(&h, &i);
+   assert(h.n_cloned == 0);
+
+   /* once the snapshot is gone, nodes are owned again */
+   hamt_snapshot(&snap, &h);
+   hamt_free(&snap);
+   for (int i = 0; i < 1000; i++)
+      hamt_set(&h, &i, &i);
+   assert(h.n_cloned == 0);
+
+   hamt_free(&h);
+
+   printf("%s passed\n", __func__);
+}
+
+static Hash weak_hash(const void *key, size_t size)
+{
+   return (Hash)(*(const int *)key % 4);
+}
+
+static void test_collisions(void)
+{
+   Hamt h, snap;
+   bool ok;
+
+   /* full hash collisions end up in the collision nodes */
+   hamt_new(&h, sizeof(int), sizeof(int), weak_hash, NULL, NULL);
+   for (int i = 0; i < 100; i++)
+      hamt_set(&h, &i, &i);
+   hamt_snapshot(&snap, &h);
+
+   for (int i = 0; i < 100; i += 2) {
+      ok = hamt_remove(&h, &i);
+      assert(ok);
+   }
+   for (int i = 0; i < 100; i++) {
+      assert(hamt_contains(&h, &i) == (i % 2 == 1));
+      assert(*(const int *)hamt_get(&snap, &i, NULL) == i);
+   }
+
+   for (int i = 1; i < 100; i += 2) {
+      ok = hamt_remove(&h, &i);
+      assert(ok);
+   }
+   assert(hamt_len(&h) == 0);
+   assert(hamt_len(&snap) == 100);
+
+   hamt_free(&snap);
+   hamt_free(&h);
+
+   printf("%s passed\n", __func__);
+}
+
+static void free_str(void *val)
+{
+   free(*(char **)val);
+}
+
+static void test_strings_free_fn(void)
+{
+   Hamt        h, snap;
+   const char *keys[] = {"alpha", "beta", "gamma"};
+   size_t      val_size;
+
+   hamt_new(&h, HASHMAP_LEN_STR, sizeof(char *), NULL, NULL, free_str);
+   for (int i = 0; i < 3; i++) {
+      char *val = strdup(keys[i]);
+      hamt_set(&h, keys[i], &val);
+   }
+
+   hamt_snapshot(&snap, &h);
+
+   /* the old value is still referenced by the snapshot, it must not be freed yet */
+   char *val = strdup("BETA");
+   hamt_set(&h, "beta", &val);
+   assert(!strcmp(*(char *const *)hamt_get(&snap, "beta", &val_size), "beta"));
+   assert(val_size == sizeof(char *));
+   assert(!strcmp(*(char *const *)hamt_get(&h, "beta", NULL), "BETA"));
+
+   hamt_free(&snap);
+
+   /* now it's owned, updated in place */
+   val = strdup("Beta");
+   hamt_set(&h, "beta", &val);
+   assert(!strcmp(*(char *const *)hamt_get(&h, "beta", NULL), "Beta"));
+   assert(hamt_contains(&h, "gamma"));
+   assert(!hamt_contains(&h, "delta"));
+
+   hamt_free(&h);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_iter_mem_usage(void)
+{
+   Hamt     h, snap;
+   HamtIter iter;
+   int      seen[500] = {0};
+   size_t   count = 0;
+
+   hamt_new(&h, sizeof(int), sizeof(int), NULL, NULL, NULL);
+   assert(hamt_mem_usage(&h) == 0);
+   for (int i = 0; i < 500; i++)
+      hamt_set(&h, &i, &i);
+   hamt_snapshot(&snap, &h);
+   for (int i = 0; i < 500; i += 2)
+      hamt_remove(&h, &i);
+
+   hamtiter_init(&iter, &snap);
+   while (hamtiter_next(&iter)) {
+      int key = *(const int *)hamtiter_key(&iter);
+      assert(*(const int *)hamtiter_val(&iter, NULL) == key);
+      seen[key]++;
+      count++;
+   }
+   assert(count == 500);
+   for (int i = 0; i < 500; i++)
+      assert(seen[i] == 1);
+
+   count = 0;
+   hamtiter_init(&iter, &h);
+   while (hamtiter_next(&iter)) {
+      assert(*(const int *)hamtiter_key(&iter) % 2 == 1);
+      count++;
+   }
+   assert(count == 250);
+
+   assert(hamt_mem_usage(&h) < hamt_mem_usage(&snap));
+
+   hamt_free(&h);
+   hamt_free(&snap);
+
+   hamtiter_init(&iter, &h);
+   assert(!hamtiter_next(&iter));
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_set_get_remove();
+   test_snapshot();
+   test_no_copy_without_snapshot();
+   test_collisions();
+   test_strings_free_fn();
+   test_iter_mem_usage();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
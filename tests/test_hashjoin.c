@@ -0,0 +1,154 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hashjoin.h"
+
+/**
+ * @brief sort (build, probe) pairs, so that they can be compared with the expected ones
+ */
+static int cmp_pair(const void *a, const void *b)
+{
+   const size_t *pa = a, *pb = b;
+
+   if (pa[0] != pb[0])
+      return pa[0] < pb[0] ? -1 : 1;
+   if (pa[1] != pb[1])
+      return pa[1] < pb[1] ? -1 : 1;
+   return 0;
+}
+
+static size_t *sorted_pairs(const Vec *build_rows, const Vec *probe_rows)
+{
+   size_t *pairs = malloc((build_rows->len * 2 + 1) * sizeof(size_t));
+
+   assert(build_rows->len == probe_rows->len);
+   for (size_t i = 0; i < build_rows->len; i++) {
+      pairs[i * 2] = *(size_t *)vec_at(build_rows, i);
+      pairs[i * 2 + 1] = *(size_t *)vec_at(probe_rows, i);
+   }
+   qsort(pairs, build_rows->len, sizeof(size_t) * 2, cmp_pair);
+
+   return pairs;
+}
+
+static void test_small(void)
+{
+   HashJoin hj;
+   Vec      build, probe, build_rows, probe_rows;
+   uint32_t build_keys[] = {5, 7, 5, 9};
+   uint32_t probe_keys[] = {1, 5, 9, 7, 5};
+
+   vec_from(&build, sizeof(uint32_t), build_keys, 4, NULL);
+   vec_from(&probe, sizeof(uint32_t), probe_keys, 5, NULL);
+   vec_new(&build_rows, sizeof(size_t), NULL);
+   vec_new(&probe_rows, sizeof(size_t), NULL);
+
+   hashjoin_build(&hj, &build);
+   size_t n_matches = hashjoin_probe(&hj, &probe, &build_rows, &probe_rows);
+   assert(n_matches == 6);
+
+   size_t *pairs = sorted_pairs(&build_rows, &probe_rows);
+   size_t  expected[] = {0, 1, 0, 4, 1, 3, 2, 1, 2, 4, 3, 2};
+   for (size_t i = 0; i < 12; i++)
+      assert(pairs[i] == expected[i]);
+   free(pairs);
+
+   hashjoin_free(&hj);
+   vec_free(&build);
+   vec_free(&probe);
+   vec_free(&build_rows);
+   vec_free(&probe_rows);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_empty(void)
+{
+   HashJoin hj;
+   Vec      build, probe, build_rows, probe_rows;
+   uint8_t  probe_keys[] = {1, 2, 3};
+
+   vec_new(&build, sizeof(uint8_t), NULL);
+   vec_from(&probe, sizeof(uint8_t), probe_keys, 3, NULL);
+   vec_new(&build_rows, sizeof(size_t), NULL);
+   vec_new(&probe_rows, sizeof(size_t), NULL);
+
+   hashjoin_build(&hj, &build);
+   size_t n_matches = hashjoin_probe(&hj, &probe, &build_rows, &probe_rows);
+   assert(n_matches == 0);
+   assert(build_rows.len == 0 && probe_rows.len == 0);
+
+   hashjoin_free(&hj);
+   vec_free(&build);
+   vec_free(&probe);
+   vec_free(&build_rows);
+   vec_free(&probe_rows);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_partitioned_vs_nested_loops(void)
+{
+   HashJoin hj;
+   Vec      build, probe, build_rows, probe_rows;
+   size_t   n_build = 20000, n_probe = 5000, n_expected = 0;
+
+   vec_new(&build, sizeof(uint64_t), NULL);
+   vec_new(&probe, sizeof(uint64_t), NULL);
+   vec_new(&build_rows, sizeof(size_t), NULL);
+   vec_new(&probe_rows, sizeof(size_t), NULL);
+
+   /* keys in a small domain, so there are duplicates on both sides */
+   srand(7);
+   for (size_t i = 0; i < n_build; i++) {
+      uint64_t key = (uint64_t)(rand() % 10000) << 20;
+      vec_push(&build, &key);
+   }
+   for (size_t i = 0; i < n_probe; i++) {
+      uint64_t key = (uint64_t)(rand() % 20000) << 20;
+      vec_push(&probe, &key);
+   }
+
+   /* partitions built in two halves, as two threads would */
+   hashjoin_new(&hj, &build);
+   assert(hashjoin_n_parts(&hj) > 1);
+   hashjoin_build_parts(&hj, 0, hashjoin_n_parts(&hj) / 2);
+   hashjoin_build_parts(&hj, hashjoin_n_parts(&hj) / 2, hashjoin_n_parts(&hj));
+
+   /* and probed in two ranges */
+   size_t n_matches = hashjoin_probe_range(&hj, &probe, 0, 1700, &build_rows, &probe_rows);
+   n_matches += hashjoin_probe_range(&hj, &probe, 1700, n_probe, &build_rows, &probe_rows);
+   assert(n_matches == build_rows.len);
+
+   size_t *pairs = sorted_pairs(&build_rows, &probe_rows);
+   for (size_t b = 0; b < n_build; b++) {
+      for (size_t p = 0; p < n_probe; p++) {
+         if (*(uint64_t *)vec_at(&build, b) != *(uint64_t *)vec_at(&probe, p))
+            continue;
+         assert(pairs[n_expected * 2] == b && pairs[n_expected * 2 + 1] == p);
+         n_expected++;
+      }
+   }
+   assert(n_expected == n_matches);
+   free(pairs);
+
+   hashjoin_free(&hj);
+   vec_free(&build);
+   vec_free(&probe);
+   vec_free(&build_rows);
+   vec_free(&probe_rows);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_small();
+   test_empty();
+   test_partitioned_vs_nested_loops();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -266,6 +266,249 @@ static void test_free_fn(void)
    printf("%s passed\n", __func__);
 }
 
+static void test_ttl(void)
+{
+   HashMap map;
+   hashmap_new(&map, sizeof(int), sizeof(int), NULL, NULL, NULL);
+
+   int k, v = 0;
+
+   assert(hashmap_enable_ttl(&map, 0));
+
+   for (k = 0; k < 100; k++)
+      hashmap_set(&map, &k, &v, NULL, NULL);
+   for (k = 0; k < 50; k++)
+      assert(hashmap_set_ttl(&map, &k, 10 + k % 5));
+
+   k = 1000;
+   assert(!hashmap_set_ttl(&map, &k, 10));
+
+   assert(hashmap_expire(&map, 9, TIMEWHEEL_UNBOUNDED) == 0);
+   assert(hashmap_len(&map) == 100);
+
+   /* budget bounds the work, the rest is picked up later */
+   assert(hashmap_expire(&map, 12, 5) == 5);
+   assert(hashmap_expire(&map, 12, TIMEWHEEL_UNBOUNDED) == 25);
+   assert(hashmap_len(&map) == 70);
+
+   /* expired but not collected: invisible to lookups and iteration */
+   size_t   n_iter = 0;
+   HashIter iter;
+
+   assert(hashmap_expire(&map, 13, 0) == 0);
+   hashiter_init(&iter, &map);
+   while (hashiter_next(&iter))
+      n_iter++;
+   assert(n_iter == 60);
+
+   /* read-only lookups leave it in place, modifications free it */
+   k = 3;
+   assert(!hashmap_contains(&map, &k));
+   assert(!hashmap_get(&map, &k, NULL));
+   assert(hashmap_len(&map) == 70);
+   assert(!hashmap_remove(&map, &k, NULL, NULL));
+   assert(hashmap_len(&map) == 69);
+
+   /* persistent again */
+   k = 4;
+   assert(hashmap_set_ttl(&map, &k, HASHMAP_TTL_NONE));
+   assert(hashmap_expire(&map, 100, TIMEWHEEL_UNBOUNDED) == 18);
+   assert(hashmap_contains(&map, &k));
+   assert(hashmap_len(&map) == 51);
+
+   /* removal of an entry with a pending TTL */
+   k = 60;
+   assert(hashmap_set_ttl(&map, &k, 5));
+   assert(hashmap_remove(&map, &k, NULL, NULL));
+   assert(hashmap_expire(&map, 200, TIMEWHEEL_UNBOUNDED) == 0);
+
+   assert(!hashmap_enable_ttl(&map, 0));
+
+   hashmap_free(&map);
+
+   printf("%s passed\n", __func__);
+}
+
+static void sum_ints(void *dst_val, const void *src_val)
+{
+   *(int *)dst_val += *(const int *)src_val;
+}
+
+static void test_merge(void)
+{
+   HashMap dst, src;
+   hashmap_new(&dst, sizeof(int), sizeof(int), NULL, NULL, NULL);
+   hashmap_new(&src, sizeof(int), sizeof(int), NULL, NULL, NULL);
+
+   int k, v;
+
+   for (k = 0; k < 100; k++) {
+      v = 1;
+      hashmap_set(&dst, &k, &v, NULL, NULL);
+   }
+   for (k = 50; k < 300; k++) {
+      v = 10;
+      hashmap_set(&src, &k, &v, NULL, NULL);
+   }
+
+   /* nodes are moved, not copied */
+   k = 200;
+   const int *moved = hashmap_get(&src, &k, NULL);
+
+   hashmap_merge(&dst, &src, sum_ints);
+
+   assert(hashmap_len(&dst) == 300);
+   assert(hashmap_len(&src) == 0);
+   assert(hashmap_get(&dst, &k, NULL) == moved);
+
+   for (k = 0; k < 300; k++) {
+      const int *out = hashmap_get(&dst, &k, NULL);
+      assert(out != NULL);
+      assert(*out == (k < 50 ? 1 : k < 100 ? 11 : 10));
+   }
+
+   /* src is still usable, and without merge_fn its values win */
+   k = 0;
+   v = 42;
+   hashmap_set(&src, &k, &v, NULL, NULL);
+   hashmap_merge(&dst, &src, NULL);
+   assert(*(const int *)hashmap_get(&dst, &k, NULL) == 42);
+   assert(hashmap_len(&dst) == 300);
+
+   /* merging into an empty map */
+   hashmap_free(&src);
+   hashmap_merge(&src, &dst, NULL);
+   assert(hashmap_len(&src) == 300);
+   assert(hashmap_len(&dst) == 0);
+
+   hashmap_free(&dst);
+   hashmap_free(&src);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_merge_strings_ttl(void)
+{
+   HashMap dst, src;
+   hashmap_new(&dst, HASHMAP_LEN_STR, HASHMAP_LEN_STR, NULL, NULL, NULL);
+   hashmap_new(&src, HASHMAP_LEN_STR, HASHMAP_LEN_STR, NULL, NULL, NULL);
+   hashmap_enable_ttl(&dst, 0);
+   hashmap_enable_ttl(&src, 0);
+
+   hashmap_set(&dst, "a", "1", NULL, NULL);
+   hashmap_set(&src, "a", "2", NULL, NULL);
+   hashmap_set(&src, "bb", "3", NULL, NULL);
+   hashmap_set_ttl(&src, "bb", 5);
+
+   hashmap_merge(&dst, &src, NULL);
+
+   assert(strcmp(hashmap_get(&dst, "a", NULL), "2") == 0);
+   assert(strcmp(hashmap_get(&dst, "bb", NULL), "3") == 0);
+   assert(hashmap_expire(&src, 10, TIMEWHEEL_UNBOUNDED) == 0);
+   assert(hashmap_expire(&dst, 10, TIMEWHEEL_UNBOUNDED) == 1);
+   assert(!hashmap_contains(&dst, "bb"));
+
+   hashmap_free(&dst);
+   hashmap_free(&src);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_clear_reuse(void)
+{
+   HashMap map;
+   hashmap_new(&map, sizeof(int), sizeof(int), NULL, NULL, NULL);
+
+   int   k, v;
+   void *first_val = NULL;
+
+   for (int batch = 0; batch < 3; batch++) {
+      for (k = 0; k < 1000; k++) {
+         v = k + batch;
+         hashmap_set(&map, &k, &v, NULL, NULL);
+      }
+      assert(hashmap_len(&map) == 1000);
+
+      k = 0;
+      assert(*(const int *)hashmap_get(&map, &k, NULL) == batch);
+
+      HashNode **buckets = map.buckets;
+      Hash       n_buckets = map.n_buckets;
+
+      hashmap_clear(&map);
+      assert(hashmap_len(&map) == 0);
+      assert(!hashmap_contains(&map, &k));
+      /* capacity is kept */
+      assert(map.buckets == buckets && map.n_buckets == n_buckets);
+   }
+
+   /* a removed entry's memory is handed to the next insertion */
+   k = 1;
+   v = 1;
+   hashmap_set(&map, &k, &v, NULL, NULL);
+   first_val = (void *)hashmap_get(&map, &k, NULL);
+   hashmap_remove(&map, &k, NULL, NULL);
+   k = 2;
+   hashmap_set(&map, &k, &v, NULL, NULL);
+   assert(hashmap_get(&map, &k, NULL) == first_val);
+
+   hashmap_free(&map);
+   assert(map.pool == NULL);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_clear_free_fn(void)
+{
+   HashMap map;
+   OwnsMem om;
+   hashmap_new(&map, HASHMAP_LEN_STR, sizeof(OwnsMem), NULL, NULL, (FreeFn)free_ownsmem);
+
+   hashmap_set(&map, "a", new_ownsmem(&om, "1"), NULL, NULL);
+   hashmap_set(&map, "a longer key, in another size class", new_ownsmem(&om, "2"), NULL, NULL);
+   assert(ownsmem_alloc_count == 2);
+
+   hashmap_clear(&map);
+   assert(ownsmem_alloc_count == 0);
+
+   /* too big to be recycled */
+   char big[1024];
+   memset(big, 'x', sizeof(big) - 1);
+   big[sizeof(big) - 1] = '\0';
+
+   hashmap_set(&map, "b", new_ownsmem(&om, "3"), NULL, NULL);
+   hashmap_set(&map, big, new_ownsmem(&om, "4"), NULL, NULL);
+   assert(hashmap_contains(&map, "b"));
+   assert(hashmap_contains(&map, big));
+   assert(hashmap_remove(&map, big, NULL, NULL));
+   hashmap_free(&map);
+   assert(ownsmem_alloc_count == 0);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_stats(void)
+{
+   HashMap   map;
+   HashStats stats;
+   hashmap_new(&map, sizeof(int), sizeof(int), fixed_hash, NULL, NULL);
+
+   hashmap_stats(&map, &stats);
+   assert(stats.n_items == 0 && stats.n_buckets == 0);
+
+   for (int k = 0; k < 10; k++)
+      hashmap_set(&map, &k, &k, NULL, NULL);
+
+   hashmap_stats(&map, &stats);
+   assert(stats.n_items == 10);
+   assert(stats.n_used == 1);
+   assert(stats.max_chain == 10);
+
+   hashmap_free(&map);
+
+   printf("%s passed\n", __func__);
+}
+
 int main(void)
 {
    test_insert_get_contains();
@@ -277,6 +520,12 @@ int main(void)
    test_len();
    test_custom_cmp_fn();
    test_free_fn();
+   test_ttl();
+   test_merge();
+   test_merge_strings_ttl();
+   test_clear_reuse();
+   test_clear_free_fn();
+   test_stats();
 
    printf("%s suite passed!\n", __FILE__);
    return 0;
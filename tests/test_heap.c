@@ -0,0 +1,165 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "heap.h"
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+static int cmp_int(const void *a, const void *b)
+{
+   int x = *(const int *)a, y = *(const int *)b;
+   return (x > y) - (x < y);
+}
+
+static void test_push_pop(void)
+{
+   size_t arities[] = {2, 4};
+
+   for (size_t a = 0; a < 2; a++) {
+      Heap h;
+      int  x, prev;
+      bool ok;
+
+      heap_new(&h, sizeof(int), cmp_int, arities[a]);
+      assert(heap_is_empty(&h));
+      assert(!heap_peek(&h));
+      ok = heap_pop(&h, &x);
+      assert(!ok);
+
+      for (int i = 0; i < 1000; i++) {
+         x = (int)(rng() % 500);
+         ok = heap_push(&h, &x);
+         assert(ok);
+      }
+      assert(heap_len(&h) == 1000);
+
+      /* out in order, duplicates too */
+      prev = -1;
+      for (int i = 0; i < 1000; i++) {
+         int top = *(int *)heap_peek(&h);
+         ok = heap_pop(&h, &x);
+         assert(ok && x == top && x >= prev);
+         prev = x;
+      }
+      assert(heap_is_empty(&h));
+
+      heap_free(&h);
+   }
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_heapify(void)
+{
+   size_t sizes[] = {0, 1, 2, 3, 4, 5, 17, 1000};
+
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+      for (size_t arity = 2; arity <= 4; arity += 2) {
+         Heap h;
+         Vec  v;
+         int  x, prev = -1;
+         bool ok;
+
+         vec_new(&v, sizeof(int), NULL);
+         for (size_t i = 0; i < sizes[s]; i++) {
+            x = (int)(rng() % 100);
+            vec_push(&v, &x);
+         }
+
+         ok = heap_from(&h, &v, cmp_int, arity);
+         assert(ok);
+         assert(v.len == 0 && v.ptr == NULL);
+         assert(heap_len(&h) == sizes[s]);
+
+         while (heap_pop(&h, &x)) {
+            assert(x >= prev);
+            prev = x;
+         }
+
+         heap_free(&h);
+      }
+   }
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_indexed(void)
+{
+   for (size_t arity = 2; arity <= 4; arity += 2) {
+      Heap   h;
+      int    keys[300], x, prev;
+      size_t id, n = 0;
+      bool   ok;
+
+      heap_new_indexed(&h, sizeof(int), cmp_int, arity);
+      assert(!heap_contains_id(&h, 0));
+
+      for (size_t i = 0; i < 300; i++) {
+         keys[i] = (int)(rng() % 10000);
+         ok = heap_push_id(&h, i, &keys[i]);
+         assert(ok);
+      }
+      ok = heap_push_id(&h, 7, &keys[7]);
+      assert(!ok);
+      assert(*(int *)heap_at_id(&h, 7) == keys[7]);
+
+      /* decrease some keys, increase others, remove a few */
+      for (size_t i = 0; i < 300; i += 3) {
+         keys[i] = i % 2 ? keys[i] - 5000 : keys[i] + 5000;
+         ok = heap_update_id(&h, i, &keys[i]);
+         assert(ok);
+      }
+      for (size_t i = 1; i < 300; i += 10) {
+         ok = heap_remove_id(&h, i, &x);
+         assert(ok && x == keys[i]);
+         assert(!heap_contains_id(&h, i));
+         keys[i] = -1;
+      }
+      ok = heap_remove_id(&h, 1, NULL);
+      assert(!ok);
+      ok = heap_update_id(&h, 1, &x);
+      assert(!ok);
+      ok = heap_update_id(&h, 1000, &x);
+      assert(!ok);
+
+      prev = -100000;
+      while (heap_pop_id(&h, &id, &x)) {
+         assert(x == keys[id] && x >= prev);
+         assert(!heap_contains_id(&h, id));
+         prev = x;
+         n++;
+      }
+      assert(n == 270);
+
+      /* ids can be reused once out */
+      x = 3;
+      ok = heap_push_id(&h, 7, &x);
+      assert(ok);
+      ok = heap_pop_id(&h, &id, NULL);
+      assert(ok && id == 7);
+
+      heap_free(&h);
+   }
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_push_pop();
+   test_heapify();
+   test_indexed();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,213 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ihashmap.h"
+
+typedef struct {
+   int       id;
+   int       value;
+   IHashNode node;
+} Item;
+
+typedef struct {
+   char      name[16];
+   IHashNode node;
+} Named;
+
+static const void *item_key(const IHashNode *node)
+{
+   return &ihashmap_entry(node, Item, node)->id;
+}
+
+static const void *named_key(const IHashNode *node)
+{
+   return ihashmap_entry(node, Named, node)->name;
+}
+
+static void test_insert_find(void)
+{
+   IHashMap   map;
+   Item       a = {.id = 1, .value = 10}, b = {.id = 2, .value = 20}, dup = {.id = 1, .value = 30};
+   IHashNode *existing;
+
+   ihashmap_new(&map, sizeof(int), item_key, NULL, NULL);
+
+   existing = ihashmap_insert(&map, &a.node);
+   assert(existing == NULL);
+   existing = ihashmap_insert(&map, &b.node);
+   assert(existing == NULL);
+   assert(ihashmap_len(&map) == 2);
+
+   /* duplicate key is not inserted, the existing node is returned */
+   existing = ihashmap_insert(&map, &dup.node);
+   assert(existing == &a.node);
+   assert(ihashmap_len(&map) == 2);
+
+   int        k = 2;
+   IHashNode *found = ihashmap_find(&map, &k);
+   assert(found == &b.node);
+   assert(ihashmap_entry(found, Item, node)->value == 20);
+
+   k = 3;
+   assert(ihashmap_find(&map, &k) == NULL);
+
+   ihashmap_free(&map);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_remove(void)
+{
+   IHashMap   map;
+   Item       items[3];
+   IHashNode *existing;
+
+   ihashmap_new(&map, sizeof(int), item_key, NULL, NULL);
+   for (int i = 0; i < 3; i++) {
+      items[i].id = i;
+      existing = ihashmap_insert(&map, &items[i].node);
+      assert(existing == NULL);
+   }
+
+   ihashmap_remove(&map, &items[1].node);
+   ihashmap_remove(&map, &items[0].node);
+   assert(ihashmap_len(&map) == 1);
+
+   int k = 2;
+   assert(ihashmap_find(&map, &k) == &items[2].node);
+   k = 1;
+   assert(ihashmap_find(&map, &k) == NULL);
+
+   ihashmap_remove(&map, &items[2].node);
+   assert(ihashmap_len(&map) == 0);
+
+   ihashmap_free(&map);
+
+   printf("%s passed\n", __func__);
+}
+
+static Hash zero_hash(const void *key, size_t size)
+{
+   return 0;
+}
+
+static void test_collisions(void)
+{
+   IHashMap map;
+   Item     items[5];
+
+   /* constant hash, so they all share a bucket and removal hits the middle and the head */
+   ihashmap_new(&map, sizeof(int), item_key, zero_hash, NULL);
+   for (int i = 0; i < 5; i++) {
+      items[i].id = i;
+      ihashmap_insert(&map, &items[i].node);
+   }
+
+   ihashmap_remove(&map, &items[2].node);
+   ihashmap_remove(&map, &items[4].node);
+
+   for (int i = 0; i < 5; i++) {
+      IHashNode *found = ihashmap_find(&map, &i);
+      assert(i == 2 || i == 4 ? found == NULL : found == &items[i].node);
+   }
+
+   HashStats stats;
+   ihashmap_stats(&map, &stats);
+   assert(stats.n_items == 3);
+   assert(stats.n_used == 1);
+   assert(stats.max_chain == 3);
+
+   ihashmap_free(&map);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_resize_iter(void)
+{
+   IHashMap   map;
+   IHashIter  iter;
+   IHashNode *node;
+   Item      *items = malloc(1000 * sizeof(Item));
+   size_t     count = 0;
+   bool       ok;
+
+   ihashmap_new(&map, sizeof(int), item_key, NULL, NULL);
+   for (int i = 0; i < 1000; i++) {
+      items[i].id = i;
+      items[i].value = 0;
+      ihashmap_insert(&map, &items[i].node);
+   }
+
+   HashStats stats;
+   ihashmap_stats(&map, &stats);
+   assert(stats.n_items == 1000);
+   assert(stats.load >= 0.25 && stats.load <= 0.75);
+
+   /* removing the current node while iterating is allowed */
+   ihashiter_init(&iter, &map);
+   while ((node = ihashiter_next(&iter)) != NULL) {
+      Item *item = ihashmap_entry(node, Item, node);
+      item->value++;
+      count++;
+      if (item->id % 2)
+         ihashmap_remove(&map, node);
+   }
+   assert(count == 1000);
+   assert(ihashmap_len(&map) == 500);
+   for (int i = 0; i < 1000; i++)
+      assert(items[i].value == 1);
+
+   for (int i = 0; i < 1000; i += 2)
+      ihashmap_remove(&map, &items[i].node);
+   for (int i = 0; i < 10; i++)
+      ihashmap_insert(&map, &items[i].node);
+
+   /* shrinking happens on insert or on request */
+   ihashmap_stats(&map, &stats);
+   assert(stats.n_buckets < 64);
+   for (int i = 0; i < 8; i++)
+      ihashmap_remove(&map, &items[i].node);
+   ok = ihashmap_rehash(&map);
+   assert(ok);
+   for (int i = 8; i < 10; i++)
+      assert(ihashmap_find(&map, &i) == &items[i].node);
+
+   ihashmap_free(&map);
+   free(items);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_string_keys(void)
+{
+   IHashMap map;
+   Named    a, b;
+
+   strcpy(a.name, "alpha");
+   strcpy(b.name, "beta");
+
+   ihashmap_new(&map, HASHMAP_LEN_STR, named_key, NULL, NULL);
+   ihashmap_insert(&map, &a.node);
+   ihashmap_insert(&map, &b.node);
+
+   assert(ihashmap_find(&map, "beta") == &b.node);
+   assert(ihashmap_find(&map, "gamma") == NULL);
+
+   ihashmap_free(&map);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_insert_find();
+   test_remove();
+   test_collisions();
+   test_resize_iter();
+   test_string_keys();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,127 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "packvec.h"
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+/**
+ * @brief every way to read the values back must give @p vals
+ */
+static void check(const PackVec *pv, const uint64_t *vals, size_t n)
+{
+   uint64_t *out = malloc((n + 1) * sizeof(uint64_t));
+   size_t    cnt;
+
+   assert(packvec_len(pv) == n);
+   for (size_t i = 0; i < n; i++)
+      assert(packvec_get(pv, i) == vals[i]);
+
+   cnt = packvec_decode(pv, 0, out, n + 1);
+   assert(cnt == n);
+   for (size_t i = 0; i < n; i++)
+      assert(out[i] == vals[i]);
+
+   /* ranges starting and ending inside blocks */
+   for (size_t pos = 0; pos < n; pos += 77) {
+      cnt = packvec_decode(pv, pos, out, 300);
+      assert(cnt == (n - pos < 300 ? n - pos : 300));
+      for (size_t i = 0; i < cnt; i++)
+         assert(out[i] == vals[pos + i]);
+   }
+   cnt = packvec_decode(pv, n, out, 1);
+   assert(cnt == 0);
+
+   free(out);
+}
+
+static void test_widths(void)
+{
+   PackVecMode modes[] = {PACKVEC_FOR, PACKVEC_DELTA};
+   uint64_t   *vals = malloc(1000 * sizeof(uint64_t));
+
+   for (size_t m = 0; m < 2; m++) {
+      /* every width from 0 to 64 bits */
+      for (unsigned width = 0; width <= 64; width++) {
+         PackVec  pv;
+         uint64_t mask = width == 64 ? UINT64_MAX : ((uint64_t)1 << width) - 1;
+         uint64_t acc = 1000;
+         bool     ok;
+
+         packvec_new(&pv, modes[m]);
+         for (size_t i = 0; i < 1000; i++) {
+            /* random values for FOR, sorted with random gaps for DELTA */
+            acc += rng() & mask;
+            vals[i] = modes[m] == PACKVEC_FOR ? 1000 + (rng() & mask) : acc;
+            if (i % 2) {
+               ok = packvec_push(&pv, vals[i]);
+               assert(ok);
+            }
+            else {
+               ok = packvec_push_n(&pv, &vals[i], 1);
+               assert(ok);
+            }
+         }
+         check(&pv, vals, 1000);
+         packvec_free(&pv);
+      }
+   }
+
+   free(vals);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_compression(void)
+{
+   PackVec   pv;
+   size_t    n = 100000;
+   uint64_t *vals = malloc(n * sizeof(uint64_t));
+   uint64_t  ts = 1700000000000000ull;
+   bool      ok;
+
+   /* timestamps with gaps below 2^12 */
+   for (size_t i = 0; i < n; i++) {
+      ts += rng() % 4096;
+      vals[i] = ts;
+   }
+
+   packvec_new(&pv, PACKVEC_DELTA);
+   ok = packvec_push_n(&pv, vals, n);
+   assert(ok);
+   check(&pv, vals, n);
+   assert(packvec_bytes(&pv) * 4 < n * sizeof(uint64_t));
+   packvec_free(&pv);
+
+   /* unsorted values still round trip with DELTA, they just don't shrink */
+   for (size_t i = 0; i < 1000; i++)
+      vals[i] = rng() % 100;
+   packvec_new(&pv, PACKVEC_DELTA);
+   ok = packvec_push_n(&pv, vals, 1000);
+   assert(ok);
+   check(&pv, vals, 1000);
+   packvec_free(&pv);
+
+   free(vals);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_widths();
+   test_compression();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,151 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "segvec.h"
+
+static void test_locate(void)
+{
+   size_t pos = 0;
+
+   /* segment by segment, the positions are consecutive */
+   for (size_t seg = 0; seg < 16; seg++) {
+      for (size_t i = 0; i < segvec_seg_len(seg); i++, pos++) {
+         size_t offset;
+         assert(segvec_locate(pos, &offset) == seg);
+         assert(offset == i);
+      }
+   }
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_stable(void)
+{
+   SegVec sv;
+   int   *ptrs[5000];
+   bool   ok;
+
+   segvec_new(&sv, sizeof(int), NULL);
+   assert(!segvec_at(&sv, 0));
+   ok = segvec_pop(&sv, NULL);
+   assert(!ok);
+
+   for (int i = 0; i < 5000; i++) {
+      ptrs[i] = segvec_push(&sv, &i);
+      assert(ptrs[i] && *ptrs[i] == i);
+   }
+   assert(segvec_len(&sv) == 5000);
+
+   /* growing never moved anything */
+   for (int i = 0; i < 5000; i++) {
+      assert(segvec_at(&sv, i) == ptrs[i]);
+      assert(*ptrs[i] == i);
+   }
+   assert(!segvec_at(&sv, 5000));
+
+   int x;
+   ok = segvec_pop(&sv, &x);
+   assert(ok && x == 4999);
+   segvec_truncate(&sv, 100);
+   assert(segvec_len(&sv) == 100);
+   int *again = segvec_push(&sv, NULL);
+   assert(again == ptrs[100]);
+   assert(*ptrs[100] == 0);
+
+   segvec_free(&sv);
+   assert(segvec_len(&sv) == 0);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_bulk_segs(void)
+{
+   SegVec sv;
+   int    arr[1000];
+   size_t seg, len, total = 0;
+   int   *ptr;
+   bool   ok;
+
+   for (int i = 0; i < 1000; i++)
+      arr[i] = i;
+
+   segvec_new(&sv, sizeof(int), NULL);
+   ok = segvec_reserve(&sv, 100);
+   assert(ok);
+   assert(sv.cap >= 100);
+   ok = segvec_push_n(&sv, arr, 10);
+   assert(ok);
+   ok = segvec_push_n(&sv, arr + 10, 990);
+   assert(ok);
+   ok = segvec_push_n(&sv, NULL, 5);
+   assert(ok);
+   assert(segvec_len(&sv) == 1005);
+   for (int i = 0; i < 1000; i++)
+      assert(*(int *)segvec_at(&sv, i) == i);
+   assert(*(int *)segvec_at(&sv, 1004) == 0);
+
+   /* the segments, in order, are all the elements */
+   for (seg = 0; (ptr = segvec_seg(&sv, seg, &len)); seg++) {
+      assert(len > 0);
+      for (size_t i = 0; i < len; i++)
+         assert(ptr[i] == (total + i < 1000 ? (int)(total + i) : 0));
+      total += len;
+   }
+   assert(total == 1005);
+
+   segvec_free(&sv);
+
+   printf("%s passed\n", __func__);
+}
+
+static void free_str(void *ptr)
+{
+   free(*(char **)ptr);
+}
+
+static void test_free_fn_alloc(void)
+{
+   Arena     arena;
+   Allocator alloc;
+   SegVec    sv;
+   char     *s, **pushed;
+   bool      ok;
+
+   arena_init(&arena);
+   arena_allocator(&arena, &alloc);
+
+   segvec_new_in(&sv, sizeof(char *), free_str, &alloc);
+   for (int i = 0; i < 100; i++) {
+      s = malloc(16);
+      snprintf(s, 16, "%d", i);
+      pushed = segvec_push(&sv, &s);
+      assert(pushed);
+   }
+
+   /* taken out, so it's ours to free */
+   ok = segvec_pop(&sv, &s);
+   assert(ok && s[0] == '9' && s[1] == '9');
+   free(s);
+
+   ok = segvec_pop(&sv, NULL);
+   assert(ok);
+   segvec_truncate(&sv, 50);
+   segvec_free(&sv);
+   arena_deinit(&arena);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_locate();
+   test_stable();
+   test_bulk_segs();
+   test_free_fn_alloc();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,162 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+#include "soa.h"
+
+typedef struct {
+   int64_t id;
+   double  price;
+   char    flag;
+} Rec;
+
+static const size_t rec_sizes[] = {
+   SOA_FIELD_SIZE(Rec, id),
+   SOA_FIELD_SIZE(Rec, price),
+   SOA_FIELD_SIZE(Rec, flag),
+};
+
+static void push_rec(Soa *s, const Rec *r)
+{
+   bool ok = soa_push(s, (const void *[]){&r->id, &r->price, &r->flag});
+
+   assert(ok);
+}
+
+static void test_push_at(void)
+{
+   Soa  s;
+   bool ok;
+
+   ok = soa_new(&s, rec_sizes, 3);
+   assert(ok);
+   assert(soa_len(&s) == 0);
+   assert(!soa_at(&s, 0, 0));
+
+   for (int64_t i = 0; i < 1000; i++) {
+      Rec r = {i, (double)i * 1.5, (char)(i % 2)};
+      push_rec(&s, &r);
+   }
+   assert(soa_len(&s) == 1000);
+
+   /* columns are contiguous and aligned */
+   int64_t *ids = soa_col(&s, 0);
+   double  *prices = soa_col(&s, 1);
+   char    *flags = soa_col(&s, 2);
+   for (size_t c = 0; c < 3; c++)
+      assert((uintptr_t)soa_col(&s, c) % 64 == 0);
+   for (int64_t i = 0; i < 1000; i++) {
+      assert(ids[i] == i);
+      assert(prices[i] == (double)i * 1.5);
+      assert(flags[i] == i % 2);
+   }
+
+   assert(*(double *)soa_at(&s, 10, 1) == 15.0);
+   assert(!soa_at(&s, 1000, 0));
+   assert(!soa_at(&s, 0, 3));
+
+   Rec r;
+   ok = soa_get(&s, 7, (void *[]){&r.id, &r.price, &r.flag});
+   assert(ok);
+   assert(r.id == 7 && r.price == 10.5 && r.flag == 1);
+   ok = soa_get(&s, 1000, (void *[]){&r.id, &r.price, &r.flag});
+   assert(!ok);
+
+   /* NULL fields are zeroed */
+   r.price = 0;
+   ok = soa_push(&s, (const void *[]){&r.id, NULL, NULL});
+   assert(ok);
+   ok = soa_push(&s, NULL);
+   assert(ok);
+   assert(*(int64_t *)soa_at(&s, 1000, 0) == 7);
+   assert(*(double *)soa_at(&s, 1000, 1) == 0.0);
+   assert(*(int64_t *)soa_at(&s, 1001, 0) == 0);
+
+   soa_truncate(&s, 500);
+   assert(soa_len(&s) == 500);
+
+   soa_free(&s);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_swap_remove(void)
+{
+   Soa     s;
+   int64_t id;
+   bool    ok;
+
+   ok = soa_new(&s, rec_sizes, 3);
+   assert(ok);
+   for (int64_t i = 0; i < 10; i++) {
+      Rec r = {i, (double)i, 'a'};
+      push_rec(&s, &r);
+   }
+
+   ok = soa_swap_remove(&s, 2, (void *[]){&id, NULL, NULL});
+   assert(ok);
+   assert(id == 2);
+   assert(soa_len(&s) == 9);
+   assert(*(int64_t *)soa_at(&s, 2, 0) == 9);
+   assert(*(double *)soa_at(&s, 2, 1) == 9.0);
+
+   /* the last row */
+   ok = soa_swap_remove(&s, 8, NULL);
+   assert(ok);
+   assert(soa_len(&s) == 8);
+   assert(*(int64_t *)soa_at(&s, 7, 0) == 7);
+
+   ok = soa_swap_remove(&s, 8, NULL);
+   assert(!ok);
+
+   while (soa_len(&s)) {
+      ok = soa_swap_remove(&s, 0, NULL);
+      assert(ok);
+   }
+   ok = soa_swap_remove(&s, 0, NULL);
+   assert(!ok);
+
+   soa_free(&s);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_allocator(void)
+{
+   Arena     arena;
+   Allocator alloc;
+   Soa       s;
+   bool      ok;
+
+   arena_init(&arena);
+   arena_allocator(&arena, &alloc);
+
+   ok = soa_new_in(&s, rec_sizes, 3, &alloc);
+   assert(ok);
+   ok = soa_reserve(&s, 100);
+   assert(ok);
+   assert(s.cap >= 100);
+   for (int64_t i = 0; i < 300; i++) {
+      Rec r = {i, 0, 0};
+      push_rec(&s, &r);
+   }
+   for (int64_t i = 0; i < 300; i++)
+      assert(*(int64_t *)soa_at(&s, i, 0) == i);
+
+   soa_free(&s);
+   arena_deinit(&arena);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_push_at();
+   test_swap_remove();
+   test_allocator();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,72 @@
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "threadpool.h"
+
+typedef struct {
+   atomic_size_t sum;
+   atomic_int   *hits; /**< times each task ran */
+} Job;
+
+static void add_task(void *ctx, size_t idx)
+{
+   Job *job = ctx;
+
+   atomic_fetch_add(&job->sum, idx);
+   atomic_fetch_add(&job->hits[idx], 1);
+}
+
+static void run_job(ThreadPool *pool, size_t n_tasks)
+{
+   Job job;
+
+   atomic_init(&job.sum, 0);
+   job.hits = calloc(n_tasks + 1, sizeof(atomic_int));
+
+   threadpool_run(pool, add_task, &job, n_tasks);
+
+   /* every task ran exactly once */
+   assert(atomic_load(&job.sum) == (n_tasks ? n_tasks * (n_tasks - 1) / 2 : 0));
+   for (size_t i = 0; i < n_tasks; i++)
+      assert(atomic_load(&job.hits[i]) == 1);
+
+   free(job.hits);
+}
+
+static void test_run(void)
+{
+   size_t     sizes[] = {0, 1, 2, 7, 1000, 100000};
+   size_t     threads[] = {1, 2, 4, 0};
+   ThreadPool pool;
+   bool       ok;
+
+   for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); t++) {
+      ok = threadpool_new(&pool, threads[t]);
+      assert(ok);
+      assert(threadpool_n_threads(&pool) == (threads[t] ? threads[t] : threadpool_n_cpus()));
+
+      /* the same pool runs many jobs */
+      for (int rep = 0; rep < 20; rep++) {
+         for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++)
+            run_job(&pool, sizes[s]);
+      }
+
+      threadpool_free(&pool);
+   }
+
+   /* no pool, everything on the calling thread */
+   assert(threadpool_n_threads(NULL) == 1);
+   run_job(NULL, 1000);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_run();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,254 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "timewheel.h"
+
+typedef struct {
+   int   id;
+   Timer timer;
+} TestTimer;
+
+static size_t collect(TimeWheel *tw, Tick now, size_t budget, int *ids)
+{
+   LList  expired;
+   LNode *curr, *next;
+   size_t n, i = 0;
+
+   llist_init(&expired);
+   n = timewheel_advance(tw, now, &expired, budget);
+
+   llist_foreach(&expired, curr, next) {
+      TestTimer *t = timer_entry(curr, TestTimer, timer.link);
+      llist_remove(curr);
+      if (ids)
+         ids[i] = t->id;
+      i++;
+   }
+   assert(i == n);
+
+   return n;
+}
+
+static void test_init_empty(void)
+{
+   TimeWheel tw;
+   size_t    n;
+
+   timewheel_init(&tw, 100);
+
+   assert(tw.now == 100);
+   n = collect(&tw, 1000, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 0);
+   assert(tw.now == 1000);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_expire_in_order(void)
+{
+   TimeWheel tw;
+   TestTimer timers[3];
+   int       ids[3];
+   size_t    n;
+
+   timewheel_init(&tw, 0);
+   for (int i = 0; i < 3; i++) {
+      timers[i].id = i;
+      timer_init(&timers[i].timer);
+   }
+
+   timewheel_add(&tw, &timers[0].timer, 30);
+   timewheel_add(&tw, &timers[1].timer, 10);
+   timewheel_add(&tw, &timers[2].timer, 20);
+
+   n = collect(&tw, 9, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 0);
+   n = collect(&tw, 20, TIMEWHEEL_UNBOUNDED, ids);
+   assert(n == 2);
+   assert(ids[0] == 1 && ids[1] == 2);
+   assert(timer_pending(&timers[0].timer));
+   n = collect(&tw, 30, TIMEWHEEL_UNBOUNDED, ids);
+   assert(n == 1);
+   assert(ids[0] == 0);
+   assert(tw.n_timers == 0);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_cascade(void)
+{
+   TimeWheel tw;
+   TestTimer timers[5];
+   Tick      expires[5] = {63, 64, 4095, 4097, 300000};
+   size_t    n;
+
+   timewheel_init(&tw, 0);
+   for (int i = 0; i < 5; i++) {
+      timers[i].id = i;
+      timer_init(&timers[i].timer);
+      timewheel_add(&tw, &timers[i].timer, expires[i]);
+   }
+
+   for (int i = 0; i < 5; i++) {
+      int id;
+
+      n = collect(&tw, expires[i] - 1, TIMEWHEEL_UNBOUNDED, NULL);
+      assert(n == 0);
+      n = collect(&tw, expires[i], TIMEWHEEL_UNBOUNDED, &id);
+      assert(n == 1);
+      assert(id == i);
+   }
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_beyond_range(void)
+{
+   TimeWheel tw;
+   TestTimer t;
+   size_t    n;
+   Tick      far = ((Tick)1 << (TIMEWHEEL_SLOT_BITS * TIMEWHEEL_LEVELS)) * 3 + 5;
+
+   timewheel_init(&tw, 0);
+   timer_init(&t.timer);
+   t.id = 42;
+   timewheel_add(&tw, &t.timer, far);
+
+   n = collect(&tw, far - 1, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 0);
+   n = collect(&tw, far, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 1);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_remove_and_past(void)
+{
+   TimeWheel tw;
+   TestTimer t1, t2;
+   int       id;
+   size_t    n;
+
+   timewheel_init(&tw, 50);
+   timer_init(&t1.timer);
+   timer_init(&t2.timer);
+   t1.id = 1;
+   t2.id = 2;
+
+   /* removing a timer that was never added is fine */
+   timewheel_remove(&tw, &t1.timer);
+
+   timewheel_add(&tw, &t1.timer, 60);
+   timewheel_add(&tw, &t2.timer, 10);
+   timewheel_remove(&tw, &t1.timer);
+   assert(!timer_pending(&t1.timer));
+
+   /* already expired, collected on the next advance even without moving the clock */
+   n = collect(&tw, 50, TIMEWHEEL_UNBOUNDED, &id);
+   assert(n == 1);
+   assert(id == 2);
+   n = collect(&tw, 100, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 0);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_budget(void)
+{
+   TimeWheel  tw;
+   TestTimer *timers = malloc(100 * sizeof(TestTimer));
+   size_t     total = 0;
+
+   timewheel_init(&tw, 0);
+   for (int i = 0; i < 100; i++) {
+      timers[i].id = i;
+      timer_init(&timers[i].timer);
+      timewheel_add(&tw, &timers[i].timer, 1 + i % 10);
+   }
+
+   while (tw.n_timers) {
+      size_t n = collect(&tw, 1000, 7, NULL);
+      assert(n <= 7);
+      total += n;
+   }
+   assert(total == 100);
+
+   free(timers);
+
+   printf("%s passed\n", __func__);
+}
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+static void test_jumps(void)
+{
+   TimeWheel  tw;
+   TestTimer  t;
+   TestTimer *timers = malloc(500 * sizeof(TestTimer));
+   Tick       now = 0;
+   size_t     n, n_fired = 0;
+
+   /* a single far-future timer and a huge jump: the empty ticks are skipped */
+   timewheel_init(&tw, 0);
+   timer_init(&t.timer);
+   t.id = 0;
+   timewheel_add(&tw, &t.timer, 3000000000ull);
+   n = collect(&tw, 1000000000ull, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 0);
+   n = collect(&tw, 2999999999ull, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 0);
+   n = collect(&tw, 3000000000ull, TIMEWHEEL_UNBOUNDED, NULL);
+   assert(n == 1);
+
+   /* random expirations and random steps: every timer fires once, in the step of its tick */
+   timewheel_init(&tw, 0);
+   for (int i = 0; i < 500; i++) {
+      timers[i].id = i;
+      timer_init(&timers[i].timer);
+      timewheel_add(&tw, &timers[i].timer, rng() % 20000000);
+   }
+   while (n_fired < 500) {
+      LList  expired;
+      LNode *curr, *next;
+      Tick   prev = now;
+
+      now += rng() % 100000;
+      llist_init(&expired);
+      timewheel_advance(&tw, now, &expired, TIMEWHEEL_UNBOUNDED);
+      llist_foreach(&expired, curr, next) {
+         Timer *timer = timer_entry(curr, Timer, link);
+
+         assert(timer->expire <= now && (timer->expire > prev || !prev));
+         llist_remove(curr);
+         n_fired++;
+      }
+   }
+   assert(tw.n_timers == 0);
+
+   free(timers);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_init_empty();
+   test_expire_in_order();
+   test_cascade();
+   test_beyond_range();
+   test_remove_and_past();
+   test_budget();
+   test_jumps();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -245,6 +246,223 @@ void test_vec_autofree()
    printf("%s passed\n", __func__);
 }
 
+void test_vec_inline()
+{
+   SMALLVEC(int, 4) sv;
+   smallvec_init(&sv, NULL);
+   assert(sv.vec.cap == 4);
+   assert(sv.vec.ptr == sv.buf);
+
+   for (int i = 0; i < 4; i++)
+      vec_push(&sv.vec, &i);
+   assert(sv.vec.ptr == sv.buf);
+   vec_shrink_to_fit(&sv.vec);
+   assert(sv.vec.ptr == sv.buf);
+
+   /* spills to the heap, keeping the elements */
+   int five = 5;
+   vec_insert(&sv.vec, 0, &five);
+   assert(sv.vec.ptr != sv.buf);
+   assert(!(sv.vec.flags & VEC_BORROWED));
+   assert(sv.vec.len == 5);
+   for (int i = 0; i < 4; i++)
+      assert(*(int *)vec_at(&sv.vec, i + 1) == i);
+   vec_free(&sv.vec);
+
+   /* free doesn't touch the inline storage */
+   char buf[16];
+   Vec  v;
+   vec_new_inline(&v, sizeof(char), buf, sizeof(buf), NULL);
+   vec_insert_n(&v, 0, "hello", 6);
+   assert(!strcmp(v.ptr, "hello"));
+   vec_free(&v);
+   assert(v.ptr == NULL && v.cap == 0);
+   
+   printf("%s passed\n", __func__);
+}
+
+void test_vec_mmap()
+{
+   Vec v;
+
+   vec_set_mmap_threshold(1 << 20);
+
+   /* starts on the heap, moves to a mapping past the threshold, and keeps growing there */
+   vec_new(&v, sizeof(int), NULL);
+   for (int i = 0; i < 1000000; i++)
+      vec_push(&v, &i);
+#ifdef __linux__
+   assert(v.flags & VEC_MAPPED);
+#endif
+   for (int i = 0; i < 1000000; i++)
+      assert(*(int *)vec_at(&v, i) == i);
+
+   vec_truncate(&v, 300000);
+   vec_shrink_to_fit(&v);
+   assert(v.cap == 300000);
+   assert(*(int *)vec_at(&v, 299999) == 299999);
+   vec_free(&v);
+   assert(v.ptr == NULL && v.flags == 0);
+
+   /* below the threshold nothing changes */
+   vec_new_with(&v, sizeof(int), 1000, NULL);
+   assert(!(v.flags & VEC_MAPPED));
+   vec_free(&v);
+
+   vec_set_mmap_threshold(0);
+   
+   printf("%s passed\n", __func__);
+}
+
+void test_vec_aligned()
+{
+   typedef struct {
+      int x, y, z;
+   } Triple;
+
+   size_t aligns[] = {32, 64, 4096};
+   Vec    v;
+
+   for (size_t a = 0; a < sizeof(aligns) / sizeof(*aligns); a++) {
+      size_t align = aligns[a];
+
+      /* the capacity includes the padding to a multiple of the alignment */
+      vec_new_aligned(&v, sizeof(int), 10, align, NULL);
+      assert((uintptr_t)v.ptr % align == 0);
+      assert(v.cap >= 10 && v.cap * sizeof(int) % align == 0);
+
+      /* stays aligned while growing and shrinking */
+      for (int i = 0; i < 100000; i++) {
+         vec_push(&v, &i);
+         assert((uintptr_t)v.ptr % align == 0);
+      }
+      for (int i = 0; i < 100000; i++)
+         assert(*(int *)vec_at(&v, i) == i);
+      vec_truncate(&v, 1000);
+      vec_shrink_to_fit(&v);
+      assert((uintptr_t)v.ptr % align == 0 && v.cap >= 1000 && v.cap * sizeof(int) % align == 0);
+      assert(*(int *)vec_at(&v, 999) == 999);
+
+      /* and after being freed */
+      vec_free(&v);
+      assert(v.align == align);
+      vec_push(&v, &align);
+      assert((uintptr_t)v.ptr % align == 0);
+      vec_free(&v);
+
+      /* elements that don't divide the alignment */
+      vec_new_aligned(&v, sizeof(Triple), 0, align, NULL);
+      for (int i = 0; i < 1000; i++) {
+         Triple t = {i, -i, i * 2};
+         vec_push(&v, &t);
+         assert((uintptr_t)v.ptr % align == 0);
+      }
+      assert(((Triple *)vec_at(&v, 999))->z == 1998);
+      vec_free(&v);
+   }
+
+   /* mappings are page aligned */
+   vec_set_mmap_threshold(1 << 20);
+   vec_new_aligned(&v, sizeof(int), 0, 64, NULL);
+   for (int i = 0; i < 1000000; i++)
+      vec_push(&v, &i);
+   assert((uintptr_t)v.ptr % 64 == 0);
+   assert(*(int *)vec_at(&v, 999999) == 999999);
+   vec_free(&v);
+   vec_set_mmap_threshold(0);
+
+   printf("%s passed\n", __func__);
+}
+
+static bool is_even(const void *elem, void *ctx)
+{
+   (void)ctx;
+   return *(const int *)elem % 2 == 0;
+}
+
+static bool keep_first_n(const void *elem, void *ctx)
+{
+   (void)elem;
+   return (*(int *)ctx)-- > 0;
+}
+
+void test_vec_bulk_remove()
+{
+   Vec    v;
+   int    x;
+   size_t removed;
+   bool   ok;
+
+   /* retain */
+   vec_new(&v, sizeof(int), NULL);
+   for (int i = 0; i < 1000; i++)
+      vec_push(&v, &i);
+   removed = vec_retain(&v, is_even, NULL);
+   assert(removed == 500);
+   assert(v.len == 500);
+   for (int i = 0; i < 500; i++)
+      assert(*(int *)vec_at(&v, i) == i * 2);
+   removed = vec_retain(&v, is_even, NULL);
+   assert(removed == 0);
+
+   /* remove by positions */
+   size_t idx[] = {0, 1, 7, 498, 499};
+   size_t bad_order[] = {3, 3};
+   size_t bad_range[] = {1, 500};
+   ok = vec_remove_indices(&v, bad_order, 2);
+   assert(!ok);
+   ok = vec_remove_indices(&v, bad_range, 2);
+   assert(!ok);
+   assert(v.len == 500);
+   ok = vec_remove_indices(&v, idx, 0);
+   assert(ok);
+   ok = vec_remove_indices(&v, idx, 5);
+   assert(ok);
+   assert(v.len == 495);
+   for (int i = 0; i < 495; i++) {
+      int expected = (i < 5 ? i + 2 : i + 3) * 2;
+      assert(*(int *)vec_at(&v, i) == expected);
+   }
+
+   /* swap remove */
+   ok = vec_swap_remove(&v, 0, &x);
+   assert(ok && x == 4);
+   assert(*(int *)vec_at(&v, 0) == 994);
+   assert(v.len == 494);
+   x = *(int *)vec_at(&v, 493);
+   ok = vec_swap_remove(&v, 493, NULL);
+   assert(ok);
+   assert(v.len == 493 && *(int *)vec_at(&v, 492) != x);
+   ok = vec_swap_remove(&v, 493, NULL);
+   assert(!ok);
+   vec_free(&v);
+
+   /* free_fn only on the elements removed */
+   vec_new(&v, sizeof(OwnsMem), (FreeFn)free_ownsmem);
+   for (int i = 0; i < 10; i++) {
+      OwnsMem om;
+      new_ownsmem(&om, "test");
+      vec_push(&v, &om);
+   }
+   int n_keep = 6;
+   removed = vec_retain(&v, keep_first_n, &n_keep);
+   assert(removed == 4);
+   assert(ownsmem_alloc_count == 6);
+   size_t idx2[] = {1, 4};
+   ok = vec_remove_indices(&v, idx2, 2);
+   assert(ok);
+   assert(ownsmem_alloc_count == 4);
+   ok = vec_swap_remove(&v, 0, NULL);
+   assert(ok);
+   assert(ownsmem_alloc_count == 3);
+   for (size_t i = 0; i < v.len; i++)
+      assert(strcmp(((OwnsMem *)vec_at(&v, i))->mem, "test") == 0);
+   vec_free(&v);
+   assert(ownsmem_alloc_count == 0);
+
+   printf("%s passed\n", __func__);
+}
+
 int main()
 {
    test_vec_new_and_empty();
@@ -259,6 +477,10 @@ int main()
    test_vec_mem_ops();
    test_vec_insert_null();
    test_vec_autofree();
+   test_vec_inline();
+   test_vec_mmap();
+   test_vec_aligned();
+   test_vec_bulk_remove();
    
    printf("%s suite passed!\n", __FILE__);
    return 0;
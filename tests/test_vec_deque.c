@@ -0,0 +1,237 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vec_deque.h"
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+static void test_push_pop(void)
+{
+   VecDeque dq;
+   int      x;
+   bool     ok;
+
+   vec_deque_new(&dq, sizeof(int), NULL);
+   assert(vec_deque_is_empty(&dq));
+   assert(!vec_deque_front(&dq) && !vec_deque_back(&dq));
+   ok = vec_deque_pop_front(&dq, &x);
+   assert(!ok);
+   ok = vec_deque_pop_back(&dq, &x);
+   assert(!ok);
+
+   /* 0 1 2 3 4 pushed at the back, -1 .. -5 at the front */
+   for (int i = 0; i < 5; i++) {
+      int neg = -i - 1;
+      ok = vec_deque_push_back(&dq, &i);
+      assert(ok);
+      ok = vec_deque_push_front(&dq, &neg);
+      assert(ok);
+   }
+   assert(vec_deque_len(&dq) == 10);
+   assert((dq.cap & (dq.cap - 1)) == 0);
+   assert(*(int *)vec_deque_front(&dq) == -5);
+   assert(*(int *)vec_deque_back(&dq) == 4);
+   for (int i = 0; i < 10; i++)
+      assert(*(int *)vec_deque_at(&dq, i) == i - 5);
+   assert(!vec_deque_at(&dq, 10));
+
+   ok = vec_deque_pop_front(&dq, &x);
+   assert(ok && x == -5);
+   ok = vec_deque_pop_back(&dq, &x);
+   assert(ok && x == 4);
+   assert(vec_deque_len(&dq) == 8);
+
+   /* as a work queue: the ring keeps wrapping, it never grows */
+   size_t cap = dq.cap;
+   for (int i = 0; i < 1000; i++) {
+      ok = vec_deque_push_back(&dq, &i);
+      assert(ok);
+      ok = vec_deque_pop_front(&dq, NULL);
+      assert(ok);
+   }
+   assert(dq.cap == cap);
+   for (int i = 0; i < 8; i++)
+      assert(*(int *)vec_deque_at(&dq, i) == 992 + i);
+
+   vec_deque_clear(&dq);
+   assert(vec_deque_is_empty(&dq));
+   vec_deque_free(&dq);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_bulk_slices(void)
+{
+   VecDeque dq;
+   int      arr[100], out[100];
+   void    *first, *second;
+   size_t   first_len, second_len;
+   bool     ok;
+
+   for (int i = 0; i < 100; i++)
+      arr[i] = i;
+
+   vec_deque_new(&dq, sizeof(int), NULL);
+   vec_deque_slices(&dq, &first, &first_len, &second, &second_len);
+   assert(first_len == 0 && second_len == 0);
+
+   ok = vec_deque_push_back_n(&dq, arr + 50, 50);
+   assert(ok);
+   ok = vec_deque_push_front_n(&dq, arr, 50);
+   assert(ok);
+   ok = vec_deque_push_back_n(&dq, NULL, 3);
+   assert(ok);
+   assert(vec_deque_len(&dq) == 103);
+   for (int i = 0; i < 100; i++)
+      assert(*(int *)vec_deque_at(&dq, i) == i);
+   assert(*(int *)vec_deque_back(&dq) == 0);
+
+   /* the two halves together are the whole deque */
+   vec_deque_slices(&dq, &first, &first_len, &second, &second_len);
+   assert(first_len + second_len == 103);
+   assert(second_len > 0);
+   for (size_t i = 0; i < first_len; i++)
+      assert(((int *)first)[i] == (int)i);
+   for (size_t i = 0; i < 100 - first_len; i++)
+      assert(((int *)second)[i] == (int)(first_len + i));
+
+   ok = vec_deque_pop_back_n(&dq, NULL, 3);
+   assert(ok);
+   ok = vec_deque_pop_front_n(&dq, out, 101);
+   assert(!ok);
+   ok = vec_deque_pop_front_n(&dq, out, 30);
+   assert(ok);
+   for (int i = 0; i < 30; i++)
+      assert(out[i] == i);
+   ok = vec_deque_pop_back_n(&dq, out, 30);
+   assert(ok);
+   for (int i = 0; i < 30; i++)
+      assert(out[i] == 70 + i);
+   assert(vec_deque_len(&dq) == 40);
+   assert(*(int *)vec_deque_front(&dq) == 30);
+
+   vec_deque_free(&dq);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_random(void)
+{
+   VecDeque dq;
+   int     *model = malloc(100000 * sizeof(int));
+   size_t   beg = 50000, end = 50000; /* model is model[beg, end) */
+   int      next = 0, buf[16];
+   bool     ok;
+
+   vec_deque_new(&dq, sizeof(int), NULL);
+
+   for (int op = 0; op < 20000; op++) {
+      size_t n = rng() % 8 + 1;
+
+      switch (rng() % 4) {
+      case 0:
+         for (size_t i = 0; i < n; i++)
+            buf[i] = model[end + i] = next++;
+         ok = vec_deque_push_back_n(&dq, buf, n);
+         assert(ok);
+         end += n;
+         break;
+      case 1:
+         beg -= n;
+         for (size_t i = 0; i < n; i++)
+            buf[i] = model[beg + i] = next++;
+         ok = vec_deque_push_front_n(&dq, buf, n);
+         assert(ok);
+         break;
+      case 2:
+         if (n > end - beg) {
+            ok = vec_deque_pop_front_n(&dq, buf, n);
+            assert(!ok);
+            break;
+         }
+         ok = vec_deque_pop_front_n(&dq, buf, n);
+         assert(ok);
+         for (size_t i = 0; i < n; i++)
+            assert(buf[i] == model[beg + i]);
+         beg += n;
+         break;
+      case 3:
+         if (n > end - beg) {
+            ok = vec_deque_pop_back_n(&dq, buf, n);
+            assert(!ok);
+            break;
+         }
+         ok = vec_deque_pop_back_n(&dq, buf, n);
+         assert(ok);
+         end -= n;
+         for (size_t i = 0; i < n; i++)
+            assert(buf[i] == model[end + i]);
+         break;
+      }
+
+      assert(vec_deque_len(&dq) == end - beg);
+      if (op % 97 == 0) {
+         for (size_t i = beg; i < end; i++)
+            assert(*(int *)vec_deque_at(&dq, i - beg) == model[i]);
+      }
+   }
+
+   vec_deque_free(&dq);
+   free(model);
+
+   printf("%s passed\n", __func__);
+}
+
+static void free_str(void *ptr)
+{
+   free(*(char **)ptr);
+}
+
+static void test_free_fn(void)
+{
+   VecDeque dq;
+   char    *s;
+   bool     ok;
+
+   vec_deque_new(&dq, sizeof(char *), free_str);
+   for (int i = 0; i < 10; i++) {
+      s = malloc(16);
+      snprintf(s, 16, "%d", i);
+      if (i % 2)
+         vec_deque_push_back(&dq, &s);
+      else
+         vec_deque_push_front(&dq, &s);
+   }
+
+   /* taken out, so it's ours to free */
+   ok = vec_deque_pop_front(&dq, &s);
+   assert(ok && s[0] == '8');
+   free(s);
+
+   ok = vec_deque_pop_back_n(&dq, NULL, 2);
+   assert(ok);
+   vec_deque_free(&dq);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_push_pop();
+   test_bulk_slices();
+   test_random();
+   test_free_fn();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
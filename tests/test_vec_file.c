@@ -0,0 +1,120 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vec_file.h"
+
+#define PATH "test_vec_file.bin"
+
+typedef struct {
+   int64_t id;
+   double  val;
+} Row;
+
+#if defined(__unix__) || defined(__APPLE__)
+
+static void test_persist(void)
+{
+   VecFile vf;
+   void   *pushed;
+   bool    ok;
+
+   remove(PATH);
+   ok = vec_file_open(&vf, PATH, sizeof(Row), 0);
+   assert(!ok);
+
+   /* create, grow and persist */
+   ok = vec_file_open(&vf, PATH, sizeof(Row), VEC_FILE_CREATE);
+   assert(ok);
+   assert(vf.vec.len == 0);
+   for (int64_t i = 0; i < 100000; i++) {
+      Row row = {i, (double)i / 2};
+      pushed = vec_push(&vf.vec, &row);
+      assert(pushed);
+   }
+   ok = vec_file_sync(&vf);
+   assert(ok);
+   vec_remove(&vf.vec, 0, NULL);
+   vec_file_close(&vf);
+
+   /* reopen, the length was written at close */
+   ok = vec_file_open(&vf, PATH, sizeof(Row), 0);
+   assert(ok);
+   assert(vf.vec.len == 99999);
+   assert(((Row *)vec_at(&vf.vec, 0))->id == 1);
+   assert(((Row *)vec_at(&vf.vec, 99998))->val == 99999.0 / 2);
+
+   /* shrinking shrinks the file too */
+   vec_truncate(&vf.vec, 10);
+   vec_shrink_to_fit(&vf.vec);
+   assert(vf.vec.cap == 10);
+   assert(vf.map_size == VEC_FILE_HEADER_SIZE + 10 * sizeof(Row));
+   vec_file_close(&vf);
+
+   /* wrong element size */
+   ok = vec_file_open(&vf, PATH, sizeof(int), 0);
+   assert(!ok);
+
+   remove(PATH);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_read_only(void)
+{
+   VecFile vf;
+   void   *pushed;
+   bool    ok;
+
+   remove(PATH);
+   ok = vec_file_open(&vf, PATH, sizeof(int), VEC_FILE_CREATE);
+   assert(ok);
+   for (int i = 0; i < 1000; i++)
+      vec_push(&vf.vec, &i);
+   vec_file_close(&vf);
+
+   ok = vec_file_open(&vf, PATH, sizeof(int), VEC_FILE_READ_ONLY);
+   assert(ok);
+   assert(vf.vec.len == 1000);
+   for (int i = 0; i < 1000; i++)
+      assert(*(int *)vec_at(&vf.vec, i) == i);
+
+   /* can't grow or sync */
+   int x = 0;
+   pushed = vec_push(&vf.vec, &x);
+   assert(!pushed);
+   ok = vec_file_sync(&vf);
+   assert(!ok);
+   assert(vf.vec.len == 1000);
+   vec_file_close(&vf);
+
+   /* emptied by vec_free */
+   ok = vec_file_open(&vf, PATH, sizeof(int), 0);
+   assert(ok);
+   vec_free(&vf.vec);
+   assert(vf.map_size == VEC_FILE_HEADER_SIZE);
+   vec_push(&vf.vec, &x);
+   vec_file_close(&vf);
+   ok = vec_file_open(&vf, PATH, sizeof(int), VEC_FILE_READ_ONLY);
+   assert(ok);
+   assert(vf.vec.len == 1);
+   vec_file_close(&vf);
+
+   remove(PATH);
+
+   printf("%s passed\n", __func__);
+}
+
+#endif
+
+int main(void)
+{
+#if defined(__unix__) || defined(__APPLE__)
+   test_persist();
+   test_read_only();
+#endif
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
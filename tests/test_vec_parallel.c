@@ -0,0 +1,141 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "vec_parallel.h"
+
+typedef struct {
+   uint64_t sum;
+   uint64_t max;
+   size_t   n;
+} Stats;
+
+static void square_chunk(void *elems, size_t pos, size_t n, void *ctx)
+{
+   uint64_t *vals = elems;
+
+   (void)ctx;
+   for (size_t i = 0; i < n; i++) {
+      /* the chunk starts at pos */
+      assert(vals[i] == pos + i);
+      vals[i] *= vals[i];
+   }
+}
+
+static void stats_fold(void *acc, const void *elems, size_t n, void *ctx)
+{
+   Stats          *s = acc;
+   const uint64_t *vals = elems;
+
+   (void)ctx;
+   for (size_t i = 0; i < n; i++) {
+      s->sum += vals[i];
+      if (vals[i] > s->max)
+         s->max = vals[i];
+   }
+   s->n += n;
+}
+
+static void stats_combine(void *acc, const void *other, void *ctx)
+{
+   Stats       *s = acc;
+   const Stats *o = other;
+
+   (void)ctx;
+   s->sum += o->sum;
+   if (o->max > s->max)
+      s->max = o->max;
+   s->n += o->n;
+}
+
+/**
+ * @brief appends the chunks' first elements, checks they are combined in order
+ */
+static void order_fold(void *acc, const void *elems, size_t n, void *ctx)
+{
+   uint64_t *first = acc;
+
+   (void)ctx;
+   if (n && *first == UINT64_MAX)
+      *first = *(const uint64_t *)elems;
+}
+
+static void order_combine(void *acc, const void *other, void *ctx)
+{
+   uint64_t       *last = acc;
+   const uint64_t *first = other;
+
+   (void)ctx;
+   assert(*last == UINT64_MAX || *first > *last);
+   *last = *first;
+}
+
+static void fill(Vec *v, size_t n)
+{
+   vec_truncate(v, 0);
+   for (uint64_t i = 0; i < n; i++)
+      vec_push(v, &i);
+}
+
+static void test_for_reduce(void)
+{
+   size_t     sizes[] = {0, 1, 2, 1000, 1025, 100000};
+   size_t     grains[] = {0, 1, 7, 4096};
+   size_t     threads[] = {1, 2, 4, 0};
+   ThreadPool pool;
+   Vec        v;
+   bool       ok;
+
+   vec_new(&v, sizeof(uint64_t), NULL);
+
+   for (size_t t = 0; t < sizeof(threads) / sizeof(*threads); t++) {
+      ok = threadpool_new(&pool, threads[t]);
+      assert(ok);
+
+      for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+         for (size_t g = 0; g < sizeof(grains) / sizeof(*grains); g++) {
+            size_t   n = sizes[s];
+            Stats    st = {0, 0, 0};
+            uint64_t last = UINT64_MAX;
+
+            /* every element is transformed exactly once */
+            fill(&v, n);
+            vec_parallel_for(&v, square_chunk, NULL, grains[g], &pool);
+            for (size_t i = 0; i < n; i++)
+               assert(((uint64_t *)v.ptr)[i] == (uint64_t)i * i);
+
+            fill(&v, n);
+            ok = vec_parallel_reduce(&v, &st, sizeof(st), stats_fold, stats_combine, NULL,
+                                     grains[g], &pool);
+            assert(ok);
+            assert(st.n == n);
+            assert(st.sum == (n ? (uint64_t)n * (n - 1) / 2 : 0));
+            assert(st.max == (n ? n - 1 : 0));
+
+            ok = vec_parallel_reduce(&v, &last, sizeof(last), order_fold, order_combine, NULL,
+                                     grains[g], &pool);
+            assert(ok);
+         }
+      }
+
+      threadpool_free(&pool);
+   }
+
+   /* no pool, everything on the calling thread */
+   fill(&v, 5000);
+   vec_parallel_for(&v, square_chunk, NULL, 100, NULL);
+   assert(((uint64_t *)v.ptr)[4999] == 4999ull * 4999);
+
+   vec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_for_reduce();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -0,0 +1,139 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec_scan.h"
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+/**
+ * @brief @p n elements of @p size bytes, each byte in [0, @p range )
+ */
+static void fill_random(Vec *v, size_t size, size_t n, unsigned range)
+{
+   vec_new(v, size, NULL);
+   if (n)
+      vec_insert_n(v, 0, NULL, n);
+   for (size_t i = 0; i < n * size; i++)
+      ((uint8_t *)v->ptr)[i] = (uint8_t)(rng() % range);
+}
+
+static void test_find_count(void)
+{
+   size_t sizes[] = {1, 2, 4, 8, 3, 12};
+   size_t lens[] = {0, 1, 15, 16, 33, 100, 1000};
+
+   for (VecScanIsa isa = VEC_SCAN_SCALAR; isa <= VEC_SCAN_AVX2; isa++) {
+      vec_scan_set_isa(isa);
+
+      for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+         for (size_t l = 0; l < sizeof(lens) / sizeof(*lens); l++) {
+            size_t  size = sizes[s], len = lens[l];
+            uint8_t key[16];
+            Vec     v;
+
+            /* bytes in [0, 2), so there are plenty of matches for small elements */
+            fill_random(&v, size, len, 2);
+            for (int rep = 0; rep < 8; rep++) {
+               size_t first = len, count = 0;
+
+               for (size_t i = 0; i < size; i++)
+                  key[i] = (uint8_t)(rng() % 2);
+               for (size_t i = 0; i < len; i++) {
+                  if (!memcmp(vec_at(&v, i), key, size)) {
+                     first = first < i ? first : i;
+                     count++;
+                  }
+               }
+
+               assert(vec_find(&v, key) == first);
+               assert(vec_count(&v, key) == count);
+            }
+            vec_free(&v);
+         }
+      }
+   }
+
+   vec_scan_set_isa(VEC_SCAN_AVX2);
+
+   printf("%s passed\n", __func__);
+}
+
+#define CHECK_FILTER(T, type, lo_val, hi_val)                                                      \
+   do {                                                                                            \
+      T      lo = lo_val, hi = hi_val;                                                             \
+      Vec    v, idx, vals;                                                                         \
+      size_t n;                                                                                    \
+                                                                                                   \
+      fill_random(&v, sizeof(T), 1003, 256);                                                       \
+      vec_new(&idx, sizeof(size_t), NULL);                                                         \
+      vec_new(&vals, sizeof(T), NULL);                                                             \
+                                                                                                   \
+      n = vec_filter_range(&v, type, &lo, &hi, &idx, &vals);                                       \
+      assert(n == idx.len && n == vals.len);                                                       \
+                                                                                                   \
+      for (size_t i = 0, j = 0; i < v.len; i++) {                                                  \
+         T x = *(T *)vec_at(&v, i);                                                                \
+         if (x >= lo && x <= hi) {                                                                 \
+            assert(*(size_t *)vec_at(&idx, j) == i);                                               \
+            assert(!memcmp(vec_at(&vals, j), &x, sizeof(T)));                                      \
+            j++;                                                                                   \
+         }                                                                                         \
+      }                                                                                            \
+      assert(vec_filter_range(&v, type, &lo, &hi, NULL, NULL) == n);                               \
+                                                                                                   \
+      vec_free(&v);                                                                                \
+      vec_free(&idx);                                                                              \
+      vec_free(&vals);                                                                             \
+   } while (0)
+
+static void test_filter_range(void)
+{
+   for (VecScanIsa isa = VEC_SCAN_SCALAR; isa <= VEC_SCAN_AVX2; isa++) {
+      vec_scan_set_isa(isa);
+
+      CHECK_FILTER(uint8_t, VEC_U8, 10, 200);
+      CHECK_FILTER(int8_t, VEC_I8, -100, 20);
+      CHECK_FILTER(uint16_t, VEC_U16, 1000, 50000);
+      CHECK_FILTER(int16_t, VEC_I16, -20000, 100);
+      CHECK_FILTER(uint32_t, VEC_U32, 1u << 30, 3u << 30);
+      CHECK_FILTER(int32_t, VEC_I32, -(1 << 30), 1 << 29);
+      CHECK_FILTER(uint64_t, VEC_U64, 1ull << 62, 3ull << 62);
+      CHECK_FILTER(int64_t, VEC_I64, -(1ll << 62), 1ll << 61);
+      CHECK_FILTER(float, VEC_F32, -1e10f, 1e10f);
+      CHECK_FILTER(double, VEC_F64, -1e100, 1e100);
+
+      /* NaNs are never selected */
+      double nan_vals[] = {NAN, 1, NAN, 2, 3, NAN, 4, 5};
+      double lo = -INFINITY, hi = INFINITY;
+      Vec    v;
+      vec_new(&v, sizeof(double), NULL);
+      vec_insert_n(&v, 0, nan_vals, 8);
+      assert(vec_filter_range(&v, VEC_F64, &lo, &hi, NULL, NULL) == 5);
+      vec_free(&v);
+   }
+
+   vec_scan_set_isa(VEC_SCAN_AVX2);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_find_count();
+   test_filter_range();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
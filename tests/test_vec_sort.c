@@ -0,0 +1,301 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec_sort.h"
+
+typedef struct {
+   int32_t key;
+   int32_t seq; /**< insertion order, to check stability */
+   char    pad[24];
+} Rec;
+
+static int cmp_u32(const void *a, const void *b)
+{
+   uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+   return (x > y) - (x < y);
+}
+
+static int cmp_i32(const void *a, const void *b)
+{
+   int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+   return (x > y) - (x < y);
+}
+
+static int cmp_i64(const void *a, const void *b)
+{
+   int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+   return (x > y) - (x < y);
+}
+
+static int cmp_i8(const void *a, const void *b)
+{
+   return *(const int8_t *)a - *(const int8_t *)b;
+}
+
+static int cmp_f64(const void *a, const void *b)
+{
+   double x = *(const double *)a, y = *(const double *)b;
+   return (x > y) - (x < y);
+}
+
+static int cmp_rec(const void *a, const void *b)
+{
+   const Rec *x = a, *y = b;
+   if (x->key != y->key)
+      return (x->key > y->key) - (x->key < y->key);
+   return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+static uint64_t rng_state = 88172645463325252ull;
+
+static uint64_t rng(void)
+{
+   rng_state ^= rng_state << 13;
+   rng_state ^= rng_state >> 7;
+   rng_state ^= rng_state << 17;
+   return rng_state;
+}
+
+static void test_radix_ints(void)
+{
+   size_t sizes[] = {1, 2, 100, 10000};
+   Vec    v;
+
+   vec_new(&v, sizeof(uint32_t), NULL);
+   vec_sort_radix(&v, VEC_U32);
+   assert(v.len == 0);
+   vec_free(&v);
+
+   for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++) {
+      size_t n = sizes[s];
+
+      vec_new_with(&v, sizeof(uint32_t), n, NULL);
+      for (size_t i = 0; i < n; i++) {
+         uint32_t x = (uint32_t)rng();
+         vec_push(&v, &x);
+      }
+      uint32_t *expected = malloc(n * sizeof(uint32_t));
+      memcpy(expected, v.ptr, n * sizeof(uint32_t));
+      qsort(expected, n, sizeof(uint32_t), cmp_u32);
+
+      vec_sort_radix(&v, VEC_U32);
+      assert(v.len == n);
+      assert(!memcmp(v.ptr, expected, n * sizeof(uint32_t)));
+
+      free(expected);
+      vec_free(&v);
+   }
+
+   /* negatives, and small values where the high bytes are all equal */
+   vec_new(&v, sizeof(int64_t), NULL);
+   for (int i = 0; i < 5000; i++) {
+      int64_t x = (int64_t)(rng() % 2001) - 1000;
+      vec_push(&v, &x);
+   }
+   vec_sort_radix(&v, VEC_I64);
+   assert(vec_is_sorted(&v, cmp_i64));
+   assert(*(int64_t *)vec_at(&v, 0) >= -1000 && *(int64_t *)vec_at(&v, 4999) <= 1000);
+   vec_free(&v);
+
+   vec_new(&v, sizeof(int8_t), NULL);
+   for (int i = 0; i < 1000; i++) {
+      int8_t x = (int8_t)rng();
+      vec_push(&v, &x);
+   }
+   vec_sort_radix(&v, VEC_I8);
+   assert(vec_is_sorted(&v, cmp_i8));
+   vec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_radix_floats(void)
+{
+   double vals[] = {3.5, -0.0, 0.0, -INFINITY, 1e-300, -1e300, INFINITY, -2.25, 7, -7};
+   double expected[] = {-INFINITY, -1e300, -7, -2.25, -0.0, 0.0, 1e-300, 3.5, 7, INFINITY};
+   Vec    v;
+
+   vec_new(&v, sizeof(double), NULL);
+   vec_insert_n(&v, 0, vals, 10);
+   vec_sort_radix(&v, VEC_F64);
+   for (size_t i = 0; i < 10; i++)
+      assert(((double *)v.ptr)[i] == expected[i]);
+   /* -0 before +0 */
+   assert(signbit(((double *)v.ptr)[4]) && !signbit(((double *)v.ptr)[5]));
+
+   /* NaNs by their sign bit: -NaN first, +NaN last */
+   double nans[] = {1, copysign(NAN, -1.0), INFINITY, copysign(NAN, 1.0), -INFINITY};
+   vec_truncate(&v, 0);
+   vec_insert_n(&v, 0, nans, 5);
+   vec_sort_radix(&v, VEC_F64);
+   assert(isnan(((double *)v.ptr)[0]) && signbit(((double *)v.ptr)[0]));
+   assert(((double *)v.ptr)[1] == -INFINITY && ((double *)v.ptr)[2] == 1);
+   assert(((double *)v.ptr)[3] == INFINITY);
+   assert(isnan(((double *)v.ptr)[4]) && !signbit(((double *)v.ptr)[4]));
+
+   vec_truncate(&v, 0);
+   for (int i = 0; i < 10000; i++) {
+      double x = ((double)(int64_t)rng()) / 1e6;
+      vec_push(&v, &x);
+   }
+   vec_sort_radix(&v, VEC_F64);
+   assert(vec_is_sorted(&v, cmp_f64));
+   vec_free(&v);
+
+   vec_new(&v, sizeof(float), NULL);
+   for (int i = 0; i < 1000; i++) {
+      float x = (float)((int)(rng() % 2000) - 1000) / 8.0f;
+      vec_push(&v, &x);
+   }
+   vec_sort_radix(&v, VEC_F32);
+   for (size_t i = 1; i < v.len; i++)
+      assert(((float *)v.ptr)[i - 1] <= ((float *)v.ptr)[i]);
+   vec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_radix_by_key(void)
+{
+   Vec v;
+
+   vec_new(&v, sizeof(Rec), NULL);
+   for (int i = 0; i < 20000; i++) {
+      Rec r = {(int32_t)(rng() % 100) - 50, i, {0}};
+      vec_push(&v, &r);
+   }
+
+   vec_sort_radix_by_key(&v, offsetof(Rec, key), VEC_I32);
+
+   /* sorted by key, and by insertion order within equal keys */
+   assert(v.len == 20000);
+   assert(vec_is_sorted(&v, cmp_rec));
+
+   vec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_sort(void)
+{
+   enum { N = 50000 };
+   int64_t *expected = malloc(N * sizeof(int64_t));
+   Vec      v;
+
+   vec_new_with(&v, sizeof(int64_t), N, NULL);
+
+   /* random, sorted, reversed, few distinct values, organ pipe */
+   for (int pattern = 0; pattern < 5; pattern++) {
+      vec_truncate(&v, 0);
+      for (int64_t i = 0; i < N; i++) {
+         int64_t x;
+         switch (pattern) {
+         case 0: x = (int64_t)rng(); break;
+         case 1: x = i; break;
+         case 2: x = N - i; break;
+         case 3: x = (int64_t)(rng() % 4); break;
+         default: x = i < N / 2 ? i : N - i; break;
+         }
+         vec_push(&v, &x);
+      }
+      memcpy(expected, v.ptr, N * sizeof(int64_t));
+      qsort(expected, N, sizeof(int64_t), cmp_i64);
+
+      vec_sort(&v, cmp_i64);
+      assert(!memcmp(v.ptr, expected, N * sizeof(int64_t)));
+   }
+
+   vec_free(&v);
+   free(expected);
+
+   /* elements bigger than the inline buffers */
+   typedef struct {
+      unsigned key; /**< first, so cmp_u32 works on it */
+      char     payload[100];
+   } Wide;
+
+   vec_new(&v, sizeof(Wide), NULL);
+   for (int i = 0; i < 1000; i++) {
+      Wide w;
+      w.key = (unsigned)(rng() % 1000);
+      memset(w.payload, w.key & 0x7f, sizeof(w.payload));
+      vec_push(&v, &w);
+   }
+   vec_sort(&v, cmp_u32);
+   for (size_t i = 0; i < v.len; i++) {
+      Wide *w = vec_at(&v, i);
+      assert(w->payload[99] == (char)(w->key & 0x7f));
+      if (i)
+         assert(((Wide *)vec_at(&v, i - 1))->key <= w->key);
+   }
+   vec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_sort_parallel(void)
+{
+   size_t     sizes[] = {0, 1, 1000, 100000};
+   size_t     scratch[] = {SIZE_MAX, 10000 * sizeof(Rec), 0};
+   ThreadPool pool;
+   Vec        v;
+   bool       ok;
+
+   ok = threadpool_new(&pool, 4);
+   assert(ok);
+
+   for (size_t n = 0; n < sizeof(sizes) / sizeof(*sizes); n++) {
+      for (size_t m = 0; m < sizeof(scratch) / sizeof(*scratch); m++) {
+         for (int stable = 0; stable < 2; stable++) {
+            vec_new(&v, sizeof(Rec), NULL);
+            for (size_t i = 0; i < sizes[n]; i++) {
+               Rec r = {(int32_t)(rng() % 1000) - 500, (int32_t)i, {0}};
+               vec_push(&v, &r);
+            }
+
+            if (stable) {
+               /* only the key is compared, so the order of seq shows if it's stable */
+               vec_sort_stable(&v, cmp_i32, &pool, scratch[m]);
+               assert(vec_is_sorted(&v, cmp_rec));
+            }
+            else {
+               vec_sort_parallel(&v, cmp_i32, &pool, scratch[m]);
+               assert(vec_is_sorted(&v, cmp_i32));
+            }
+            assert(v.len == sizes[n]);
+
+            vec_free(&v);
+         }
+      }
+   }
+
+   /* without a pool */
+   vec_new(&v, sizeof(Rec), NULL);
+   for (int i = 0; i < 5000; i++) {
+      Rec r = {(int32_t)(rng() % 10), i, {0}};
+      vec_push(&v, &r);
+   }
+   vec_sort_stable(&v, cmp_i32, NULL, SIZE_MAX);
+   assert(vec_is_sorted(&v, cmp_rec));
+   vec_free(&v);
+
+   threadpool_free(&pool);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_radix_ints();
+   test_radix_floats();
+   test_radix_by_key();
+   test_sort();
+   test_sort_parallel();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
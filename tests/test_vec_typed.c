@@ -0,0 +1,124 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec_typed.h"
+
+typedef struct {
+   double x, y, z, w;
+} Vec4;
+
+VEC_DEFINE(IntVec, int)
+VEC_DEFINE(Vec4Vec, Vec4)
+VEC_DEFINE(StrVec, char *)
+
+static void test_push_get(void)
+{
+   IntVec v;
+   int   *pushed;
+   bool   ok;
+
+   IntVec_new(&v, NULL);
+   for (int i = 0; i < 1000; i++) {
+      pushed = IntVec_push(&v, i);
+      assert(pushed && *pushed == i);
+   }
+   assert(IntVec_len(&v) == 1000);
+
+   for (int i = 0; i < 1000; i++)
+      assert(IntVec_get(&v, i) == i);
+   assert(IntVec_at(&v, 1000) == NULL);
+
+   IntVec_set(&v, 10, -10);
+   assert(*IntVec_at(&v, 10) == -10);
+
+   /* the generic functions see the same data */
+   int elem = 0;
+   ok = vec_get(IntVec_as_vec(&v), 10, &elem);
+   assert(ok && elem == -10);
+   vec_remove(IntVec_as_vec(&v), 0, NULL);
+   assert(IntVec_get(&v, 0) == 1);
+
+   int last = 0;
+   ok = IntVec_pop(&v, &last);
+   assert(ok && last == 999);
+   IntVec_truncate(&v, 0);
+   ok = IntVec_pop(&v, NULL);
+   assert(!ok);
+
+   IntVec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+static void test_extend_insert(void)
+{
+   Vec4Vec v;
+   Vec4   *inserted;
+   Vec4    arr[3] = {{1, 1, 1, 1}, {2, 2, 2, 2}, {3, 3, 3, 3}};
+
+   Vec4Vec_new_with(&v, 2, NULL);
+   Vec4Vec_extend(&v, arr, 3);
+   Vec4Vec_extend(&v, arr, 0);
+   assert(Vec4Vec_len(&v) == 3);
+
+   Vec4 mid = {9, 9, 9, 9};
+   inserted = Vec4Vec_insert(&v, 1, mid);
+   assert(inserted && inserted->x == 9);
+   inserted = Vec4Vec_insert(&v, 4, arr[0]);
+   assert(inserted && inserted->x == 1);
+   inserted = Vec4Vec_insert(&v, 6, arr[0]);
+   assert(inserted == NULL);
+
+   double expected[] = {1, 9, 2, 3, 1};
+   for (size_t i = 0; i < Vec4Vec_len(&v); i++)
+      assert(Vec4Vec_data(&v)[i].w == expected[i]);
+
+   Vec4Vec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+static void free_str(void *ptr)
+{
+   free(*(char **)ptr);
+}
+
+static void test_free_fn(void)
+{
+   StrVec v;
+   char  *popped = NULL;
+   bool   ok;
+
+   StrVec_new(&v, free_str);
+   for (int i = 0; i < 4; i++) {
+      char *s = malloc(16);
+      snprintf(s, 16, "s%d", i);
+      StrVec_push(&v, s);
+   }
+
+   /* set and pop without output free the element */
+   StrVec_set(&v, 0, calloc(1, 1));
+   ok = StrVec_pop(&v, NULL);
+   assert(ok);
+
+   /* pop with output hands it over */
+   StrVec_pop(&v, &popped);
+   assert(popped && !strcmp(popped, "s2"));
+   free(popped);
+
+   StrVec_free(&v);
+
+   printf("%s passed\n", __func__);
+}
+
+int main(void)
+{
+   test_push_get();
+   test_extend_insert();
+   test_free_fn();
+
+   printf("%s suite passed!\n", __FILE__);
+   return 0;
+}
@@ -66,6 +66,46 @@ void test_vstr_reserve_and_shrink()
    printf("%s passed\n", __func__);
 }
 
+static void *failing_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+   (void)old_size;
+   if (*(bool *)ctx)
+      return NULL;
+   return realloc(ptr, new_size);
+}
+
+static void failing_free(void *ctx, void *ptr, size_t size)
+{
+   (void)ctx;
+   (void)size;
+   free(ptr);
+}
+
+void test_vstr_shrink_fail()
+{
+   VStr      vs;
+   bool      fail = false, ok;
+   Allocator alloc = {failing_realloc, failing_free, &fail};
+
+   vstr_new_in(&vs, &alloc);
+   ok = vstr_reserve(&vs, 64);
+   assert(ok);
+   vstr_cpy(&vs, "short");
+
+   /* the allocator refuses to move the string, it stays as it was */
+   fail = true;
+   ok = vstr_shrink_to_fit(&vs);
+   assert(!ok);
+   assert(vs.cap == 65 && strcmp(vstr_data(&vs), "short") == 0);
+
+   fail = false;
+   ok = vstr_shrink_to_fit(&vs);
+   assert(ok && vs.cap == 6);
+   vstr_free(&vs);
+   
+   printf("%s passed\n", __func__);
+}
+
 void test_vstr_insert()
 {
    VStr vs;
@@ -154,6 +194,7 @@ int main()
    test_vstr_from();
    test_vstr_truncate();
    test_vstr_reserve_and_shrink();
+   test_vstr_shrink_fail();
    test_vstr_insert();
    test_vstr_cpy_ncpy();
    test_vstr_cat_ncat();